@@ -2,6 +2,7 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Controls.Material 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Dialog {
     id: root
@@ -290,8 +291,8 @@ Dialog {
         root.isProcessing = true
 
         var xhr = new XMLHttpRequest()
-        xhr.open("PUT", "https://learning-dashboard-rouge.vercel.app/api/courses/" + root.courseId + "/status")
-        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
+        xhr.open("PUT", AuthController.apiBaseUrl + "/api/courses/" + root.courseId + "/status")
+        xhr.setRequestHeader("Authorization", "Bearer " + (AuthController ? AuthController.accessToken : ""))
         xhr.setRequestHeader("Content-Type", "application/json")
         xhr.setRequestHeader("Accept", "application/json")
 
@@ -346,8 +347,8 @@ Dialog {
         root.isProcessing = true
 
         var xhr = new XMLHttpRequest()
-        xhr.open("PUT", "https://learning-dashboard-rouge.vercel.app/api/courses/" + root.courseId + "/status")
-        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
+        xhr.open("PUT", AuthController.apiBaseUrl + "/api/courses/" + root.courseId + "/status")
+        xhr.setRequestHeader("Authorization", "Bearer " + (AuthController ? AuthController.accessToken : ""))
         xhr.setRequestHeader("Content-Type", "application/json")
         xhr.setRequestHeader("Accept", "application/json")
 
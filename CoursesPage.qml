@@ -2,6 +2,7 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Controls.Material 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Item {
     id: root
@@ -21,12 +22,12 @@ Item {
 
     Component.onCompleted: {
         console.log("CoursesPage loaded")
-        courseController.loadStats()
+        CourseController.loadStats()
         loadCourses()
     }
 
     Connections {
-        target: courseController
+        target: CourseController
         function onStatsLoaded() {
             console.log("Course stats loaded successfully")
         }
@@ -36,7 +37,7 @@ Item {
     function loadCourses() {
         loadingCourses = true
 
-        var endpoint = "https://learning-dashboard-rouge.vercel.app/api/courses"
+        var endpoint = AuthController.apiBaseUrl + "/api/courses"
         var params = []
 
         if (currentStatus !== "all") {
@@ -58,7 +59,7 @@ Item {
 
         var xhr = new XMLHttpRequest()
         xhr.open("GET", endpoint)
-        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
+        xhr.setRequestHeader("Authorization", "Bearer " + (AuthController ? AuthController.accessToken : ""))
         xhr.setRequestHeader("Accept", "application/json")
 
         xhr.onreadystatechange = function() {
@@ -230,10 +231,10 @@ Item {
                 flat: true
                 icon.source: "qrc:/icons/refresh.svg"
                 onClicked: {
-                    courseController.refresh()
+                    CourseController.refresh()
                     loadCourses()
                 }
-                enabled: !courseController.isLoading && !loadingCourses
+                enabled: !CourseController.isLoading && !loadingCourses
             }
         }
 
@@ -248,7 +249,7 @@ Item {
                 Layout.fillWidth: true
                 Layout.preferredHeight: 140
                 title: "Total Courses"
-                value: courseController.totalCourses
+                value: CourseController.totalCourses
                 status: "total"
             }
 
@@ -256,7 +257,7 @@ Item {
                 Layout.fillWidth: true
                 Layout.preferredHeight: 140
                 title: "Draft"
-                value: courseController.draftCourses
+                value: CourseController.draftCourses
                 status: "draft"
             }
 
@@ -264,7 +265,7 @@ Item {
                 Layout.fillWidth: true
                 Layout.preferredHeight: 140
                 title: "Pending Review"
-                value: courseController.pendingReviewCourses
+                value: CourseController.pendingReviewCourses
                 status: "pending_review"
             }
 
@@ -272,7 +273,7 @@ Item {
                 Layout.fillWidth: true
                 Layout.preferredHeight: 140
                 title: "Published"
-                value: courseController.publishedCourses
+                value: CourseController.publishedCourses
                 status: "published"
             }
 
@@ -280,7 +281,7 @@ Item {
                 Layout.fillWidth: true
                 Layout.preferredHeight: 140
                 title: "Rejected"
-                value: courseController.rejectedCourses
+                value: CourseController.rejectedCourses
                 status: "rejected"
             }
         }
@@ -306,11 +307,11 @@ Item {
 
                     Repeater {
                         model: [
-                            { label: "All", value: "all", count: courseController.totalCourses },
-                            { label: "Draft", value: "draft", count: courseController.draftCourses },
-                            { label: "Pending Review", value: "pending_review", count: courseController.pendingReviewCourses },
-                            { label: "Published", value: "published", count: courseController.publishedCourses },
-                            { label: "Rejected", value: "rejected", count: courseController.rejectedCourses }
+                            { label: "All", value: "all", count: CourseController.totalCourses },
+                            { label: "Draft", value: "draft", count: CourseController.draftCourses },
+                            { label: "Pending Review", value: "pending_review", count: CourseController.pendingReviewCourses },
+                            { label: "Published", value: "published", count: CourseController.publishedCourses },
+                            { label: "Rejected", value: "rejected", count: CourseController.rejectedCourses }
                         ]
 
                         Button {
@@ -585,7 +586,9 @@ Item {
 
                                             Image {
                                                 anchors.fill: parent
-                                                source: modelData.thumbnail || ""
+                                                source: modelData.thumbnail ? "image://remote/" + encodeURIComponent(modelData.thumbnail) : ""
+                                                sourceSize: Qt.size(120, 120)
+                                                asynchronous: true
                                                 fillMode: Image.PreserveAspectCrop
                                                 visible: modelData.thumbnail && modelData.thumbnail.length > 0
                                             }
@@ -952,8 +955,8 @@ Item {
                         deletingCourse = true
 
                         var xhr = new XMLHttpRequest()
-                        xhr.open("DELETE", "https://learning-dashboard-rouge.vercel.app/api/courses/" + deleteDialog.courseId)
-                        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
+                        xhr.open("DELETE", AuthController.apiBaseUrl + "/api/courses/" + deleteDialog.courseId)
+                        xhr.setRequestHeader("Authorization", "Bearer " + (AuthController ? AuthController.accessToken : ""))
                         xhr.setRequestHeader("Accept", "application/json")
 
                         xhr.onreadystatechange = function() {
@@ -966,7 +969,7 @@ Item {
                                         if (response.success) {
                                             successNotification.show("Course deleted successfully")
                                             deleteDialog.close()
-                                            courseController.refresh()
+                                            CourseController.refresh()
                                             loadCourses()
                                         } else {
                                             errorNotification.show(response.message || "Failed to delete course")
@@ -1001,13 +1004,13 @@ Item {
 
         onCourseApproved: {
             successNotification.show("✓ Course approved and published successfully!")
-            courseController.refresh()
+            CourseController.refresh()
             loadCourses()
         }
 
         onCourseRejected: {
             successNotification.show("Course rejected. Instructor has been notified.")
-            courseController.refresh()
+            CourseController.refresh()
             loadCourses()
         }
     }
@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Rectangle {
     id: root
@@ -11,59 +12,58 @@ Rectangle {
     signal navigateToInstructors()
 
 
-    property var pendingInstructors: []
-    property int totalPending: 0
-    property var recentActivities: []
-    property int totalActivities: 0
+    readonly property var pendingInstructors: DashboardController.overview.pendingInstructors || []
+    readonly property int totalPending: DashboardController.overview.totalPending || 0
+    readonly property var recentActivities: DashboardController.overview.activities || []
+    readonly property int totalActivities: DashboardController.overview.totalActivities || 0
     property int activitiesLimit: 10
-    property bool loadingActivities: false
+    readonly property bool loadingActivities: DashboardController.isBootstrapping
 
     property string currentView: "dashboard"
+    property int pageUnloadDelay: 5 * 60 * 1000
     property string editCourseId: ""
     property string reviewCourseId: ""
 
     // ─── reload tokens on every controller so API calls succeed ────────────────
     function reloadAllTokens() {
-        if (dashboardController)  dashboardController.reloadTokens()
-        if (courseController)     courseController.reloadTokens()
-        if (instructorController) instructorController.reloadTokens()
+        if (DashboardController)    DashboardController.reloadTokens()
+        if (CourseController)       CourseController.reloadTokens()
+        if (InstructorController)   InstructorController.reloadTokens()
+        if (UserController)         UserController.reloadTokens()
+        if (TransactionController)  TransactionController.reloadTokens()
+        if (NotificationController) NotificationController.reloadTokens()
+        if (RevenueController)      RevenueController.reloadTokens()
     }
 
-    Component.onCompleted: {
+    function revalidate() {
         reloadAllTokens()
-        if (dashboardController) dashboardController.loadStats()
-        loadPendingInstructors()
-        loadRecentActivities()
+        // Stats, pending instructors, activity and notifications in one update
+        if (DashboardController) DashboardController.bootstrap(activitiesLimit)
+        if (RevenueController) RevenueController.load()
+    }
+
+    Component.onCompleted: {
+        // After a warm start the restored snapshot is already on screen;
+        // wait for the token refresh before revalidating it.
+        if (SessionSnapshot.restored) StartupTrace.markNextFrame("dashboardMeaningfulPaint")
+        if (!SessionSnapshot.revalidating) revalidate()
     }
 
-    // Re-reload whenever a fresh login completes
     Connections {
-        target: authController
-        function onAccessTokenChanged() { reloadAllTokens() }
+        target: SessionSnapshot
+        function onRevalidated() { root.revalidate() }
     }
 
-    function loadPendingInstructors() {
-        var xhr = new XMLHttpRequest()
-        xhr.open("GET", "https://learning-dashboard-rouge.vercel.app/api/instructors?status=pending")
-        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
-        xhr.setRequestHeader("Accept", "application/json")
-
-        xhr.onreadystatechange = function() {
-            if (xhr.readyState === XMLHttpRequest.DONE) {
-                if (xhr.status === 200) {
-                    try {
-                        var response = JSON.parse(xhr.responseText)
-                        if (response.success) {
-                            pendingInstructors = response.data.instructors.slice(0, 5)
-                            totalPending = response.data.stats.pending || response.data.instructors.length
-                        }
-                    } catch (e) {
-                        console.log("Failed to parse instructors:", e)
-                    }
-                }
-            }
-        }
-        xhr.send()
+    // First meaningful paint: the first frame that shows real stats
+    Connections {
+        target: DashboardController
+        function onStatsLoaded() { StartupTrace.markNextFrame("dashboardMeaningfulPaint") }
+    }
+
+    // Re-reload whenever a fresh login completes
+    Connections {
+        target: AuthController
+        function onAccessTokenChanged() { reloadAllTokens() }
     }
 
     function getRelativeTime(isoDate) {
@@ -82,32 +82,6 @@ Rectangle {
         return ((firstName || "").charAt(0) + (lastName || "").charAt(0)).toUpperCase()
     }
 
-    function loadRecentActivities() {
-        loadingActivities = true
-        var xhr = new XMLHttpRequest()
-        xhr.open("GET", "https://learning-dashboard-rouge.vercel.app/api/dashboard/activity?limit=" + activitiesLimit)
-        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
-        xhr.setRequestHeader("Accept", "application/json")
-
-        xhr.onreadystatechange = function() {
-            if (xhr.readyState === XMLHttpRequest.DONE) {
-                loadingActivities = false
-                if (xhr.status === 200) {
-                    try {
-                        var response = JSON.parse(xhr.responseText)
-                        if (response.success) {
-                            recentActivities = response.data.activities
-                            totalActivities = response.data.total
-                        }
-                    } catch (e) {
-                        console.log("Failed to parse activities:", e)
-                    }
-                }
-            }
-        }
-        xhr.send()
-    }
-
     RowLayout {
         anchors.fill: parent
         spacing: 0
@@ -216,8 +190,9 @@ Rectangle {
                             cursorShape: Qt.PointingHandCursor
                             onClicked: {
                                 currentView = "instructors"
-                                if (instructorController) {
-                                    instructorController.loadInstructors()
+                                // A freshly created page loads itself
+                                if (instructorsLoader.item && InstructorController) {
+                                    InstructorController.loadInstructors()
                                 }
                             }
                         }
@@ -247,7 +222,7 @@ Rectangle {
                             cursorShape: Qt.PointingHandCursor
                             onClicked: {
                                 currentView = "courses"
-                                courseController.loadStats()
+                                if (coursesLoader.item) CourseController.loadStats()
                             }
                         }
                     }
@@ -276,7 +251,7 @@ Rectangle {
                             cursorShape: Qt.PointingHandCursor
                             onClicked: {
                                 currentView = "users"
-                                userController.loadStudents()
+                                if (usersLoader.item) UserController.loadStudents()
                             }
                         }
                     }
@@ -305,7 +280,7 @@ Rectangle {
                             cursorShape: Qt.PointingHandCursor
                             onClicked: {
                                 currentView = "transactions"
-                                transactionController.loadTransactions()
+                                if (transactionsLoader.item) TransactionController.loadTransactions()
                             }
                         }
                     }
@@ -360,7 +335,7 @@ Rectangle {
                             radius: 18
                             color: "#E5E7EB"
                             Text {
-                                text: authController && authController.userName ? authController.userName.charAt(0).toUpperCase() : "U"
+                                text: AuthController && AuthController.userName ? AuthController.userName.charAt(0).toUpperCase() : "U"
                                 color: "#6B7280"
                                 font.pixelSize: 14
                                 font.weight: Font.Medium
@@ -372,7 +347,7 @@ Rectangle {
                             Layout.fillWidth: true
                             spacing: 2
                             Text {
-                                text: authController ? authController.userName || "User" : "User"
+                                text: AuthController ? AuthController.userName || "User" : "User"
                                 color: "#18181B"
                                 font.pixelSize: 13
                                 font.weight: Font.Medium
@@ -380,7 +355,7 @@ Rectangle {
                                 Layout.fillWidth: true
                             }
                             Text {
-                                text: authController ? authController.userEmail || "user@email.com" : "user@email.com"
+                                text: AuthController ? AuthController.userEmail || "user@email.com" : "user@email.com"
                                 color: "#9CA3AF"
                                 font.pixelSize: 11
                                 elide: Text.ElideRight
@@ -409,7 +384,7 @@ Rectangle {
                         hoverEnabled: true
                         cursorShape: Qt.PointingHandCursor
                         onClicked: {
-                            authController.logout()
+                            AuthController.logout()
                             root.logout()
                         }
                     }
@@ -486,11 +461,11 @@ Rectangle {
                                 height: 17
                                 radius: 9
                                 color: "#EF4444"
-                                visible: notificationController && notificationController.unreadCount > 0
+                                visible: NotificationController && NotificationController.unreadCount > 0
                                 Text {
                                     id: badgeText
                                     anchors.centerIn: parent
-                                    text: notificationController ? notificationController.unreadCount.toString() : "0"
+                                    text: NotificationController ? NotificationController.unreadCount.toString() : "0"
                                     font.pixelSize: 10
                                     font.weight: Font.Bold
                                     color: "white"
@@ -505,7 +480,7 @@ Rectangle {
                                     if (bellPopup.opened) {
                                         bellPopup.close()
                                     } else {
-                                        notificationController.loadRecentNotifications()
+                                        NotificationController.loadRecentNotifications()
                                         bellPopup.open()
                                     }
                                 }
@@ -557,11 +532,11 @@ Rectangle {
                                             color: "#60A5FA"
                                             font.pixelSize: 12
                                             font.weight: Font.Medium
-                                            visible: notificationController && notificationController.unreadCount > 0
+                                            visible: NotificationController && NotificationController.unreadCount > 0
                                             MouseArea {
                                                 anchors.fill: parent
                                                 cursorShape: Qt.PointingHandCursor
-                                                onClicked: notificationController.markAllAsRead()
+                                                onClicked: NotificationController.markAllAsRead()
                                             }
                                         }
                                     }
@@ -576,7 +551,7 @@ Rectangle {
                                     ListView {
                                         id: bellList
                                         width: parent.width
-                                        model: notificationController ? notificationController.recentNotifications : []
+                                        model: NotificationController ? NotificationController.recentNotifications : []
                                         spacing: 0
 
                                         delegate: Rectangle {
@@ -676,7 +651,7 @@ Rectangle {
                                                 cursorShape: Qt.PointingHandCursor
                                                 onClicked: {
                                                     if (!modelData.isRead) {
-                                                        notificationController.markAsRead(modelData.id)
+                                                        NotificationController.markAsRead(modelData.id)
                                                     }
                                                 }
                                             }
@@ -709,7 +684,7 @@ Rectangle {
                                             onClicked: {
                                                 bellPopup.close()
                                                 currentView = "notifications"
-                                                notificationController.loadNotifications()
+                                                if (notificationsLoader.item) NotificationController.loadNotifications()
                                             }
                                         }
                                     }
@@ -821,14 +796,14 @@ Rectangle {
                                         }
 
                                         Text {
-                                            text: dashboardController ? dashboardController.totalInstructors.toString() : "0"
+                                            text: DashboardController ? DashboardController.totalInstructors.toString() : "0"
                                             font.pixelSize: 28
                                             font.bold: true
                                             color: "#18181B"
                                         }
 
                                         Text {
-                                            text: dashboardController ? dashboardController.verifiedInstructors + " verified" : "0 verified"
+                                            text: DashboardController ? DashboardController.verifiedInstructors + " verified" : "0 verified"
                                             font.pixelSize: 11
                                             color: "#9CA3AF"
                                         }
@@ -871,14 +846,14 @@ Rectangle {
                                         }
 
                                         Text {
-                                            text: dashboardController ? dashboardController.totalCourses.toString() : "0"
+                                            text: DashboardController ? DashboardController.totalCourses.toString() : "0"
                                             font.pixelSize: 28
                                             font.bold: true
                                             color: "#18181B"
                                         }
 
                                         Text {
-                                            text: dashboardController ? dashboardController.activeCourses + " active courses" : "0 active courses"
+                                            text: DashboardController ? DashboardController.activeCourses + " active courses" : "0 active courses"
                                             font.pixelSize: 11
                                             color: "#9CA3AF"
                                         }
@@ -921,14 +896,14 @@ Rectangle {
                                         }
 
                                         Text {
-                                            text: dashboardController ? dashboardController.totalStudents.toString() : "0"
+                                            text: DashboardController ? DashboardController.totalStudents.toString() : "0"
                                             font.pixelSize: 28
                                             font.bold: true
                                             color: "#18181B"
                                         }
 
                                         Text {
-                                            text: dashboardController ? dashboardController.activeStudents + " active students" : "0 active students"
+                                            text: DashboardController ? DashboardController.activeStudents + " active students" : "0 active students"
                                             font.pixelSize: 11
                                             color: "#9CA3AF"
                                         }
@@ -971,14 +946,14 @@ Rectangle {
                                         }
 
                                         Text {
-                                            text: dashboardController ? dashboardController.formattedTotalRevenue : "$0"
+                                            text: DashboardController ? DashboardController.formattedTotalRevenue : "$0"
                                             font.pixelSize: 28
                                             font.bold: true
                                             color: "#18181B"
                                         }
 
                                         Text {
-                                            text: dashboardController ? dashboardController.formattedMonthlyRevenue + " this month" : "$0 this month"
+                                            text: DashboardController ? DashboardController.formattedMonthlyRevenue + " this month" : "$0 this month"
                                             font.pixelSize: 11
                                             color: "#9CA3AF"
                                         }
@@ -1010,12 +985,22 @@ Rectangle {
                                             color: "#18181B"
                                         }
                                         Item { Layout.fillWidth: true }
+                                        Text {
+                                            visible: RevenueController.hasData
+                                            text: RevenueController.formattedTotal
+                                            font.pixelSize: 14
+                                            font.weight: Font.DemiBold
+                                            color: "#18181B"
+                                            Layout.rightMargin: 12
+                                        }
                                         ComboBox {
+                                            readonly property var rangeDays: [30, 7, 90]
                                             model: ["Last 30 days", "Last 7 days", "Last 90 days"]
-                                            currentIndex: 0
+                                            currentIndex: Math.max(0, rangeDays.indexOf(RevenueController.rangeDays))
                                             font.pixelSize: 12
                                             Layout.preferredWidth: 130
                                             Layout.preferredHeight: 32
+                                            onActivated: function(index) { RevenueController.rangeDays = rangeDays[index] }
                                         }
                                     }
 
@@ -1025,9 +1010,34 @@ Rectangle {
                                         color: "#F3F4F6"
                                     }
 
-                                    Item { Layout.fillHeight: true }
+                                    // Revenue per day (per week for 90 days)
+                                    ChartItem {
+                                        id: revenueBars
+                                        visible: RevenueController.hasData
+                                        Layout.fillWidth: true
+                                        Layout.fillHeight: true
+                                        type: ChartItem.Bar
+                                        color: "#6366F1"
+                                        values: RevenueController.values
+                                        maxValue: RevenueController.maxValue
+
+                                        MouseArea {
+                                            id: revenueMA
+                                            anchors.fill: parent
+                                            hoverEnabled: true
+                                            property int index: containsMouse ? revenueBars.indexAt(mouseX) : -1
+
+                                            ToolTip.visible: index >= 0
+                                            ToolTip.text: index >= 0 ?
+                                                              RevenueController.points[index].label + ": " +
+                                                              RevenueController.points[index].formattedAmount : ""
+                                        }
+                                    }
+
+                                    Item { Layout.fillHeight: true; visible: !revenueBars.visible }
 
                                     ColumnLayout {
+                                        visible: !revenueBars.visible
                                         Layout.alignment: Qt.AlignCenter
                                         spacing: 12
 
@@ -1038,7 +1048,7 @@ Rectangle {
                                         }
 
                                         Text {
-                                            text: "No Revenue Data Yet"
+                                            text: RevenueController.isLoading ? "Loading Revenue…" : "No Revenue Data Yet"
                                             font.pixelSize: 16
                                             font.weight: Font.Medium
                                             color: "#18181B"
@@ -1281,28 +1291,53 @@ Rectangle {
                 }
             }
 
+            // Pages 1-6 are created on first navigation (see PageLoader.qml);
+            // list pages are released again after 5 minutes off screen.
+
             // ========== PAGE 1: INSTRUCTORS ==========
-            InstructorsPage {
+            PageLoader {
+                id: instructorsLoader
+                current: currentView === "instructors"
+                unloadAfter: root.pageUnloadDelay
+                sourceComponent: Component { InstructorsPage {} }
             }
 
             // ========== PAGE 2: COURSES ==========
-            CoursesPage {
+            PageLoader {
+                id: coursesLoader
+                current: currentView === "courses"
+                unloadAfter: root.pageUnloadDelay
+                sourceComponent: Component { CoursesPage {} }
             }
 
             // ========== PAGE 3: USERS ==========
-            UsersPage {
+            PageLoader {
+                id: usersLoader
+                current: currentView === "users"
+                unloadAfter: root.pageUnloadDelay
+                sourceComponent: Component { UsersPage {} }
             }
 
             // ========== PAGE 4: TRANSACTIONS ==========
-            TransactionsPage {
+            PageLoader {
+                id: transactionsLoader
+                current: currentView === "transactions"
+                unloadAfter: root.pageUnloadDelay
+                sourceComponent: Component { TransactionsPage {} }
             }
 
             // ========== PAGE 5: NOTIFICATIONS ==========
-            NotificationsPage {
+            PageLoader {
+                id: notificationsLoader
+                current: currentView === "notifications"
+                unloadAfter: root.pageUnloadDelay
+                sourceComponent: Component { NotificationsPage {} }
             }
 
             // ========== PAGE 6: SETTINGS ==========
-            SettingsPage {
+            PageLoader {
+                current: currentView === "settings"
+                sourceComponent: Component { SettingsPage {} }
             }
 
             // ========== PAGE 7: EDIT COURSE ==========
@@ -1316,7 +1351,7 @@ Rectangle {
                 onCourseSaved: {
                     root.currentView = "courses"
                     root.editCourseId = ""
-                    if (courseController) courseController.reloadTokens()
+                    if (CourseController) CourseController.reloadTokens()
                 }
             }
 
@@ -1331,12 +1366,12 @@ Rectangle {
                 onCourseApproved: {
                     root.currentView = "courses"
                     root.reviewCourseId = ""
-                    if (courseController) { courseController.reloadTokens(); courseController.refresh() }
+                    if (CourseController) { CourseController.reloadTokens(); CourseController.refresh() }
                 }
                 onCourseRejected: {
                     root.currentView = "courses"
                     root.reviewCourseId = ""
-                    if (courseController) { courseController.reloadTokens(); courseController.refresh() }
+                    if (CourseController) { CourseController.reloadTokens(); CourseController.refresh() }
                 }
             }
             }
@@ -1,6 +1,8 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import QtQuick.Dialogs
+import Lumin 1.0
 
 Item {
     id: root
@@ -19,8 +21,8 @@ Item {
     function fetchCourse() {
         isLoading = true
         var xhr = new XMLHttpRequest()
-        xhr.open("GET", "https://learning-dashboard-rouge.vercel.app/api/courses/" + courseId)
-        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
+        xhr.open("GET", AuthController.apiBaseUrl + "/api/courses/" + courseId)
+        xhr.setRequestHeader("Authorization", "Bearer " + (AuthController ? AuthController.accessToken : ""))
         xhr.setRequestHeader("Accept", "application/json")
         xhr.onreadystatechange = function() {
             if (xhr.readyState !== XMLHttpRequest.DONE) return
@@ -88,8 +90,8 @@ Item {
         if (discountField.text.trim().length > 0)
             payload["discountPrice"] = parseFloat(discountField.text) || 0
         var xhr = new XMLHttpRequest()
-        xhr.open("PUT", "https://learning-dashboard-rouge.vercel.app/api/courses/" + courseId)
-        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
+        xhr.open("PUT", AuthController.apiBaseUrl + "/api/courses/" + courseId)
+        xhr.setRequestHeader("Authorization", "Bearer " + (AuthController ? AuthController.accessToken : ""))
         xhr.setRequestHeader("Content-Type", "application/json")
         xhr.setRequestHeader("Accept", "application/json")
         xhr.onreadystatechange = function() {
@@ -111,8 +113,8 @@ Item {
 
     function submitForReview() {
         var xhr = new XMLHttpRequest()
-        xhr.open("PUT", "https://learning-dashboard-rouge.vercel.app/api/courses/" + courseId + "/status")
-        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
+        xhr.open("PUT", AuthController.apiBaseUrl + "/api/courses/" + courseId + "/status")
+        xhr.setRequestHeader("Authorization", "Bearer " + (AuthController ? AuthController.accessToken : ""))
         xhr.setRequestHeader("Content-Type", "application/json")
         xhr.setRequestHeader("Accept", "application/json")
         xhr.onreadystatechange = function() {
@@ -259,12 +261,31 @@ Item {
                                         }
                                         ColumnLayout { Layout.fillWidth: true; spacing: 6
                                             Text { text: "Thumbnail URL"; font.pixelSize: 13; font.weight: Font.Medium; color: "#374151" }
-                                            TextField { id: thumbnailField; Layout.fillWidth: true; Layout.preferredHeight: 42; placeholderText: "https://example.com/thumbnail.jpg"; selectByMouse: true; leftPadding: 12; rightPadding: 12
-                                                background: Rectangle { radius: 6; color: "white"; border.color: parent.activeFocus ? "#4F46E5" : "#E5E7EB"; border.width: parent.activeFocus ? 2 : 1 } } }
+                                            RowLayout { Layout.fillWidth: true; spacing: 8
+                                                TextField { id: thumbnailField; Layout.fillWidth: true; Layout.preferredHeight: 42; placeholderText: "https://example.com/thumbnail.jpg"; selectByMouse: true; leftPadding: 12; rightPadding: 12
+                                                    background: Rectangle { radius: 6; color: "white"; border.color: parent.activeFocus ? "#4F46E5" : "#E5E7EB"; border.width: parent.activeFocus ? 2 : 1 } }
+                                                Rectangle { Layout.preferredHeight: 42; Layout.preferredWidth: thumbUploadText.implicitWidth + 24; radius: 6; color: thumbUploadMA.containsMouse ? "#F3F4F6" : "white"; border.color: "#E5E7EB"; border.width: 1
+                                                    Text { id: thumbUploadText; anchors.centerIn: parent; text: "⤒ Upload"; font.pixelSize: 13; color: "#374151" }
+                                                    MouseArea { id: thumbUploadMA; anchors.fill: parent; hoverEnabled: true; cursorShape: Qt.PointingHandCursor; enabled: !CourseController.isUploadingMedia
+                                                        onClicked: { mediaDialog.purpose = "thumbnail"; mediaDialog.nameFilters = ["Images (*.png *.jpg *.jpeg *.webp)"]; mediaDialog.open() } } }
+                                            } }
                                         ColumnLayout { Layout.fillWidth: true; spacing: 6
                                             Text { text: "Promo Video URL"; font.pixelSize: 13; font.weight: Font.Medium; color: "#374151" }
-                                            TextField { id: promoVideoField; Layout.fillWidth: true; Layout.preferredHeight: 42; placeholderText: "https://youtube.com/watch?v=…"; selectByMouse: true; leftPadding: 12; rightPadding: 12
-                                                background: Rectangle { radius: 6; color: "white"; border.color: parent.activeFocus ? "#4F46E5" : "#E5E7EB"; border.width: parent.activeFocus ? 2 : 1 } }
+                                            RowLayout { Layout.fillWidth: true; spacing: 8
+                                                TextField { id: promoVideoField; Layout.fillWidth: true; Layout.preferredHeight: 42; placeholderText: "https://youtube.com/watch?v=…"; selectByMouse: true; leftPadding: 12; rightPadding: 12
+                                                    background: Rectangle { radius: 6; color: "white"; border.color: parent.activeFocus ? "#4F46E5" : "#E5E7EB"; border.width: parent.activeFocus ? 2 : 1 } }
+                                                Rectangle { Layout.preferredHeight: 42; Layout.preferredWidth: videoUploadText.implicitWidth + 24; radius: 6; color: videoUploadMA.containsMouse ? "#F3F4F6" : "white"; border.color: "#E5E7EB"; border.width: 1
+                                                    Text { id: videoUploadText; anchors.centerIn: parent; text: "⤒ Upload"; font.pixelSize: 13; color: "#374151" }
+                                                    MouseArea { id: videoUploadMA; anchors.fill: parent; hoverEnabled: true; cursorShape: Qt.PointingHandCursor; enabled: !CourseController.isUploadingMedia
+                                                        onClicked: { mediaDialog.purpose = "promoVideo"; mediaDialog.nameFilters = ["Videos (*.mp4 *.mov *.webm *.mkv)"]; mediaDialog.open() } } }
+                                            }
+                                        }
+                                        // Chunked upload progress; a failed upload resumes when the same file is chosen again
+                                        RowLayout { Layout.fillWidth: true; spacing: 8; visible: CourseController.isUploadingMedia
+                                            ProgressBar { Layout.fillWidth: true; from: 0; to: 1; value: CourseController.mediaUploadProgress }
+                                            Text { text: Math.round(CourseController.mediaUploadProgress * 100) + "%"; font.pixelSize: 12; color: "#6B7280" }
+                                            Text { text: "Cancel"; font.pixelSize: 12; color: "#DC2626"
+                                                MouseArea { anchors.fill: parent; cursorShape: Qt.PointingHandCursor; onClicked: CourseController.cancelMediaUpload() } }
                                         }
                                     }
                                 }
@@ -581,4 +602,19 @@ Item {
             }
         }
     }
+
+    FileDialog {
+        id: mediaDialog
+        property string purpose: "thumbnail"
+        title: "Choose a file to upload"
+        onAccepted: CourseController.uploadCourseMedia(selectedFile, root.courseId, purpose)
+    }
+
+    Connections {
+        target: CourseController
+        function onMediaUploaded(url, purpose) {
+            if (purpose === "promoVideo") promoVideoField.text = url
+            else thumbnailField.text = url
+        }
+    }
 }
@@ -0,0 +1,92 @@
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+import QtQuick.Controls.Material 2.15
+import QtQuick.Dialogs
+
+// Header button that asks for a .csv/.jsonl file and shows the progress of
+// the running export; clicking it while exporting cancels.
+Rectangle {
+    id: root
+
+    property bool exporting: false
+    property real progress: 0
+    property int rows: 0
+
+    signal exportRequested(url fileUrl)
+    signal cancelRequested()
+
+    function showResult(success, message) {
+        resultTip.success = success
+        resultTip.text = message
+        resultTip.open()
+    }
+
+    height: 36
+    width: exportText.implicitWidth + 24
+    radius: 6
+    color: exportMA.containsMouse ? "#F3F4F6" : "white"
+    border.color: "#E5E7EB"
+    border.width: 1
+
+    // Fill behind the label while exporting
+    Rectangle {
+        visible: root.exporting
+        anchors.left: parent.left
+        anchors.top: parent.top
+        anchors.bottom: parent.bottom
+        anchors.margins: 1
+        width: (parent.width - 2) * root.progress
+        radius: 5
+        color: "#EEF2FF"
+    }
+
+    Text {
+        id: exportText
+        anchors.centerIn: parent
+        text: !root.exporting ? "⤓ Export" :
+              root.progress > 0 ? "Exporting " + Math.round(root.progress * 100) + "% · ✕" :
+                                  "Exporting… · ✕"
+        font.pixelSize: 13
+        color: "#6B7280"
+    }
+
+    MouseArea {
+        id: exportMA
+        anchors.fill: parent
+        hoverEnabled: true
+        cursorShape: Qt.PointingHandCursor
+        onClicked: root.exporting ? root.cancelRequested() : fileDialog.open()
+    }
+
+    ToolTip.visible: root.exporting && exportMA.containsMouse
+    ToolTip.text: root.rows + " rows written. Click to cancel."
+
+    FileDialog {
+        id: fileDialog
+        title: "Export"
+        fileMode: FileDialog.SaveFile
+        defaultSuffix: "csv"
+        nameFilters: ["CSV files (*.csv)", "JSON Lines (*.jsonl)"]
+        onAccepted: root.exportRequested(selectedFile)
+    }
+
+    ToolTip {
+        id: resultTip
+        property bool success: true
+        parent: Overlay.overlay
+        timeout: 4000
+        x: (parent.width - width) / 2
+        y: parent.height - height - 32
+
+        background: Rectangle {
+            color: resultTip.success ? Material.color(Material.Green) : Material.color(Material.Red)
+            radius: 4
+        }
+
+        contentItem: Label {
+            text: resultTip.text
+            color: "white"
+            font.pixelSize: 14
+        }
+    }
+}
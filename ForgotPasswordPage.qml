@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Rectangle {
     id: root
@@ -55,9 +56,9 @@ Rectangle {
                     height: 52
                     radius: 8
                     color: "#FEE2E2"
-                    visible: authController && authController.errorMessage !== ""
+                    visible: AuthController && AuthController.errorMessage !== ""
                     Text {
-                        text: authController ? authController.errorMessage : ""
+                        text: AuthController ? AuthController.errorMessage : ""
                         color: "#DC2626"
                         font.pixelSize: 14
                         anchors.centerIn: parent
@@ -105,7 +106,7 @@ Rectangle {
                             height: 52
                             leftPadding: 16
                             rightPadding: 16
-                            enabled: !authController || !authController.isLoading
+                            enabled: !AuthController || !AuthController.isLoading
                             background: Rectangle {
                                 radius: 8
                                 color: "#ffffff"
@@ -114,17 +115,17 @@ Rectangle {
                             }
                             onAccepted: {
                                 if (forgotEmailField.text.includes("@")) {
-                                    authController.forgotPassword(forgotEmailField.text.trim())
+                                    AuthController.forgotPassword(forgotEmailField.text.trim())
                                 }
                             }
                         }
                     }
 
                     Button {
-                        text: (authController && authController.isLoading) ? "Sending..." : "Send Reset Link"
+                        text: (AuthController && AuthController.isLoading) ? "Sending..." : "Send Reset Link"
                         width: parent.width
                         height: 52
-                        enabled: (!authController || !authController.isLoading) && forgotEmailField.text.includes("@")
+                        enabled: (!AuthController || !AuthController.isLoading) && forgotEmailField.text.includes("@")
                         background: Rectangle {
                             radius: 8
                             color: parent.enabled ? (parent.pressed ? "#0f0f0f" : (parent.hovered ? "#2a2a2a" : "#1a1a1a")) : "#e5e7eb"
@@ -138,8 +139,8 @@ Rectangle {
                             verticalAlignment: Text.AlignVCenter
                         }
                         onClicked: {
-                            authController.clearError()
-                            authController.forgotPassword(forgotEmailField.text.trim())
+                            AuthController.clearError()
+                            AuthController.forgotPassword(forgotEmailField.text.trim())
                         }
                     }
 
@@ -152,7 +153,7 @@ Rectangle {
                             anchors.fill: parent
                             cursorShape: Qt.PointingHandCursor
                             onClicked: {
-                                authController.clearError()
+                                AuthController.clearError()
                                 root.navigateBack()
                             }
                         }
@@ -176,7 +177,7 @@ Rectangle {
     }
 
     Connections {
-        target: authController
+        target: AuthController
         function onPasswordResetSent() {
             root.emailSent = true
             successTimer.start()
@@ -0,0 +1,64 @@
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+import QtQuick.Layouts 1.15
+import Lumin 1.0
+
+// Frame timing overlay (FrameMonitor). Toggled with Ctrl+Shift+F or from
+// the diagnostics card in Settings; stats refresh twice a second.
+Rectangle {
+    id: root
+
+    visible: FrameMonitor.overlayVisible
+    width: 320
+    height: column.implicitHeight + 20
+    radius: 8
+    color: "#E6111827"
+
+    ColumnLayout {
+        id: column
+        anchors.fill: parent
+        anchors.margins: 10
+        spacing: 4
+
+        RowLayout {
+            Layout.fillWidth: true
+            Text {
+                text: FrameMonitor.fps + " fps"
+                font.pixelSize: 16; font.weight: Font.DemiBold
+                color: FrameMonitor.fps >= 50 || FrameMonitor.fps === 0 ? "#34D399" : "#FBBF24"
+            }
+            Item { Layout.fillWidth: true }
+            Text {
+                text: "Reset"
+                font.pixelSize: 12; color: "#9CA3AF"
+                MouseArea { anchors.fill: parent; cursorShape: Qt.PointingHandCursor; onClicked: FrameMonitor.reset() }
+            }
+        }
+
+        Text {
+            text: "last " + FrameMonitor.lastFrameMs.toFixed(1) + " ms · p95 " + FrameMonitor.p95FrameMs.toFixed(1)
+                  + " ms · dropped " + FrameMonitor.droppedFrames + " / " + FrameMonitor.totalFrames
+            font.pixelSize: 12; color: "#E5E7EB"
+        }
+
+        Text {
+            visible: FrameMonitor.longFrames.length > 0
+            text: "Long frames"
+            font.pixelSize: 12; font.weight: Font.Medium; color: "#9CA3AF"
+            Layout.topMargin: 4
+        }
+
+        Repeater {
+            model: FrameMonitor.longFrames.slice(0, 6)
+            delegate: Text {
+                required property var modelData
+                Layout.fillWidth: true
+                text: modelData.durationMs + " ms  " + (modelData.stall ? "blocked by " : "")
+                      + (modelData.events !== "" ? modelData.events : "(no noted work)")
+                elide: Text.ElideRight
+                font.pixelSize: 11
+                color: modelData.durationMs > 100 ? "#F87171" : "#FBBF24"
+            }
+        }
+    }
+}
@@ -54,7 +54,9 @@ Rectangle {
                 Image {
                     anchors.fill: parent
                     anchors.margins: 0
-                    source: instructor.image || ""
+                    source: instructor.image ? "image://remote/" + encodeURIComponent(instructor.image) : ""
+                    sourceSize: Qt.size(96, 96)
+                    asynchronous: true
                     fillMode: Image.PreserveAspectCrop
                     visible: instructor.image && instructor.image.length > 0
                 }
@@ -1,13 +1,14 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Item {
     id: root
 
     Component.onCompleted: {
-        instructorController.reloadTokens()
-        instructorController.loadInstructors()
+        InstructorController.reloadTokens()
+        InstructorController.loadInstructors()
     }
 
     // Toast notification
@@ -27,7 +28,7 @@ Item {
     }
 
     Connections {
-        target: instructorController
+        target: InstructorController
         function onInstructorUpdated(message) {
             showToast(message, true)
         }
@@ -115,8 +116,8 @@ Item {
                         hoverEnabled: true
                         cursorShape: Qt.PointingHandCursor
                         onClicked: {
-                            instructorController.reloadTokens()
-                            instructorController.refresh()
+                            InstructorController.reloadTokens()
+                            InstructorController.refresh()
                         }
                     }
                 }
@@ -129,10 +130,10 @@ Item {
 
                 Repeater {
                     model: [
-                        { title: "Total Instructors", icon: "👥", bg: "#EEF2FF", val: instructorController.totalInstructors },
-                        { title: "Pending Requests",  icon: "⏳", bg: "#FEF3C7", val: instructorController.pendingInstructors },
-                        { title: "Verified",          icon: "✓",  bg: "#DCFCE7", val: instructorController.verifiedInstructors },
-                        { title: "Rejected",          icon: "✕",  bg: "#FEE2E2", val: instructorController.rejectedInstructors }
+                        { title: "Total Instructors", icon: "👥", bg: "#EEF2FF", val: InstructorController.totalInstructors },
+                        { title: "Pending Requests",  icon: "⏳", bg: "#FEF3C7", val: InstructorController.pendingInstructors },
+                        { title: "Verified",          icon: "✓",  bg: "#DCFCE7", val: InstructorController.verifiedInstructors },
+                        { title: "Rejected",          icon: "✕",  bg: "#FEE2E2", val: InstructorController.rejectedInstructors }
                     ]
 
                     Rectangle {
@@ -201,7 +202,7 @@ Item {
                         Repeater {
                             model: [
                                 { label: "All",     value: "all" },
-                                { label: "Pending (" + instructorController.pendingInstructors + ")", value: "pending" },
+                                { label: "Pending (" + InstructorController.pendingInstructors + ")", value: "pending" },
                                 { label: "Verified", value: "verified" },
                                 { label: "Rejected", value: "rejected" }
                             ]
@@ -211,7 +212,7 @@ Item {
                                 width: tabLbl.implicitWidth + 24
                                 radius: 17
                                 color: {
-                                    var active = instructorController.currentStatus === modelData.value
+                                    var active = InstructorController.currentStatus === modelData.value
                                     if (active) return "#E91E8C"
                                     if (tabMA.containsMouse) return "#F3F4F6"
                                     return "transparent"
@@ -221,14 +222,14 @@ Item {
                                     anchors.centerIn: parent
                                     text: modelData.label
                                     font.pixelSize: 13
-                                    color: instructorController.currentStatus === modelData.value ? "white" : "#6B7280"
+                                    color: InstructorController.currentStatus === modelData.value ? "white" : "#6B7280"
                                 }
                                 MouseArea {
                                     id: tabMA
                                     anchors.fill: parent
                                     hoverEnabled: true
                                     cursorShape: Qt.PointingHandCursor
-                                    onClicked: instructorController.setStatusFilter(modelData.value)
+                                    onClicked: InstructorController.setStatusFilter(modelData.value)
                                 }
                             }
                         }
@@ -270,7 +271,7 @@ Item {
                                 Timer {
                                     id: searchTimer
                                     interval: 500
-                                    onTriggered: instructorController.setSearchQuery(searchInput.text)
+                                    onTriggered: InstructorController.setSearchQuery(searchInput.text)
                                 }
                             }
                         }
@@ -293,7 +294,7 @@ Item {
                                 anchors.fill: parent
                                 hoverEnabled: true
                                 cursorShape: Qt.PointingHandCursor
-                                onClicked: instructorController.setSearchQuery(searchInput.text)
+                                onClicked: InstructorController.setSearchQuery(searchInput.text)
                             }
                         }
                     }
@@ -373,10 +374,10 @@ Item {
                         ColumnLayout {
                             anchors.centerIn: parent
                             spacing: 12
-                            visible: instructorController.isLoading
+                            visible: InstructorController.isLoading
                             BusyIndicator {
                                 Layout.alignment: Qt.AlignHCenter
-                                running: instructorController.isLoading
+                                running: InstructorController.isLoading
                                 palette.dark: "#E91E8C"
                             }
                             Text {
@@ -391,7 +392,7 @@ Item {
                         ColumnLayout {
                             anchors.centerIn: parent
                             spacing: 12
-                            visible: !instructorController.isLoading && instructorController.instructors.length === 0
+                            visible: !InstructorController.isLoading && InstructorController.instructors.length === 0
                             Text {
                                 Layout.alignment: Qt.AlignHCenter
                                 text: "👥"
@@ -415,7 +416,7 @@ Item {
                         // Instructor list
                         ScrollView {
                             anchors.fill: parent
-                            visible: !instructorController.isLoading && instructorController.instructors.length > 0
+                            visible: !InstructorController.isLoading && InstructorController.instructors.length > 0
                             clip: true
                             ScrollBar.vertical.policy: ScrollBar.AsNeeded
                             ScrollBar.horizontal.policy: ScrollBar.AlwaysOff
@@ -425,7 +426,7 @@ Item {
                                 spacing: 0
 
                                 Repeater {
-                                    model: instructorController.instructors
+                                    model: InstructorController.instructors
 
                                     Rectangle {
                                         Layout.fillWidth: true
@@ -545,9 +546,9 @@ Item {
                                                         anchors.fill: parent
                                                         hoverEnabled: true
                                                         cursorShape: Qt.PointingHandCursor
-                                                        enabled: !instructorController.isLoading
+                                                        enabled: !InstructorController.isLoading
                                                         onClicked: {
-                                                            instructorController.approveInstructor(modelData.id)
+                                                            InstructorController.approveInstructor(modelData.id)
                                                         }
                                                     }
                                                 }
@@ -573,9 +574,9 @@ Item {
                                                         anchors.fill: parent
                                                         hoverEnabled: true
                                                         cursorShape: Qt.PointingHandCursor
-                                                        enabled: !instructorController.isLoading
+                                                        enabled: !InstructorController.isLoading
                                                         onClicked: {
-                                                            instructorController.rejectInstructor(modelData.id)
+                                                            InstructorController.rejectInstructor(modelData.id)
                                                         }
                                                     }
                                                 }
@@ -601,9 +602,9 @@ Item {
                                                         anchors.fill: parent
                                                         hoverEnabled: true
                                                         cursorShape: Qt.PointingHandCursor
-                                                        enabled: !instructorController.isLoading
+                                                        enabled: !InstructorController.isLoading
                                                         onClicked: {
-                                                            instructorController.revokeInstructor(modelData.id)
+                                                            InstructorController.revokeInstructor(modelData.id)
                                                         }
                                                     }
                                                 }
@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Rectangle {
     id: root
@@ -10,6 +11,8 @@ Rectangle {
     signal navigateToForgotPassword()
     signal navigateToRegister()
 
+    Component.onCompleted: AuthController.preconnect()
+
     RowLayout {
         anchors.fill: parent
         spacing: 0
@@ -57,9 +60,9 @@ Rectangle {
                     height: 52
                     radius: 8
                     color: "#FEE2E2"
-                    visible: authController && authController.errorMessage !== ""
+                    visible: AuthController && AuthController.errorMessage !== ""
                     Text {
-                        text: authController ? authController.errorMessage : ""
+                        text: AuthController ? AuthController.errorMessage : ""
                         color: "#DC2626"
                         font.pixelSize: 14
                         anchors.centerIn: parent
@@ -90,7 +93,7 @@ Rectangle {
                             height: 52
                             leftPadding: 16
                             rightPadding: 16
-                            enabled: !authController || !authController.isLoading
+                            enabled: !AuthController || !AuthController.isLoading
                             background: Rectangle {
                                 radius: 8
                                 color: "#ffffff"
@@ -137,10 +140,10 @@ Rectangle {
                                     background: Rectangle { color: "transparent" }
                                     leftPadding: 0
                                     rightPadding: 0
-                                    enabled: !authController || !authController.isLoading
+                                    enabled: !AuthController || !AuthController.isLoading
                                     onAccepted: {
                                         if (emailField.text.length > 0 && passwordField.text.length > 0) {
-                                            authController.login(emailField.text.trim(), passwordField.text)
+                                            AuthController.login(emailField.text.trim(), passwordField.text)
                                         }
                                     }
                                 }
@@ -185,7 +188,7 @@ Rectangle {
                                 anchors.fill: parent
                                 cursorShape: Qt.PointingHandCursor
                                 onClicked: {
-                                    authController.clearError()
+                                    AuthController.clearError()
                                     root.navigateToForgotPassword()
                                 }
                             }
@@ -193,10 +196,10 @@ Rectangle {
                     }
 
                     Button {
-                        text: (authController && authController.isLoading) ? "Logging in..." : "Login"
+                        text: (AuthController && AuthController.isLoading) ? "Logging in..." : "Login"
                         width: parent.width
                         height: 52
-                        enabled: !authController || !authController.isLoading
+                        enabled: !AuthController || !AuthController.isLoading
                         background: Rectangle {
                             radius: 8
                             color: parent.enabled ? (parent.pressed ? "#0f0f0f" : (parent.hovered ? "#2a2a2a" : "#1a1a1a")) : "#e5e7eb"
@@ -211,7 +214,7 @@ Rectangle {
                         }
                         onClicked: {
                             if (emailField.text.length > 0 && passwordField.text.length > 0) {
-                                authController.login(emailField.text.trim(), passwordField.text)
+                                AuthController.login(emailField.text.trim(), passwordField.text)
                             }
                         }
                     }
@@ -232,7 +235,7 @@ Rectangle {
                                 anchors.fill: parent
                                 cursorShape: Qt.PointingHandCursor
                                 onClicked: {
-                                    authController.clearError()
+                                    AuthController.clearError()
                                     root.navigateToRegister()
                                 }
                             }
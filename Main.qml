@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Window 2.15
 import QtQuick.Controls 2.15
+import Lumin 1.0
 
 ApplicationWindow {
     id: window
@@ -12,8 +13,8 @@ ApplicationWindow {
     StackView {
         id: stackView
         anchors.fill: parent
-        // ALWAYS start with login page
-        initialItem: loginComponent
+        // Start on the dashboard only when a still-valid session was restored
+        initialItem: SessionSnapshot.restored ? dashboardComponent : loginComponent
     }
 
     Component {
@@ -54,13 +55,25 @@ ApplicationWindow {
         id: dashboardComponent
         DashboardPage {
             onLogout: {
-                authController.logout()
+                AuthController.logout()
                 stackView.clear()
                 stackView.push(loginComponent)
             }
         }
     }
 
+    FrameMonitorOverlay {
+        anchors.top: parent.top
+        anchors.right: parent.right
+        anchors.margins: 12
+        z: 1000
+    }
+
+    Shortcut {
+        sequence: "Ctrl+Shift+F"
+        onActivated: FrameMonitor.overlayVisible = !FrameMonitor.overlayVisible
+    }
+
     RegistrationSuccessDialog {
         id: successDialog
         onAccepted: {
@@ -70,7 +83,7 @@ ApplicationWindow {
     }
 
     Connections {
-        target: authController
+        target: AuthController
 
         function onLoginSuccessful() {
             stackView.push(otpComponent)
@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Rectangle {
     id: root
@@ -41,7 +42,7 @@ Rectangle {
                         anchors.horizontalCenter: parent.horizontalCenter
                     }
                     Text {
-                        text: "Enter the OTP(one time password) to verify your login.\nA code has been sent to " + (authController ? authController.maskedEmail : "")
+                        text: "Enter the OTP(one time password) to verify your login.\nA code has been sent to " + (AuthController ? AuthController.maskedEmail : "")
                         color: "#6b7280"
                         font.pixelSize: 14
                         horizontalAlignment: Text.AlignHCenter
@@ -54,10 +55,10 @@ Rectangle {
                     height: 52
                     radius: 8
                     color: "#FEE2E2"
-                    visible: authController && authController.errorMessage !== ""
+                    visible: AuthController && AuthController.errorMessage !== ""
                     anchors.horizontalCenter: parent.horizontalCenter
                     Text {
-                        text: authController ? authController.errorMessage : ""
+                        text: AuthController ? AuthController.errorMessage : ""
                         color: "#DC2626"
                         font.pixelSize: 14
                         anchors.centerIn: parent
@@ -91,7 +92,7 @@ Rectangle {
                                 horizontalAlignment: TextInput.AlignHCenter
                                 verticalAlignment: TextInput.AlignVCenter
                                 color: "#1a1a1a"
-                                enabled: !authController || !authController.isLoading
+                                enabled: !AuthController || !AuthController.isLoading
                                 validator: RegularExpressionValidator { regularExpression: /[0-9]*/ }
 
                                 background: Rectangle {
@@ -116,7 +117,7 @@ Rectangle {
                                                 return input.text
                                             }).join("")
                                             if (code.length === 6) {
-                                                authController.verifyOtp(code)
+                                                AuthController.verifyOtp(code)
                                             }
                                         }
                                     }
@@ -136,7 +137,7 @@ Rectangle {
 
                                         if (digits.length === 6) {
                                             Qt.callLater(function() {
-                                                authController.verifyOtp(digits)
+                                                AuthController.verifyOtp(digits)
                                             })
                                         }
 
@@ -170,7 +171,7 @@ Rectangle {
                                     if (digits.length >= 6) {
                                         root.otpFields[5].forceActiveFocus()
                                         Qt.callLater(function() {
-                                            authController.verifyOtp(digits.substring(0, 6))
+                                            AuthController.verifyOtp(digits.substring(0, 6))
                                         })
                                     } else {
                                         let nextIndex = Math.min(digits.length, 5)
@@ -193,10 +194,10 @@ Rectangle {
                 }
 
                 Button {
-                    text: (authController && authController.isLoading) ? "Verifying..." : "Verify"
+                    text: (AuthController && AuthController.isLoading) ? "Verifying..." : "Verify"
                     width: parent.width
                     height: 52
-                    enabled: !authController || !authController.isLoading
+                    enabled: !AuthController || !AuthController.isLoading
                     background: Rectangle {
                         radius: 8
                         color: parent.enabled ? (parent.pressed ? "#0f0f0f" : (parent.hovered ? "#2a2a2a" : "#1a1a1a")) : "#e5e7eb"
@@ -212,7 +213,7 @@ Rectangle {
                     onClicked: {
                         let code = root.otpFields.map(b => b.text).join("")
                         if (code.length === 6) {
-                            authController.verifyOtp(code)
+                            AuthController.verifyOtp(code)
                         }
                     }
                 }
@@ -228,9 +229,9 @@ Rectangle {
                     MouseArea {
                         anchors.fill: parent
                         cursorShape: resendTimer.running ? Qt.ArrowCursor : Qt.PointingHandCursor
-                        enabled: !resendTimer.running && (!authController || !authController.isLoading)
+                        enabled: !resendTimer.running && (!AuthController || !AuthController.isLoading)
                         onClicked: {
-                            authController.resendOtp()
+                            AuthController.resendOtp()
                             resendText.resendSeconds = 60
                             resendTimer.start()
                         }
@@ -259,7 +260,7 @@ Rectangle {
                         anchors.fill: parent
                         cursorShape: Qt.PointingHandCursor
                         onClicked: {
-                            authController.clearError()
+                            AuthController.clearError()
                             root.navigateBack()
                         }
                     }
@@ -287,9 +288,9 @@ Rectangle {
     }
 
     Connections {
-        target: authController
+        target: AuthController
         function onErrorMessageChanged() {
-            if (authController.errorMessage !== "") {
+            if (AuthController.errorMessage !== "") {
                 for (var i = 0; i < root.otpFields.length; i++) {
                     root.otpFields[i].text = ""
                 }
@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Item {
     id: root
@@ -9,7 +10,7 @@ Item {
     height: 44
 
     Component.onCompleted: {
-        notificationController.loadRecentNotifications()
+        NotificationController.loadRecentNotifications()
         refreshTimer.start()
     }
 
@@ -18,7 +19,7 @@ Item {
         interval: 30000
         running: false
         repeat: true
-        onTriggered: notificationController.loadRecentNotifications()
+        onTriggered: NotificationController.loadRecentNotifications()
     }
 
     Rectangle {
@@ -43,11 +44,11 @@ Item {
             height: 18
             radius: 9
             color: "#EF4444"
-            visible: notificationController.unreadCount > 0
+            visible: NotificationController.unreadCount > 0
 
             Text {
                 anchors.centerIn: parent
-                text: notificationController.unreadCount > 9 ? "9+" : notificationController.unreadCount.toString()
+                text: NotificationController.unreadCount > 9 ? "9+" : NotificationController.unreadCount.toString()
                 font.pixelSize: 9
                 font.weight: Font.Bold
                 color: "white"
@@ -119,7 +120,7 @@ Item {
                         width: markText.implicitWidth + 16
                         radius: 6
                         color: markMA.containsMouse ? "#EEF2FF" : "transparent"
-                        visible: notificationController.unreadCount > 0
+                        visible: NotificationController.unreadCount > 0
 
                         Text {
                             id: markText
@@ -134,7 +135,7 @@ Item {
                             anchors.fill: parent
                             hoverEnabled: true
                             cursorShape: Qt.PointingHandCursor
-                            onClicked: notificationController.markAllAsRead()
+                            onClicked: NotificationController.markAllAsRead()
                         }
                     }
                 }
@@ -158,7 +159,7 @@ Item {
                     spacing: 0
 
                     Repeater {
-                        model: notificationController.recentNotifications
+                        model: NotificationController.recentNotifications
 
                         Rectangle {
                             Layout.fillWidth: true
@@ -250,7 +251,7 @@ Item {
                                 cursorShape: Qt.PointingHandCursor
                                 onClicked: {
                                     if (!modelData.isRead) {
-                                        notificationController.markAsRead(modelData.id)
+                                        NotificationController.markAsRead(modelData.id)
                                     }
 
                                     if (modelData.actionUrl && modelData.actionUrl.length > 0) {
@@ -269,7 +270,7 @@ Item {
                 ColumnLayout {
                     anchors.centerIn: parent
                     spacing: 10
-                    visible: notificationController.recentNotifications.length === 0
+                    visible: NotificationController.recentNotifications.length === 0
 
                     Text {
                         Layout.alignment: Qt.AlignHCenter
@@ -1,12 +1,13 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Item {
     id: root
 
     Component.onCompleted: {
-        notificationController.loadNotifications()
+        NotificationController.loadNotifications()
     }
 
     Rectangle {
@@ -33,9 +34,9 @@ Item {
                     }
 
                     Text {
-                        text: notificationController.unreadCount > 0 ?
-                              notificationController.unreadCount + " unread notification" +
-                              (notificationController.unreadCount > 1 ? "s" : "") :
+                        text: NotificationController.unreadCount > 0 ?
+                              NotificationController.unreadCount + " unread notification" +
+                              (NotificationController.unreadCount > 1 ? "s" : "") :
                               "All caught up!"
                         font.pixelSize: 13
                         color: "#6B7280"
@@ -49,7 +50,7 @@ Item {
                     width: markAllText.implicitWidth + 24
                     radius: 6
                     color: markAllMA.containsMouse ? "#4F46E5" : "#6366F1"
-                    visible: notificationController.unreadCount > 0
+                    visible: NotificationController.unreadCount > 0
 
                     Text {
                         id: markAllText
@@ -64,8 +65,8 @@ Item {
                         anchors.fill: parent
                         hoverEnabled: true
                         cursorShape: Qt.PointingHandCursor
-                        enabled: !notificationController.isLoading
-                        onClicked: notificationController.markAllAsRead()
+                        enabled: !NotificationController.isLoading
+                        onClicked: NotificationController.markAllAsRead()
                     }
                 }
 
@@ -90,7 +91,7 @@ Item {
                         anchors.fill: parent
                         hoverEnabled: true
                         cursorShape: Qt.PointingHandCursor
-                        onClicked: notificationController.refresh()
+                        onClicked: NotificationController.refresh()
                     }
                 }
             }
@@ -113,7 +114,7 @@ Item {
                     Repeater {
                         model: [
                             { label: "All", value: "all" },
-                            { label: "Unread", value: "unread", count: notificationController.unreadCount },
+                            { label: "Unread", value: "unread", count: NotificationController.unreadCount },
                             { label: "Read", value: "read" }
                         ]
 
@@ -122,7 +123,7 @@ Item {
                             width: tabLabel.implicitWidth + 24
                             radius: 6
                             color: {
-                                var isActive = notificationController.currentFilter === modelData.value
+                                var isActive = NotificationController.currentFilter === modelData.value
                                 if (isActive) return "#6366F1"
                                 if (tabMA.containsMouse) return "#F3F4F6"
                                 return "transparent"
@@ -139,7 +140,7 @@ Item {
                                     return label
                                 }
                                 font.pixelSize: 13
-                                color: notificationController.currentFilter === modelData.value ? "white" : "#6B7280"
+                                color: NotificationController.currentFilter === modelData.value ? "white" : "#6B7280"
                             }
 
                             MouseArea {
@@ -147,7 +148,7 @@ Item {
                                 anchors.fill: parent
                                 hoverEnabled: true
                                 cursorShape: Qt.PointingHandCursor
-                                onClicked: notificationController.setFilter(modelData.value)
+                                onClicked: NotificationController.setFilter(modelData.value)
                             }
                         }
                     }
@@ -172,7 +173,7 @@ Item {
                     ColumnLayout {
                         anchors.centerIn: parent
                         spacing: 16
-                        visible: notificationController.isLoading
+                        visible: NotificationController.isLoading
 
                         Text {
                             Layout.alignment: Qt.AlignHCenter
@@ -192,7 +193,7 @@ Item {
                     ColumnLayout {
                         anchors.centerIn: parent
                         spacing: 12
-                        visible: !notificationController.isLoading && notificationController.notifications.length === 0
+                        visible: !NotificationController.isLoading && NotificationController.notifications.length === 0
 
                         Text {
                             Layout.alignment: Qt.AlignHCenter
@@ -203,9 +204,9 @@ Item {
                         Text {
                             Layout.alignment: Qt.AlignHCenter
                             text: {
-                                if (notificationController.currentFilter === "unread") {
+                                if (NotificationController.currentFilter === "unread") {
                                     return "No unread notifications"
-                                } else if (notificationController.currentFilter === "read") {
+                                } else if (NotificationController.currentFilter === "read") {
                                     return "No read notifications"
                                 } else {
                                     return "No notifications"
@@ -227,7 +228,7 @@ Item {
                     // Notifications ScrollView
                     ScrollView {
                         anchors.fill: parent
-                        visible: !notificationController.isLoading && notificationController.notifications.length > 0
+                        visible: !NotificationController.isLoading && NotificationController.notifications.length > 0
                         clip: true
 
                         ColumnLayout {
@@ -235,7 +236,7 @@ Item {
                             spacing: 0
 
                             Repeater {
-                                model: notificationController.notifications
+                                model: NotificationController.notifications
 
                                 Rectangle {
                                     Layout.fillWidth: true
@@ -341,7 +342,7 @@ Item {
                                         cursorShape: Qt.PointingHandCursor
                                         onClicked: {
                                             if (!modelData.isRead) {
-                                                notificationController.markAsRead(modelData.id)
+                                                NotificationController.markAsRead(modelData.id)
                                             }
 
                                             if (modelData.actionUrl && modelData.actionUrl.length > 0) {
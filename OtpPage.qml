@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Rectangle {
     id: root
@@ -27,7 +28,7 @@ Rectangle {
         otpFields[focusIdx].forceActiveFocus()
 
         if (digits.length >= 6) {
-            Qt.callLater(function() { authController.verifyOtp(digits.substring(0, 6)) })
+            Qt.callLater(function() { AuthController.verifyOtp(digits.substring(0, 6)) })
         }
     }
 
@@ -64,7 +65,7 @@ Rectangle {
                     }
                     Text {
                         text: "Enter the OTP to verify your login.\nA code has been sent to " +
-                              (authController ? authController.maskedEmail : "")
+                              (AuthController ? AuthController.maskedEmail : "")
                         color: "#6b7280"; font.pixelSize: 14
                         horizontalAlignment: Text.AlignHCenter
                         anchors.horizontalCenter: parent.horizontalCenter
@@ -74,10 +75,10 @@ Rectangle {
                 // Error banner
                 Rectangle {
                     width: parent.width; height: 52; radius: 8; color: "#FEE2E2"
-                    visible: authController && authController.errorMessage !== ""
+                    visible: AuthController && AuthController.errorMessage !== ""
                     anchors.horizontalCenter: parent.horizontalCenter
                     Text {
-                        text: authController ? authController.errorMessage : ""
+                        text: AuthController ? AuthController.errorMessage : ""
                         color: "#DC2626"; font.pixelSize: 14
                         anchors.centerIn: parent; width: parent.width - 32
                         wrapMode: Text.WordWrap; horizontalAlignment: Text.AlignHCenter
@@ -105,7 +106,7 @@ Rectangle {
                                 horizontalAlignment: TextInput.AlignHCenter
                                 verticalAlignment: TextInput.AlignVCenter
                                 color: "#1a1a1a"
-                                enabled: !authController || !authController.isLoading
+                                enabled: !AuthController || !AuthController.isLoading
                                 validator: RegularExpressionValidator { regularExpression: /[0-9]*/ }
                                 background: Rectangle { color: "transparent" }
 
@@ -125,7 +126,7 @@ Rectangle {
                                             root.otpFields[index + 1].forceActiveFocus()
                                         } else {
                                             var code = root.fullCode()
-                                            if (code.length === 6) authController.verifyOtp(code)
+                                            if (code.length === 6) AuthController.verifyOtp(code)
                                         }
                                     } else {
                                         // Paste: multiple chars landed in this field
@@ -154,9 +155,9 @@ Rectangle {
 
                 // Verify button
                 Button {
-                    text: (authController && authController.isLoading) ? "Verifying..." : "Verify"
+                    text: (AuthController && AuthController.isLoading) ? "Verifying..." : "Verify"
                     width: parent.width; height: 52
-                    enabled: !authController || !authController.isLoading
+                    enabled: !AuthController || !AuthController.isLoading
                     background: Rectangle {
                         radius: 8
                         color: parent.enabled ? (parent.pressed ? "#0f0f0f" : (parent.hovered ? "#2a2a2a" : "#1a1a1a")) : "#e5e7eb"
@@ -169,14 +170,14 @@ Rectangle {
                     }
                     onClicked: {
                         var code = root.fullCode()
-                        if (code.length === 6) authController.verifyOtp(code)
+                        if (code.length === 6) AuthController.verifyOtp(code)
                     }
                 }
 
                 // Loading spinner (Issue 3)
                 BusyIndicator {
                     anchors.horizontalCenter: parent.horizontalCenter
-                    running: authController && authController.isLoading
+                    running: AuthController && AuthController.isLoading
                     visible: running
                     width: 40; height: 40
                 }
@@ -192,8 +193,8 @@ Rectangle {
                     MouseArea {
                         anchors.fill: parent
                         cursorShape: resendTimer.running ? Qt.ArrowCursor : Qt.PointingHandCursor
-                        enabled: !resendTimer.running && (!authController || !authController.isLoading)
-                        onClicked: { authController.resendOtp(); resendText.resendSeconds = 60; resendTimer.start() }
+                        enabled: !resendTimer.running && (!AuthController || !AuthController.isLoading)
+                        onClicked: { AuthController.resendOtp(); resendText.resendSeconds = 60; resendTimer.start() }
                     }
                     Timer {
                         id: resendTimer
@@ -209,7 +210,7 @@ Rectangle {
                     anchors.horizontalCenter: parent.horizontalCenter
                     MouseArea {
                         anchors.fill: parent; cursorShape: Qt.PointingHandCursor
-                        onClicked: { authController.clearError(); root.navigateBack() }
+                        onClicked: { AuthController.clearError(); root.navigateBack() }
                     }
                 }
             }
@@ -233,9 +234,9 @@ Rectangle {
 
     // Clear all fields and refocus on any error
     Connections {
-        target: authController
+        target: AuthController
         function onErrorMessageChanged() {
-            if (authController.errorMessage !== "") {
+            if (AuthController.errorMessage !== "") {
                 root.handlingPaste = true
                 for (var i = 0; i < root.otpFields.length; i++) root.otpFields[i].text = ""
                 root.handlingPaste = false
@@ -0,0 +1,42 @@
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+
+// Hosts one admin page inside DashboardPage's StackLayout.
+// The page is created (asynchronously) the first time it becomes the
+// current view, so it only starts its network work once it is opened.
+// With unloadAfter > 0 it is destroyed again after being hidden that long.
+Loader {
+    id: loader
+
+    property bool current: false
+    property int unloadAfter: 0     // ms, 0 = keep the page once created
+    property bool visited: false
+
+    asynchronous: true
+    active: visited
+
+    onCurrentChanged: {
+        if (current) {
+            unloadTimer.stop()
+            visited = true
+        } else if (visited && unloadAfter > 0) {
+            unloadTimer.restart()
+        }
+    }
+
+    Component.onCompleted: {
+        if (current) visited = true
+    }
+
+    Timer {
+        id: unloadTimer
+        interval: loader.unloadAfter
+        onTriggered: loader.visited = false
+    }
+
+    BusyIndicator {
+        anchors.centerIn: parent
+        running: loader.status === Loader.Loading
+        visible: running
+    }
+}
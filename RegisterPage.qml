@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Rectangle {
     id: root
@@ -60,9 +61,9 @@ Rectangle {
                         height: 52
                         radius: 8
                         color: "#FEE2E2"
-                        visible: authController && authController.errorMessage !== ""
+                        visible: AuthController && AuthController.errorMessage !== ""
                         Text {
-                            text: authController ? authController.errorMessage : ""
+                            text: AuthController ? AuthController.errorMessage : ""
                             color: "#DC2626"
                             font.pixelSize: 14
                             anchors.centerIn: parent
@@ -92,7 +93,7 @@ Rectangle {
                                 width: parent.width
                                 height: 52
                                 leftPadding: 16
-                                enabled: !authController || !authController.isLoading
+                                enabled: !AuthController || !AuthController.isLoading
                                 background: Rectangle {
                                     radius: 8
                                     color: "#ffffff"
@@ -119,7 +120,7 @@ Rectangle {
                                 width: parent.width
                                 height: 52
                                 leftPadding: 16
-                                enabled: !authController || !authController.isLoading
+                                enabled: !AuthController || !AuthController.isLoading
                                 background: Rectangle {
                                     radius: 8
                                     color: "#ffffff"
@@ -146,7 +147,7 @@ Rectangle {
                                 width: parent.width
                                 height: 52
                                 leftPadding: 16
-                                enabled: !authController || !authController.isLoading
+                                enabled: !AuthController || !AuthController.isLoading
                                 background: Rectangle {
                                     radius: 8
                                     color: "#ffffff"
@@ -174,7 +175,7 @@ Rectangle {
                                 height: 52
                                 leftPadding: 16
                                 echoMode: TextInput.Password
-                                enabled: !authController || !authController.isLoading
+                                enabled: !AuthController || !AuthController.isLoading
                                 background: Rectangle {
                                     radius: 8
                                     color: "#ffffff"
@@ -186,7 +187,7 @@ Rectangle {
                                         regLastName.text.trim().length >= 2 &&
                                         regEmail.text.includes("@") &&
                                         regPassword.text.length >= 8) {
-                                        authController.registerUser(
+                                        AuthController.registerUser(
                                             regFirstName.text.trim(),
                                             regLastName.text.trim(),
                                             regEmail.text.trim(),
@@ -198,10 +199,10 @@ Rectangle {
                         }
 
                         Button {
-                            text: (authController && authController.isLoading) ? "Creating Account..." : "Create Account"
+                            text: (AuthController && AuthController.isLoading) ? "Creating Account..." : "Create Account"
                             width: parent.width
                             height: 52
-                            enabled: (!authController || !authController.isLoading) &&
+                            enabled: (!AuthController || !AuthController.isLoading) &&
                                      regFirstName.text.trim().length >= 2 &&
                                      regLastName.text.trim().length >= 2 &&
                                      regEmail.text.includes("@") &&
@@ -219,7 +220,7 @@ Rectangle {
                                 verticalAlignment: Text.AlignVCenter
                             }
                             onClicked: {
-                                authController.registerUser(
+                                AuthController.registerUser(
                                     regFirstName.text.trim(),
                                     regLastName.text.trim(),
                                     regEmail.text.trim(),
@@ -244,7 +245,7 @@ Rectangle {
                                     anchors.fill: parent
                                     cursorShape: Qt.PointingHandCursor
                                     onClicked: {
-                                        authController.clearError()
+                                        AuthController.clearError()
                                         root.navigateBack()
                                     }
                                 }
@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Item {
     id: root
@@ -19,8 +20,8 @@ Item {
     function fetchCourse() {
         isLoading = true
         var xhr = new XMLHttpRequest()
-        xhr.open("GET", "https://learning-dashboard-rouge.vercel.app/api/courses/" + courseId)
-        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
+        xhr.open("GET", AuthController.apiBaseUrl + "/api/courses/" + courseId)
+        xhr.setRequestHeader("Authorization", "Bearer " + (AuthController ? AuthController.accessToken : ""))
         xhr.setRequestHeader("Accept", "application/json")
         xhr.onreadystatechange = function() {
             if (xhr.readyState !== XMLHttpRequest.DONE) return
@@ -42,8 +43,8 @@ Item {
     function approveCourse() {
         isActing = true
         var xhr = new XMLHttpRequest()
-        xhr.open("PUT", "https://learning-dashboard-rouge.vercel.app/api/courses/" + courseId + "/status")
-        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
+        xhr.open("PUT", AuthController.apiBaseUrl + "/api/courses/" + courseId + "/status")
+        xhr.setRequestHeader("Authorization", "Bearer " + (AuthController ? AuthController.accessToken : ""))
         xhr.setRequestHeader("Content-Type", "application/json")
         xhr.setRequestHeader("Accept", "application/json")
         xhr.onreadystatechange = function() {
@@ -68,8 +69,8 @@ Item {
         if (reason.length < 10) { showError("Please provide a rejection reason (min 10 characters)"); return }
         isActing = true
         var xhr = new XMLHttpRequest()
-        xhr.open("PUT", "https://learning-dashboard-rouge.vercel.app/api/courses/" + courseId + "/status")
-        xhr.setRequestHeader("Authorization", "Bearer " + (authController ? authController.accessToken : ""))
+        xhr.open("PUT", AuthController.apiBaseUrl + "/api/courses/" + courseId + "/status")
+        xhr.setRequestHeader("Authorization", "Bearer " + (AuthController ? AuthController.accessToken : ""))
         xhr.setRequestHeader("Content-Type", "application/json")
         xhr.setRequestHeader("Accept", "application/json")
         xhr.onreadystatechange = function() {
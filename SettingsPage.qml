@@ -1,11 +1,13 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import QtQuick.Dialogs
+import Lumin 1.0
 
 Item {
     id: root
 
-    // Local form state — synced from authController on load
+    // Local form state — synced from AuthController on load
     property string firstName: ""
     property string lastName: ""
     property string email: ""
@@ -17,19 +19,29 @@ Item {
 
     // Sync fields whenever the user object changes
     function syncFromController() {
-        var parts = (authController ? authController.userName || "" : "").split(" ")
+        var parts = (AuthController ? AuthController.userName || "" : "").split(" ")
         firstName = parts[0] || ""
         lastName  = parts.length > 1 ? parts.slice(1).join(" ") : ""
-        email     = authController ? authController.userEmail || "" : ""
+        email     = AuthController ? AuthController.userEmail || "" : ""
         firstNameField.text = firstName
         lastNameField.text  = lastName
         emailField.text     = email
     }
 
-    Component.onCompleted: syncFromController()
+    Component.onCompleted: {
+        syncFromController()
+        DiagnosticsController.refresh()
+        DiagnosticsController.refreshMemory()
+    }
+
+    function formatBytes(bytes) {
+        if (bytes === undefined || bytes < 0) return "n/a"
+        if (bytes < 1024 * 1024) return (bytes / 1024).toFixed(0) + " KiB"
+        return (bytes / (1024 * 1024)).toFixed(1) + " MiB"
+    }
 
     Connections {
-        target: authController
+        target: AuthController
         function onUserNameChanged()  { root.syncFromController() }
         function onUserEmailChanged() { root.syncFromController() }
         // Profile saved successfully
@@ -37,6 +49,10 @@ Item {
             root.successMessage = "Profile updated successfully!"
             msgTimer.restart()
         }
+        function onProfileImageUploaded() {
+            root.successMessage = "Profile photo updated!"
+            msgTimer.restart()
+        }
         // Password changed successfully
         function onPasswordChanged() {
             root.successMessage = "Password updated successfully!"
@@ -44,10 +60,10 @@ Item {
             currentPwField.text = ""; newPwField.text = ""; confirmPwField.text = ""
             msgTimer.restart()
         }
-        // Any error from authController
+        // Any error from AuthController
         function onErrorMessageChanged() {
-            if (authController.errorMessage !== "") {
-                root.errorMessage = authController.errorMessage
+            if (AuthController.errorMessage !== "") {
+                root.errorMessage = AuthController.errorMessage
                 msgTimer.restart()
             }
         }
@@ -112,17 +128,61 @@ Item {
                         // Avatar row
                         RowLayout { Layout.fillWidth: true; spacing: 20
                             Rectangle {
-                                width: 80; height: 80; radius: 40; color: "#EEF2FF"
+                                width: 80; height: 80; radius: 40; color: "#EEF2FF"; clip: true
+                                Image {
+                                    id: avatarImage
+                                    anchors.fill: parent
+                                    source: AuthController.userImage ? "image://remote/" + encodeURIComponent(AuthController.userImage) : ""
+                                    sourceSize: Qt.size(160, 160)
+                                    asynchronous: true
+                                    fillMode: Image.PreserveAspectCrop
+                                    visible: status === Image.Ready
+                                }
                                 Text {
                                     anchors.centerIn: parent
                                     text: root.firstName ? root.firstName.charAt(0).toUpperCase() : "U"
                                     font.pixelSize: 32; font.weight: Font.Medium; color: "#4F46E5"
+                                    visible: !avatarImage.visible
                                 }
                             }
                             ColumnLayout { Layout.fillWidth: true; spacing: 4
                                 Text { text: root.firstName + " " + root.lastName; font.pixelSize: 16; font.weight: Font.DemiBold; color: "#18181B" }
                                 Text { text: root.email; font.pixelSize: 13; color: "#6B7280" }
+                                // Upload progress (the image is downscaled before sending)
+                                RowLayout { Layout.fillWidth: true; spacing: 8; visible: AuthController.isUploadingImage
+                                    ProgressBar {
+                                        Layout.preferredWidth: 160
+                                        from: 0; to: 1
+                                        value: AuthController.uploadProgress
+                                        indeterminate: AuthController.uploadProgress <= 0
+                                    }
+                                    Text {
+                                        text: AuthController.uploadProgress > 0 ? "Uploading " + Math.round(AuthController.uploadProgress * 100) + "%" : "Preparing image…"
+                                        font.pixelSize: 12; color: "#6B7280"
+                                    }
+                                }
                             }
+                            Rectangle {
+                                height: 36; width: photoText.implicitWidth + 24; radius: 6
+                                color: photoMA.containsMouse ? "#F3F4F6" : "white"
+                                border.color: "#E5E7EB"; border.width: 1
+                                opacity: AuthController.isUploadingImage ? 0.5 : 1
+                                Text { id: photoText; anchors.centerIn: parent; text: "Change Photo"; font.pixelSize: 13; color: "#374151" }
+                                MouseArea {
+                                    id: photoMA
+                                    anchors.fill: parent; hoverEnabled: true
+                                    cursorShape: Qt.PointingHandCursor
+                                    enabled: !AuthController.isUploadingImage
+                                    onClicked: photoDialog.open()
+                                }
+                            }
+                        }
+
+                        FileDialog {
+                            id: photoDialog
+                            title: "Choose a profile photo"
+                            nameFilters: ["Images (*.png *.jpg *.jpeg *.webp *.heic *.bmp)"]
+                            onAccepted: AuthController.uploadProfileImage(selectedFile)
                         }
 
                         // Name fields
@@ -134,7 +194,7 @@ Item {
                                     Layout.fillWidth: true; Layout.preferredHeight: 40
                                     text: root.firstName; selectByMouse: true
                                     leftPadding: 12; rightPadding: 12
-                                    enabled: !authController || !authController.isLoading
+                                    enabled: !AuthController || !AuthController.isLoading
                                     background: Rectangle { radius: 6; color: "white"
                                         border.color: parent.activeFocus ? "#4F46E5" : "#E5E7EB"
                                         border.width: parent.activeFocus ? 2 : 1 }
@@ -148,7 +208,7 @@ Item {
                                     Layout.fillWidth: true; Layout.preferredHeight: 40
                                     text: root.lastName; selectByMouse: true
                                     leftPadding: 12; rightPadding: 12
-                                    enabled: !authController || !authController.isLoading
+                                    enabled: !AuthController || !AuthController.isLoading
                                     background: Rectangle { radius: 6; color: "white"
                                         border.color: parent.activeFocus ? "#4F46E5" : "#E5E7EB"
                                         border.width: parent.activeFocus ? 2 : 1 }
@@ -176,20 +236,20 @@ Item {
                             Rectangle {
                                 height: 40; width: saveTxt.implicitWidth + 40; radius: 6
                                 color: saveMA.containsMouse ? "#4338CA" : "#4F46E5"
-                                enabled: !authController || !authController.isLoading
+                                enabled: !AuthController || !AuthController.isLoading
                                 opacity: enabled ? 1.0 : 0.6
                                 Text { id: saveTxt; anchors.centerIn: parent; text: "Save Changes"; font.pixelSize: 14; font.weight: Font.Medium; color: "white" }
                                 MouseArea {
                                     id: saveMA; anchors.fill: parent; hoverEnabled: true; cursorShape: Qt.PointingHandCursor
-                                    enabled: !authController || !authController.isLoading
+                                    enabled: !AuthController || !AuthController.isLoading
                                     onClicked: {
                                         root.successMessage = ""; root.errorMessage = ""
-                                        authController.updateProfile(root.firstName, root.lastName)
+                                        AuthController.updateProfile(root.firstName, root.lastName)
                                     }
                                 }
                             }
                             BusyIndicator {
-                                running: authController && authController.isLoading
+                                running: AuthController && AuthController.isLoading
                                 visible: running; width: 28; height: 28
                             }
                         }
@@ -219,7 +279,7 @@ Item {
                                 Layout.fillWidth: true; Layout.preferredHeight: 40
                                 echoMode: TextField.Password; selectByMouse: true
                                 leftPadding: 12; rightPadding: 12; placeholderText: "Enter current password"
-                                enabled: !authController || !authController.isLoading
+                                enabled: !AuthController || !AuthController.isLoading
                                 background: Rectangle { radius: 6; color: "white"
                                     border.color: parent.activeFocus ? "#4F46E5" : "#E5E7EB"
                                     border.width: parent.activeFocus ? 2 : 1 }
@@ -233,7 +293,7 @@ Item {
                                 Layout.fillWidth: true; Layout.preferredHeight: 40
                                 echoMode: TextField.Password; selectByMouse: true
                                 leftPadding: 12; rightPadding: 12; placeholderText: "Enter new password (min 8 chars)"
-                                enabled: !authController || !authController.isLoading
+                                enabled: !AuthController || !AuthController.isLoading
                                 background: Rectangle { radius: 6; color: "white"
                                     border.color: parent.activeFocus ? "#4F46E5" : "#E5E7EB"
                                     border.width: parent.activeFocus ? 2 : 1 }
@@ -247,7 +307,7 @@ Item {
                                 Layout.fillWidth: true; Layout.preferredHeight: 40
                                 echoMode: TextField.Password; selectByMouse: true
                                 leftPadding: 12; rightPadding: 12; placeholderText: "Confirm new password"
-                                enabled: !authController || !authController.isLoading
+                                enabled: !AuthController || !AuthController.isLoading
                                 background: Rectangle { radius: 6; color: "white"
                                     border.color: parent.activeFocus ? "#4F46E5" : "#E5E7EB"
                                     border.width: parent.activeFocus ? 2 : 1 }
@@ -260,12 +320,12 @@ Item {
                             Rectangle {
                                 height: 40; width: upTxt.implicitWidth + 40; radius: 6
                                 color: upMA.containsMouse ? "#4338CA" : "#4F46E5"
-                                enabled: !authController || !authController.isLoading
+                                enabled: !AuthController || !AuthController.isLoading
                                 opacity: enabled ? 1.0 : 0.6
                                 Text { id: upTxt; anchors.centerIn: parent; text: "Update Password"; font.pixelSize: 14; font.weight: Font.Medium; color: "white" }
                                 MouseArea {
                                     id: upMA; anchors.fill: parent; hoverEnabled: true; cursorShape: Qt.PointingHandCursor
-                                    enabled: !authController || !authController.isLoading
+                                    enabled: !AuthController || !AuthController.isLoading
                                     onClicked: {
                                         root.successMessage = ""; root.errorMessage = ""
                                         if (root.currentPassword.length === 0) {
@@ -277,18 +337,134 @@ Item {
                                         if (root.newPassword !== root.confirmPassword) {
                                             root.errorMessage = "Passwords do not match"; msgTimer.restart(); return
                                         }
-                                        authController.changePassword(root.currentPassword, root.newPassword)
+                                        AuthController.changePassword(root.currentPassword, root.newPassword)
                                     }
                                 }
                             }
                             BusyIndicator {
-                                running: authController && authController.isLoading
+                                running: AuthController && AuthController.isLoading
                                 visible: running; width: 28; height: 28
                             }
                         }
                     }
                 }
 
+                // ── Diagnostics ─────────────────────────────────────────────
+                Rectangle {
+                    Layout.fillWidth: true; radius: 10; color: "white"
+                    border.color: "#E5E7EB"; border.width: 1
+                    height: diagnosticsCol.implicitHeight + 48
+
+                    ColumnLayout {
+                        id: diagnosticsCol
+                        anchors.fill: parent; anchors.margins: 24; spacing: 16
+
+                        RowLayout { Layout.fillWidth: true; spacing: 12
+                            ColumnLayout { Layout.fillWidth: true; spacing: 4
+                                Text { text: "Diagnostics"; font.pixelSize: 18; font.weight: Font.DemiBold; color: "#18181B" }
+                                Text {
+                                    text: "API latency per endpoint since launch (" + DiagnosticsController.totalResponses + " responses)"
+                                    font.pixelSize: 13; color: "#9CA3AF"
+                                }
+                            }
+                            Button { text: "Refresh"; flat: true; onClicked: DiagnosticsController.refresh() }
+                            Button {
+                                text: "Save Report"; flat: true
+                                onClicked: {
+                                    if (DiagnosticsController.dumpNow()) {
+                                        root.successMessage = "Saved to " + DiagnosticsController.dumpPath
+                                    } else {
+                                        root.errorMessage = "Could not write " + DiagnosticsController.dumpPath
+                                    }
+                                    msgTimer.restart()
+                                }
+                            }
+                            Button {
+                                text: FrameMonitor.overlayVisible ? "Hide Frame Overlay" : "Frame Overlay"; flat: true
+                                onClicked: FrameMonitor.overlayVisible = !FrameMonitor.overlayVisible
+                            }
+                            Button {
+                                text: "Export HAR (15 min)"; flat: true
+                                onClicked: {
+                                    var path = DiagnosticsController.exportHar(15)
+                                    if (path !== "") {
+                                        root.successMessage = "Saved to " + path
+                                    } else {
+                                        root.errorMessage = "Could not export the network trace"
+                                    }
+                                    msgTimer.restart()
+                                }
+                            }
+                        }
+                        Rectangle { Layout.fillWidth: true; height: 1; color: "#F3F4F6" }
+
+                        RowLayout { Layout.fillWidth: true; spacing: 12
+                            Text { text: "Endpoint"; Layout.fillWidth: true; font.pixelSize: 12; font.weight: Font.Medium; color: "#6B7280" }
+                            Text { text: "Calls"; Layout.preferredWidth: 50; font.pixelSize: 12; font.weight: Font.Medium; color: "#6B7280" }
+                            Text { text: "p50 / p95 / p99 ms"; Layout.preferredWidth: 140; font.pixelSize: 12; font.weight: Font.Medium; color: "#6B7280" }
+                            Text { text: "Errors"; Layout.preferredWidth: 50; font.pixelSize: 12; font.weight: Font.Medium; color: "#6B7280" }
+                        }
+
+                        Repeater {
+                            model: DiagnosticsController.endpoints
+                            delegate: RowLayout {
+                                required property var modelData
+                                Layout.fillWidth: true; spacing: 12
+                                Text { text: modelData.endpoint; Layout.fillWidth: true; elide: Text.ElideMiddle; font.pixelSize: 12; font.family: "monospace"; color: "#374151" }
+                                Text { text: modelData.responses; Layout.preferredWidth: 50; font.pixelSize: 12; color: "#374151" }
+                                Text { text: modelData.p50 + " / " + modelData.p95 + " / " + modelData.p99; Layout.preferredWidth: 140; font.pixelSize: 12; color: "#374151" }
+                                Text { text: modelData.errors; Layout.preferredWidth: 50; font.pixelSize: 12; color: modelData.errors > 0 ? "#DC2626" : "#374151" }
+                            }
+                        }
+
+                        Text {
+                            visible: DiagnosticsController.endpoints.length === 0
+                            text: "No API requests recorded yet"
+                            font.pixelSize: 12; color: "#9CA3AF"
+                        }
+
+                        // Memory: approximate bytes per model and cache
+                        Rectangle { Layout.fillWidth: true; height: 1; color: "#F3F4F6" }
+
+                        RowLayout { Layout.fillWidth: true; spacing: 12
+                            Text {
+                                Layout.fillWidth: true
+                                text: "Memory: " + root.formatBytes(DiagnosticsController.memory.residentBytes) + " resident, models ~"
+                                      + root.formatBytes(DiagnosticsController.memory.modelBytes) + ", caches ~"
+                                      + root.formatBytes(DiagnosticsController.memory.cacheBytes)
+                                font.pixelSize: 13; font.weight: Font.Medium; color: "#374151"
+                            }
+                            Button { text: "Measure"; flat: true; onClicked: DiagnosticsController.refreshMemory() }
+                            Button {
+                                text: "Trim Caches"; flat: true
+                                onClicked: {
+                                    var result = DiagnosticsController.trimCaches()
+                                    root.successMessage = "Released " + root.formatBytes(result.releasedBytes)
+                                    msgTimer.restart()
+                                }
+                            }
+                        }
+
+                        Repeater {
+                            model: (DiagnosticsController.memory.models || []).concat(DiagnosticsController.memory.caches || [])
+                            delegate: RowLayout {
+                                required property var modelData
+                                Layout.fillWidth: true; spacing: 12
+                                Text { text: modelData.name; Layout.fillWidth: true; elide: Text.ElideMiddle; font.pixelSize: 12; font.family: "monospace"; color: "#374151" }
+                                Text {
+                                    text: modelData.rows !== undefined ? modelData.rows + " rows" : modelData.entries + " entries"
+                                    Layout.preferredWidth: 90; font.pixelSize: 12; color: "#374151"
+                                }
+                                Text {
+                                    text: "~" + root.formatBytes(modelData.bytes)
+                                          + (modelData.limitBytes ? " / " + root.formatBytes(modelData.limitBytes) : "")
+                                    Layout.preferredWidth: 140; font.pixelSize: 12; color: "#374151"
+                                }
+                            }
+                        }
+                    }
+                }
+
                 Item { height: 24 }
             }
         }
@@ -57,6 +57,17 @@ Rectangle {
                 height: 40
                 radius: 20
                 color: Material.color(Material.Blue, Material.Shade100)
+                clip: true
+
+                Image {
+                    id: studentAvatar
+                    anchors.fill: parent
+                    source: transaction.studentImage ? "image://remote/" + encodeURIComponent(transaction.studentImage) : ""
+                    sourceSize: Qt.size(80, 80)
+                    asynchronous: true
+                    fillMode: Image.PreserveAspectCrop
+                    visible: status === Image.Ready
+                }
 
                 Label {
                     anchors.centerIn: parent
@@ -64,6 +75,7 @@ Rectangle {
                     font.pixelSize: 16
                     font.weight: Font.Medium
                     color: Material.color(Material.Blue)
+                    visible: !studentAvatar.visible
                 }
             }
 
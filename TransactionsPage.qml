@@ -1,12 +1,14 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Item {
     id: root
 
     Component.onCompleted: {
-        transactionController.loadTransactions()
+        TransactionController.loadTransactions()
+        RevenueController.load()
     }
 
     Rectangle {
@@ -31,6 +33,22 @@ Item {
 
                 Item { Layout.fillWidth: true }
 
+                ExportButton {
+                    id: exportButton
+                    exporting: TransactionController.isExporting
+                    progress: TransactionController.exportProgress
+                    rows: TransactionController.exportedRows
+                    onExportRequested: function(fileUrl) { TransactionController.exportTransactions(fileUrl) }
+                    onCancelRequested: TransactionController.cancelExport()
+
+                    Connections {
+                        target: TransactionController
+                        function onExportFinished(success, message) {
+                            exportButton.showResult(success, message)
+                        }
+                    }
+                }
+
                 Rectangle {
                     height: 36
                     width: refreshText.implicitWidth + 24
@@ -52,7 +70,7 @@ Item {
                         anchors.fill: parent
                         hoverEnabled: true
                         cursorShape: Qt.PointingHandCursor
-                        onClicked: transactionController.refresh()
+                        onClicked: TransactionController.refresh()
                     }
                 }
             }
@@ -64,9 +82,9 @@ Item {
 
                 Repeater {
                     model: [
-                        { title: "Total Revenue", icon: "💰", bg: "#DCFCE7", val: transactionController.formattedTotalRevenue },
-                        { title: "This Month", icon: "📊", bg: "#EEF2FF", val: transactionController.formattedThisMonthRevenue },
-                        { title: "Total Transactions", icon: "📝", bg: "#FCE7F3", val: transactionController.totalTransactions.toString() }
+                        { title: "Total Revenue", icon: "💰", bg: "#DCFCE7", val: TransactionController.formattedTotalRevenue },
+                        { title: "This Month", icon: "📊", bg: "#EEF2FF", val: TransactionController.formattedThisMonthRevenue },
+                        { title: "Total Transactions", icon: "📝", bg: "#FCE7F3", val: TransactionController.totalTransactions.toString() }
                     ]
 
                     Rectangle {
@@ -122,6 +140,62 @@ Item {
                 }
             }
 
+            // Revenue Trend
+            Rectangle {
+                Layout.fillWidth: true
+                Layout.preferredHeight: 180
+                radius: 10
+                color: "white"
+                border.color: "#E5E7EB"
+                border.width: 1
+                visible: RevenueController.hasData
+
+                ColumnLayout {
+                    anchors.fill: parent
+                    anchors.margins: 18
+                    spacing: 8
+
+                    RowLayout {
+                        Layout.fillWidth: true
+
+                        Text {
+                            text: "Revenue, last " + RevenueController.rangeDays + " days"
+                            font.pixelSize: 13
+                            font.weight: Font.Medium
+                            color: "#18181B"
+                        }
+
+                        Item { Layout.fillWidth: true }
+
+                        Text {
+                            text: trendMA.index >= 0 ?
+                                      RevenueController.points[trendMA.index].label + ": " +
+                                      RevenueController.points[trendMA.index].formattedAmount :
+                                      RevenueController.formattedTotal
+                            font.pixelSize: 13
+                            color: "#6B7280"
+                        }
+                    }
+
+                    ChartItem {
+                        id: trendChart
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        type: ChartItem.Area
+                        color: "#10B981"
+                        values: RevenueController.values
+                        maxValue: RevenueController.maxValue
+
+                        MouseArea {
+                            id: trendMA
+                            anchors.fill: parent
+                            hoverEnabled: true
+                            property int index: containsMouse ? trendChart.indexAt(mouseX) : -1
+                        }
+                    }
+                }
+            }
+
             // Filter Section
             Rectangle {
                 Layout.fillWidth: true
@@ -168,7 +242,7 @@ Item {
                             Timer {
                                 id: searchTimer
                                 interval: 500
-                                onTriggered: transactionController.setSearchQuery(searchInput.text)
+                                onTriggered: TransactionController.setSearchQuery(searchInput.text)
                             }
                         }
                     }
@@ -216,28 +290,28 @@ Item {
                                 text: "All"
                                 onTriggered: {
                                     statusCombo.currentText = "All"
-                                    transactionController.setStatusFilter("all")
+                                    TransactionController.setStatusFilter("all")
                                 }
                             }
                             MenuItem {
                                 text: "Completed"
                                 onTriggered: {
                                     statusCombo.currentText = "Completed"
-                                    transactionController.setStatusFilter("completed")
+                                    TransactionController.setStatusFilter("completed")
                                 }
                             }
                             MenuItem {
                                 text: "Failed"
                                 onTriggered: {
                                     statusCombo.currentText = "Failed"
-                                    transactionController.setStatusFilter("failed")
+                                    TransactionController.setStatusFilter("failed")
                                 }
                             }
                             MenuItem {
                                 text: "Refunded"
                                 onTriggered: {
                                     statusCombo.currentText = "Refunded"
-                                    transactionController.setStatusFilter("refunded")
+                                    TransactionController.setStatusFilter("refunded")
                                 }
                             }
                         }
@@ -272,7 +346,7 @@ Item {
                             cursorShape: Qt.PointingHandCursor
                             onClicked: {
                                 searchInput.text = ""
-                                transactionController.setSearchQuery("")
+                                TransactionController.setSearchQuery("")
                             }
                         }
                     }
@@ -370,7 +444,7 @@ Item {
                         ColumnLayout {
                             anchors.centerIn: parent
                             spacing: 16
-                            visible: transactionController.isLoading
+                            visible: TransactionController.isLoading
 
                             Text {
                                 Layout.alignment: Qt.AlignHCenter
@@ -390,7 +464,7 @@ Item {
                         ColumnLayout {
                             anchors.centerIn: parent
                             spacing: 12
-                            visible: !transactionController.isLoading && transactionController.transactions.length === 0
+                            visible: !TransactionController.isLoading && TransactionController.transactions.length === 0
 
                             Text {
                                 Layout.alignment: Qt.AlignHCenter
@@ -417,7 +491,7 @@ Item {
                         // Transactions List
                         ScrollView {
                             anchors.fill: parent
-                            visible: !transactionController.isLoading && transactionController.transactions.length > 0
+                            visible: !TransactionController.isLoading && TransactionController.transactions.length > 0
                             clip: true
 
                             ColumnLayout {
@@ -425,7 +499,7 @@ Item {
                                 spacing: 0
 
                                 Repeater {
-                                    model: transactionController.transactions
+                                    model: TransactionController.transactions
 
                                     Rectangle {
                                         Layout.fillWidth: true
@@ -612,7 +686,7 @@ Item {
                         Layout.fillWidth: true
                         height: 56
                         color: "#F9FAFB"
-                        visible: transactionController.totalPages > 1
+                        visible: TransactionController.totalPages > 1
 
                         Rectangle {
                             anchors.top: parent.top
@@ -628,8 +702,8 @@ Item {
                             spacing: 12
 
                             Text {
-                                text: "Page " + transactionController.currentPage +
-                                      " of " + transactionController.totalPages
+                                text: "Page " + TransactionController.currentPage +
+                                      " of " + TransactionController.totalPages
                                 font.pixelSize: 13
                                 color: "#6B7280"
                             }
@@ -641,7 +715,7 @@ Item {
                                 width: prevText.implicitWidth + 24
                                 radius: 6
                                 color: {
-                                    if (transactionController.currentPage <= 1) return "#F3F4F6"
+                                    if (TransactionController.currentPage <= 1) return "#F3F4F6"
                                     if (prevMA.containsMouse) return "#EEF2FF"
                                     return "white"
                                 }
@@ -653,16 +727,16 @@ Item {
                                     anchors.centerIn: parent
                                     text: "← Previous"
                                     font.pixelSize: 13
-                                    color: transactionController.currentPage > 1 ? "#6366F1" : "#9CA3AF"
+                                    color: TransactionController.currentPage > 1 ? "#6366F1" : "#9CA3AF"
                                 }
 
                                 MouseArea {
                                     id: prevMA
                                     anchors.fill: parent
-                                    enabled: transactionController.currentPage > 1
+                                    enabled: TransactionController.currentPage > 1
                                     hoverEnabled: true
                                     cursorShape: enabled ? Qt.PointingHandCursor : Qt.ArrowCursor
-                                    onClicked: transactionController.previousPage()
+                                    onClicked: TransactionController.previousPage()
                                 }
                             }
 
@@ -671,7 +745,7 @@ Item {
                                 width: nextText.implicitWidth + 24
                                 radius: 6
                                 color: {
-                                    if (transactionController.currentPage >= transactionController.totalPages) return "#F3F4F6"
+                                    if (TransactionController.currentPage >= TransactionController.totalPages) return "#F3F4F6"
                                     if (nextMA.containsMouse) return "#EEF2FF"
                                     return "white"
                                 }
@@ -683,16 +757,16 @@ Item {
                                     anchors.centerIn: parent
                                     text: "Next →"
                                     font.pixelSize: 13
-                                    color: transactionController.currentPage < transactionController.totalPages ? "#6366F1" : "#9CA3AF"
+                                    color: TransactionController.currentPage < TransactionController.totalPages ? "#6366F1" : "#9CA3AF"
                                 }
 
                                 MouseArea {
                                     id: nextMA
                                     anchors.fill: parent
-                                    enabled: transactionController.currentPage < transactionController.totalPages
+                                    enabled: TransactionController.currentPage < TransactionController.totalPages
                                     hoverEnabled: true
                                     cursorShape: enabled ? Qt.PointingHandCursor : Qt.ArrowCursor
-                                    onClicked: transactionController.nextPage()
+                                    onClicked: TransactionController.nextPage()
                                 }
                             }
                         }
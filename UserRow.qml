@@ -41,6 +41,17 @@ Rectangle {
                 height: 48
                 radius: 24
                 color: Material.color(Material.Blue, Material.Shade100)
+                clip: true
+
+                Image {
+                    id: studentAvatar
+                    anchors.fill: parent
+                    source: student.profileImage ? "image://remote/" + encodeURIComponent(student.profileImage) : ""
+                    sourceSize: Qt.size(96, 96)
+                    asynchronous: true
+                    fillMode: Image.PreserveAspectCrop
+                    visible: status === Image.Ready
+                }
 
                 Label {
                     anchors.centerIn: parent
@@ -48,6 +59,7 @@ Rectangle {
                     font.pixelSize: 20
                     font.weight: Font.Medium
                     color: Material.color(Material.Blue)
+                    visible: !studentAvatar.visible
                 }
             }
 
@@ -1,12 +1,13 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import Lumin 1.0
 
 Item {
     id: root
 
     Component.onCompleted: {
-        userController.loadStudents()
+        UserController.loadStudents()
     }
 
     Rectangle {
@@ -31,6 +32,22 @@ Item {
 
                 Item { Layout.fillWidth: true }
 
+                ExportButton {
+                    id: exportButton
+                    exporting: UserController.isExporting
+                    progress: UserController.exportProgress
+                    rows: UserController.exportedRows
+                    onExportRequested: function(fileUrl) { UserController.exportStudents(fileUrl) }
+                    onCancelRequested: UserController.cancelExport()
+
+                    Connections {
+                        target: UserController
+                        function onExportFinished(success, message) {
+                            exportButton.showResult(success, message)
+                        }
+                    }
+                }
+
                 Rectangle {
                     height: 36
                     width: refreshText.implicitWidth + 24
@@ -52,7 +69,7 @@ Item {
                         anchors.fill: parent
                         hoverEnabled: true
                         cursorShape: Qt.PointingHandCursor
-                        onClicked: userController.refresh()
+                        onClicked: UserController.refresh()
                     }
                 }
             }
@@ -64,9 +81,9 @@ Item {
 
                 Repeater {
                     model: [
-                        { title: "Total Students", icon: "👥", bg: "#EEF2FF", val: userController.totalStudents },
-                        { title: "Active Students", icon: "✓", bg: "#DCFCE7", val: userController.activeStudents },
-                        { title: "Inactive Students", icon: "○", bg: "#F3F4F6", val: userController.inactiveStudents }
+                        { title: "Total Students", icon: "👥", bg: "#EEF2FF", val: UserController.totalStudents },
+                        { title: "Active Students", icon: "✓", bg: "#DCFCE7", val: UserController.activeStudents },
+                        { title: "Inactive Students", icon: "○", bg: "#F3F4F6", val: UserController.inactiveStudents }
                     ]
 
                     Rectangle {
@@ -150,7 +167,7 @@ Item {
                                 width: tabLabel.implicitWidth + 24
                                 radius: 6
                                 color: {
-                                    var isActive = userController.currentStatus === modelData.value
+                                    var isActive = UserController.currentStatus === modelData.value
                                     if (isActive) return "#6366F1"
                                     if (tabMA.containsMouse) return "#F3F4F6"
                                     return "transparent"
@@ -161,7 +178,7 @@ Item {
                                     anchors.centerIn: parent
                                     text: modelData.label
                                     font.pixelSize: 13
-                                    color: userController.currentStatus === modelData.value ? "white" : "#6B7280"
+                                    color: UserController.currentStatus === modelData.value ? "white" : "#6B7280"
                                 }
 
                                 MouseArea {
@@ -169,7 +186,7 @@ Item {
                                     anchors.fill: parent
                                     hoverEnabled: true
                                     cursorShape: Qt.PointingHandCursor
-                                    onClicked: userController.setStatusFilter(modelData.value)
+                                    onClicked: UserController.setStatusFilter(modelData.value)
                                 }
                             }
                         }
@@ -212,7 +229,7 @@ Item {
                                 Timer {
                                     id: searchTimer
                                     interval: 500
-                                    onTriggered: userController.setSearchQuery(searchInput.text)
+                                    onTriggered: UserController.setSearchQuery(searchInput.text)
                                 }
                             }
                         }
@@ -241,7 +258,7 @@ Item {
                                 cursorShape: Qt.PointingHandCursor
                                 onClicked: {
                                     searchInput.text = ""
-                                    userController.setSearchQuery("")
+                                    UserController.setSearchQuery("")
                                 }
                             }
                         }
@@ -324,7 +341,7 @@ Item {
                         ColumnLayout {
                             anchors.centerIn: parent
                             spacing: 16
-                            visible: userController.isLoading
+                            visible: UserController.isLoading
 
                             Text {
                                 Layout.alignment: Qt.AlignHCenter
@@ -344,7 +361,7 @@ Item {
                         ColumnLayout {
                             anchors.centerIn: parent
                             spacing: 12
-                            visible: !userController.isLoading && userController.students.length === 0
+                            visible: !UserController.isLoading && UserController.students.length === 0
 
                             Text {
                                 Layout.alignment: Qt.AlignHCenter
@@ -371,7 +388,7 @@ Item {
                         // Students List
                         ScrollView {
                             anchors.fill: parent
-                            visible: !userController.isLoading && userController.students.length > 0
+                            visible: !UserController.isLoading && UserController.students.length > 0
                             clip: true
 
                             ColumnLayout {
@@ -379,7 +396,7 @@ Item {
                                 spacing: 0
 
                                 Repeater {
-                                    model: userController.students
+                                    model: UserController.students
 
                                     Rectangle {
                                         Layout.fillWidth: true
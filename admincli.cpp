@@ -0,0 +1,332 @@
+#include "admincli.h"
+#include "apimanager.h"
+#include "exportjob.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <cstring>
+
+namespace {
+
+const char *const Commands[] = { "list", "approve", "reject", "export" };
+
+} // namespace
+
+AdminCli::AdminCli(QObject *parent)
+    : QObject(parent)
+    , m_api(new ApiManager(this))
+    , m_page(1)
+    , m_limit(20)
+    , m_parallel(4)
+    , m_pretty(false)
+    , m_finished(false)
+    , m_failures(0)
+    , m_exportJob(nullptr)
+{
+}
+
+AdminCli::~AdminCli()
+{
+}
+
+bool AdminCli::handles(int argc, char *argv[])
+{
+    if (argc < 2) {
+        return false;
+    }
+    for (const char *command : Commands) {
+        if (std::strcmp(argv[1], command) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AdminCli::start(const QStringList &arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Scripted admin operations. Output is JSON on stdout.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("command", "list, approve, reject or export");
+    parser.addPositionalArgument("resource", "instructors, courses, students or transactions");
+    parser.addPositionalArgument("ids", "Ids to approve or reject", "[ids...]");
+
+    QCommandLineOption statusOption("status", "Status filter.", "status");
+    QCommandLineOption searchOption("search", "Search filter.", "text");
+    QCommandLineOption pageOption("page", "Page to list (default 1).", "n", "1");
+    QCommandLineOption limitOption("limit", "Rows per page (default 20).", "n", "20");
+    QCommandLineOption reasonOption("reason", "Rejection reason (required for courses).", "text");
+    QCommandLineOption outOption("out", "Export file; .csv or .jsonl.", "file");
+    QCommandLineOption parallelOption("parallel", "Requests in flight at most (default 4).", "n", "4");
+    QCommandLineOption prettyOption("pretty", "Indent the JSON output.");
+    parser.addOptions({ statusOption, searchOption, pageOption, limitOption, reasonOption,
+                        outOption, parallelOption, prettyOption });
+
+    if (!parser.parse(arguments)) {
+        fail(UsageError, parser.errorText());
+        return;
+    }
+
+    QStringList positional = parser.positionalArguments();
+    m_command = positional.value(0);
+    m_resource = positional.value(1);
+    m_ids = positional.mid(2);
+    m_status = parser.value(statusOption);
+    m_search = parser.value(searchOption);
+    m_reason = parser.value(reasonOption);
+    m_outPath = parser.value(outOption);
+    m_page = qMax(1, parser.value(pageOption).toInt());
+    m_limit = qMax(1, parser.value(limitOption).toInt());
+    m_parallel = qBound(1, parser.value(parallelOption).toInt(), 16);
+    m_pretty = parser.isSet(prettyOption);
+    m_optionsSet = parser.optionNames();
+
+    if (parser.isSet("help")) {
+        // stdout carries only the JSON result, also here
+        QTextStream(stderr) << parser.helpText();
+        finish(Success, QJsonObject{ { "ok", true } });
+        return;
+    }
+
+    // Singular and plural both read naturally: "approve instructor x",
+    // "list instructors"
+    if (!m_resource.endsWith('s')) {
+        m_resource += 's';
+    }
+
+    if (!m_api->isLoggedIn()) {
+        fail(NotSignedIn, "Not signed in; sign in with the app first");
+        return;
+    }
+
+    // An expired access token would fail every request and trigger as many
+    // refreshes; renew it once up front instead
+    if (tokenExpired(m_api->accessToken())) {
+        connect(m_api, &ApiManager::tokenRefreshed, this, &AdminCli::runCommand);
+        connect(m_api, &ApiManager::tokenRefreshFailed, this, [this]() {
+            fail(NotSignedIn, "The stored session has expired; sign in with the app again");
+        });
+        m_api->refreshAccessToken();
+        return;
+    }
+
+    runCommand();
+}
+
+bool AdminCli::tokenExpired(const QString &accessToken)
+{
+    // JWT payload "exp"; tokens in another format are assumed valid and
+    // left to the server
+    QStringList parts = accessToken.split('.');
+    if (parts.size() != 3) {
+        return false;
+    }
+
+    QByteArray payload = QByteArray::fromBase64(parts.at(1).toLatin1(),
+                                                QByteArray::Base64UrlEncoding);
+    qint64 exp = QJsonDocument::fromJson(payload).object()["exp"].toVariant().toLongLong();
+    return exp > 0 && exp < QDateTime::currentSecsSinceEpoch() + 30;
+}
+
+void AdminCli::runCommand()
+{
+    if (m_command == "list") {
+        runList();
+    } else if (m_command == "approve" || m_command == "reject") {
+        runStatusChanges();
+    } else if (m_command == "export") {
+        runExport();
+    } else {
+        fail(UsageError, QString("Unknown command \"%1\"").arg(m_command));
+    }
+}
+
+void AdminCli::runList()
+{
+    auto loaded = [this](const QJsonObject &data) {
+        finish(Success, QJsonObject{ { "ok", true }, { "data", data } });
+    };
+    auto failed = [this](const QString &error) {
+        fail(OperationFailed, error);
+    };
+
+    if (m_resource == "instructors") {
+        // /api/instructors filters by status only and returns every match
+        for (const char *name : { "search", "page", "limit" }) {
+            if (m_optionsSet.contains(QLatin1String(name))) {
+                fail(UsageError, QString("--%1 is not supported for instructors").arg(QLatin1String(name)));
+                return;
+            }
+        }
+        connect(m_api, &ApiManager::instructorsLoaded, this, loaded);
+        connect(m_api, &ApiManager::instructorsLoadFailed, this, failed);
+        m_api->getInstructors(m_status);
+    } else if (m_resource == "courses") {
+        connect(m_api, &ApiManager::coursesLoaded, this, loaded);
+        connect(m_api, &ApiManager::coursesLoadFailed, this, failed);
+        m_api->getCourses(m_status, m_search, m_page, m_limit);
+    } else if (m_resource == "students") {
+        connect(m_api, &ApiManager::studentsLoaded, this, loaded);
+        connect(m_api, &ApiManager::studentsLoadFailed, this, failed);
+        m_api->getStudents(studentsActiveFilter(m_status), m_search, m_page, m_limit);
+    } else if (m_resource == "transactions") {
+        connect(m_api, &ApiManager::transactionsLoaded, this, loaded);
+        connect(m_api, &ApiManager::transactionsLoadFailed, this, failed);
+        m_api->getTransactions(m_page, m_limit, m_status, m_search);
+    } else {
+        fail(UsageError, QString("Cannot list \"%1\"").arg(m_resource));
+    }
+}
+
+void AdminCli::runStatusChanges()
+{
+    if (m_resource != "instructors" && m_resource != "courses") {
+        fail(UsageError, QString("Cannot %1 \"%2\"").arg(m_command, m_resource));
+        return;
+    }
+    if (m_ids.isEmpty()) {
+        fail(UsageError, QString("Nothing to %1: pass one or more ids").arg(m_command));
+        return;
+    }
+    if (m_command == "reject" && m_resource == "courses" && m_reason.isEmpty()) {
+        fail(UsageError, "Rejecting a course needs --reason");
+        return;
+    }
+
+    m_ids.removeDuplicates();
+    m_queue = m_ids;
+
+    // One ApiManager per request in flight, so each reply maps back to its
+    // id; they share the thread's network manager and its connections
+    int workers = qMin(m_parallel, int(m_queue.size()));
+    for (int i = 0; i < workers; ++i) {
+        ApiManager *worker = i == 0 ? m_api : new ApiManager(this);
+
+        auto done = [this, worker](const QJsonObject &) { statusChangeDone(worker, QString()); };
+        auto failed = [this, worker](const QString &error) { statusChangeDone(worker, error); };
+        if (m_resource == "instructors") {
+            connect(worker, &ApiManager::instructorStatusUpdated, this, done);
+            connect(worker, &ApiManager::instructorStatusUpdateFailed, this, failed);
+        } else {
+            connect(worker, &ApiManager::courseStatusUpdated, this, done);
+            connect(worker, &ApiManager::courseStatusUpdateFailed, this, failed);
+        }
+
+        startNextStatusChange(worker);
+    }
+}
+
+void AdminCli::startNextStatusChange(ApiManager *worker)
+{
+    if (m_queue.isEmpty()) {
+        return;
+    }
+
+    QString id = m_queue.takeFirst();
+    m_inFlight.insert(worker, id);
+
+    bool approve = m_command == "approve";
+    if (m_resource == "instructors") {
+        worker->updateInstructorStatus(id, approve ? "verified" : "rejected");
+    } else {
+        worker->updateCourseStatus(id, approve ? "published" : "rejected", approve ? QString() : m_reason);
+    }
+}
+
+void AdminCli::statusChangeDone(ApiManager *worker, const QString &error)
+{
+    QString id = m_inFlight.take(worker);
+
+    QJsonObject result{ { "id", id }, { "ok", error.isEmpty() } };
+    if (!error.isEmpty()) {
+        result["error"] = error;
+        ++m_failures;
+    }
+    m_results.append(result);
+
+    startNextStatusChange(worker);
+
+    if (m_inFlight.isEmpty() && m_queue.isEmpty()) {
+        finish(m_failures > 0 ? OperationFailed : Success, QJsonObject{
+            { "ok", m_failures == 0 },
+            { "succeeded", int(m_results.size()) - m_failures },
+            { "failed", m_failures },
+            { "results", m_results },
+        });
+    }
+}
+
+QString AdminCli::studentsActiveFilter(const QString &status)
+{
+    // The API filters students on isActive; accept the words the UI uses
+    if (status == "active") {
+        return "true";
+    }
+    if (status == "inactive") {
+        return "false";
+    }
+    return status;
+}
+
+void AdminCli::runExport()
+{
+    ExportJob::Kind kind;
+    if (m_resource == "transactions") {
+        kind = ExportJob::Transactions;
+    } else if (m_resource == "students") {
+        kind = ExportJob::Students;
+    } else {
+        fail(UsageError, QString("Cannot export \"%1\"").arg(m_resource));
+        return;
+    }
+    if (m_outPath.isEmpty()) {
+        fail(UsageError, "export needs --out <file.csv|file.jsonl>");
+        return;
+    }
+
+    m_exportJob = new ExportJob(kind, m_outPath, this);
+    m_exportJob->setFilters(kind == ExportJob::Students ? studentsActiveFilter(m_status) : m_status,
+                            m_search);
+    m_exportJob->setMaxInFlight(m_parallel);
+
+    connect(m_exportJob, &ExportJob::finished, this, [this](bool success, const QString &message) {
+        if (!success) {
+            fail(OperationFailed, message);
+            return;
+        }
+        finish(Success, QJsonObject{
+            { "ok", true },
+            { "file", m_exportJob->filePath() },
+            { "rows", m_exportJob->rowsWritten() },
+            { "pages", m_exportJob->pagesWritten() },
+        });
+    });
+    m_exportJob->start();
+}
+
+void AdminCli::fail(ExitCode code, const QString &message)
+{
+    finish(code, QJsonObject{ { "ok", false }, { "error", message } });
+}
+
+void AdminCli::finish(ExitCode code, QJsonObject output)
+{
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+
+    QFile out;
+    if (out.open(stdout, QIODevice::WriteOnly)) {
+        out.write(QJsonDocument(output).toJson(m_pretty ? QJsonDocument::Indented
+                                                        : QJsonDocument::Compact));
+        if (!m_pretty) {
+            out.write("\n");
+        }
+    }
+
+    emit finished(code);
+}
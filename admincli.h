@@ -0,0 +1,93 @@
+#ifndef ADMINCLI_H
+#define ADMINCLI_H
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QStringList>
+
+class ApiManager;
+class ExportJob;
+
+// Headless entry point for scripted admin work (cron jobs, runbooks). main()
+// hands over to it before any GUI or QML is created when the first argument
+// is a subcommand:
+//
+//   lumin list instructors [--status S]
+//   lumin list courses|students|transactions [--status S]
+//                [--search Q] [--page N] [--limit N]
+//   lumin approve instructor|course <id>...
+//   lumin reject instructor|course <id>... [--reason R]
+//   lumin export transactions|students --out file.csv|file.jsonl
+//                [--status S] [--search Q]
+//
+// It uses the tokens the app stored at its last sign-in and the same
+// ApiManager calls as the controllers. Approvals and rejections run with at
+// most --parallel (default 4) requests in flight. The result is one JSON
+// object on stdout ({"ok": ..., ...}; --pretty indents it); --help text
+// goes to stderr. Exit codes: 0 success, 1 some operation failed, 2 usage
+// error, 3 not signed in.
+class AdminCli : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit AdminCli(QObject *parent = nullptr);
+    ~AdminCli();
+
+    static bool handles(int argc, char *argv[]);
+
+    // Parses the arguments and starts the command; finished() follows,
+    // also for usage errors
+    void start(const QStringList &arguments);
+
+signals:
+    void finished(int exitCode);
+
+private:
+    enum ExitCode {
+        Success = 0,
+        OperationFailed = 1,
+        UsageError = 2,
+        NotSignedIn = 3
+    };
+
+    void runCommand();
+    void runList();
+    void runStatusChanges();
+    void runExport();
+    void startNextStatusChange(ApiManager *worker);
+    void statusChangeDone(ApiManager *worker, const QString &error);
+
+    void fail(ExitCode code, const QString &message);
+    void finish(ExitCode code, QJsonObject output);
+    static bool tokenExpired(const QString &accessToken);
+    static QString studentsActiveFilter(const QString &status);
+
+    ApiManager *m_api;
+    QString m_command;
+    QString m_resource;
+    QStringList m_ids;
+    QString m_status;
+    QString m_search;
+    QString m_reason;
+    QString m_outPath;
+    int m_page;
+    int m_limit;
+    int m_parallel;
+    bool m_pretty;
+    QStringList m_optionsSet;   // as given, before defaults
+    bool m_finished;
+
+    // approve / reject
+    QStringList m_queue;
+    QHash<ApiManager *, QString> m_inFlight;
+    QJsonArray m_results;
+    int m_failures;
+
+    ExportJob *m_exportJob;
+};
+
+#endif // ADMINCLI_H
@@ -1,27 +1,49 @@
 #include "apimanager.h"
-#include <QDebug>
+#include "apinetworkmanager.h"
+#include "logging.h"
+#include "startuptrace.h"
+#include <QCoreApplication>
 #include <QFile>
 #include <QFileInfo>
 #include <QHttpMultiPart>
+#include <QImageReader>
+#include <QImageWriter>
 #include <QMimeDatabase>
+#include <QPointer>
+#include <QTemporaryFile>
+#include <QThread>
+#include <QThreadPool>
 
 ApiManager::ApiManager(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
-    , m_baseUrl("https://learning-dashboard-rouge.vercel.app")
+    , m_networkManager(ApiNetworkManager::shared())
+    , m_baseUrl(defaultBaseUrl())
+    , m_profileImageMaxDimension(1024)
+    , m_profileImageQuality(85)
 {
     loadTokens();
-
-    connect(m_networkManager, &QNetworkAccessManager::sslErrors, this, &ApiManager::onSslErrors);
 }
 
-ApiManager::~ApiManager() {}
+ApiManager::~ApiManager()
+{
+    // The network manager is shared and outlives us: abort what we started
+    // instead of leaving the replies to finish into nothing
+    const auto replies = m_networkManager->findChildren<QNetworkReply *>();
+    for (QNetworkReply *reply : replies) {
+        if (reply->request().originatingObject() == this) {
+            disconnect(reply, nullptr, this, nullptr);
+            reply->abort();
+            reply->deleteLater();
+        }
+    }
+}
 
 
 QNetworkRequest ApiManager::createRequest(const QString &endpoint, bool withAuth)
 {
     QUrl url(m_baseUrl + endpoint);
     QNetworkRequest request(url);
+    request.setOriginatingObject(this);
 
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
     request.setRawHeader("Accept", "application/json");
@@ -36,38 +58,79 @@ QNetworkRequest ApiManager::createRequest(const QString &endpoint, bool withAuth
 void ApiManager::handleNetworkError(QNetworkReply *reply)
 {
     QString errorMsg = reply->errorString();
-    qDebug() << "Network error:" << errorMsg;
+    qCWarning(lcNetwork) << "Network error:" << reply->url().path() << errorMsg;
     emit networkError(errorMsg);
 }
 
 QJsonObject ApiManager::parseResponse(QNetworkReply *reply)
 {
+    StartupTrace::mark("firstNetworkResponse");
+
     QByteArray data = reply->readAll();
-    qDebug() << "Raw response data:" << data;
+    if (Logging::shouldLogBody()) {
+        qCDebug(lcNetworkBody).noquote() << reply->url().path() << Logging::truncated(data);
+    }
+
     QJsonDocument doc = QJsonDocument::fromJson(data);
 
     if (doc.isNull()) {
-        qDebug() << "Failed to parse JSON:" << data;
+        if (!data.isEmpty()) {
+            qCWarning(lcNetwork) << "Response from" << reply->url().path() << "is not JSON,"
+                                 << data.size() << "bytes";
+        }
         return QJsonObject();
     }
 
-    QJsonObject obj = doc.object();
-    qDebug() << "Parsed JSON object keys:" << obj.keys();
-    return obj;
+    return doc.object();
 }
 
-void ApiManager::onSslErrors(QNetworkReply *reply, const QList<QSslError> &errors)
+
+void ApiManager::setBaseUrl(const QString &url)
 {
-    for (const QSslError &error : errors) {
-        qDebug() << "SSL Error:" << error.errorString();
-    }
-    Q_UNUSED(reply)
+    m_baseUrl = url;
 }
 
+void ApiManager::preconnect()
+{
+    m_networkManager->preconnect(QUrl(m_baseUrl));
+}
 
-void ApiManager::setBaseUrl(const QString &url)
+namespace {
+
+bool &fieldProjection()
 {
-    m_baseUrl = url;
+    static bool enabled = qEnvironmentVariableIntValue("LUMIN_API_FIELDS") != 0;
+    return enabled;
+}
+
+QString &defaultBase()
+{
+    static QString url = qEnvironmentVariableIsEmpty("LUMIN_API_BASE_URL")
+                             ? QStringLiteral("https://learning-dashboard-rouge.vercel.app")
+                             : qEnvironmentVariable("LUMIN_API_BASE_URL");
+    return url;
+}
+
+} // namespace
+
+void ApiManager::setFieldProjectionEnabled(bool enabled)
+{
+    fieldProjection() = enabled;
+}
+
+bool ApiManager::fieldProjectionEnabled()
+{
+    return fieldProjection();
+}
+
+void ApiManager::setDefaultBaseUrl(const QString &url)
+{
+    defaultBase() = url;
+}
+
+QString ApiManager::defaultBaseUrl()
+{
+    return defaultBase();
 }
 
 QString ApiManager::baseUrl() const
@@ -288,13 +351,10 @@ void ApiManager::forgotPassword(const QString &email)
         }
 
         QJsonObject response = parseResponse(reply);
-        qDebug() << "Parsed response object:" << response;
 
         if (!response.isEmpty() && response.contains("success") && response["success"].toBool()) {
-            qDebug() << "Success response detected";
             emit forgotPasswordSuccess(response["message"].toString());
         } else if (!response.isEmpty() && response.contains("error")) {
-            qDebug() << "Error response detected";
             emit forgotPasswordFailed(response["error"].toString(), response["message"].toString());
         } else {
             QString errorCode = response["code"].toString();
@@ -474,28 +534,113 @@ void ApiManager::changePassword(const QString &currentPassword, const QString &n
 }
 
 
+void ApiManager::setProfileImageLimits(int maxDimension, int quality)
+{
+    m_profileImageMaxDimension = qMax(64, maxDimension);
+    m_profileImageQuality = qBound(1, quality, 100);
+}
+
 void ApiManager::uploadProfileImage(const QString &filePath)
 {
     emit requestStarted();
 
-    QFile *file = new QFile(filePath);
-    if (!file->open(QIODevice::ReadOnly)) {
-        emit profileImageUploadFailed("Failed to open file");
+    QPointer<ApiManager> self(this);
+    QThread *targetThread = thread();
+    int maxDimension = m_profileImageMaxDimension;
+    int quality = m_profileImageQuality;
+
+    // Decode, downscale and encode off the GUI thread; a 12 MP photo takes
+    // a noticeable time to decode
+    QThreadPool::globalInstance()->start([=]() {
+        QImageReader reader(filePath);
+        reader.setAutoTransform(true);
+
+        QSize size = reader.size();
+        QFileInfo info(filePath);
+        QString format = QString::fromLatin1(reader.format()).toLower();
+
+        QString error;
+        QFile *file = nullptr;
+        QString fileName = info.fileName();
+        QString mimeType;
+
+        bool small = size.isValid() && qMax(size.width(), size.height()) <= maxDimension;
+        bool webFormat = format == "jpeg" || format == "png";
+        bool rotated = reader.transformation() != QImageIOHandler::TransformationNone;
+
+        if (small && webFormat && !rotated) {
+            // Already small enough: send the original bytes unchanged
+            file = new QFile(filePath);
+            mimeType = QMimeDatabase().mimeTypeForFile(filePath).name();
+        } else {
+            if (size.isValid() && qMax(size.width(), size.height()) > maxDimension) {
+                reader.setScaledSize(size.scaled(maxDimension, maxDimension, Qt::KeepAspectRatio));
+            }
+
+            QImage image = reader.read();
+            if (image.isNull()) {
+                error = reader.errorString();
+            } else {
+                bool alpha = image.hasAlphaChannel();
+                QTemporaryFile *temp = new QTemporaryFile;
+                if (!temp->open()) {
+                    error = temp->errorString();
+                    delete temp;
+                } else {
+                    QImageWriter writer(temp, alpha ? "png" : "jpeg");
+                    writer.setQuality(quality);
+                    writer.setOptimizedWrite(true);
+                    if (!writer.write(image)) {
+                        error = writer.errorString();
+                        delete temp;
+                    } else {
+                        temp->seek(0);
+                        file = temp;
+                        fileName = info.completeBaseName() + (alpha ? ".png" : ".jpg");
+                        mimeType = alpha ? "image/png" : "image/jpeg";
+                    }
+                }
+            }
+        }
+
+        if (file) {
+            file->moveToThread(targetThread);
+        }
+
+        // The application object outlives this manager; self is checked
+        // back on the GUI thread
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [=]() {
+            if (!self) {
+                delete file;
+                return;
+            }
+            if (!file) {
+                emit self->requestFinished();
+                emit self->profileImageUploadFailed(error.isEmpty() ? "Failed to read image" : error);
+                return;
+            }
+            self->postProfileImage(file, fileName, mimeType);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void ApiManager::postProfileImage(QFile *file, const QString &fileName, const QString &mimeType)
+{
+    // The re-encoded temporary file is still open; the original is not
+    if (!file->isOpen() && !file->open(QIODevice::ReadOnly)) {
         delete file;
         emit requestFinished();
+        emit profileImageUploadFailed("Failed to open file");
         return;
     }
 
     QHttpMultiPart *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
 
-    QMimeDatabase mimeDb;
-    QString mimeType = mimeDb.mimeTypeForFile(filePath).name();
-
+    // The part reads from the file while sending instead of buffering it
     QHttpPart imagePart;
     imagePart.setHeader(QNetworkRequest::ContentTypeHeader, mimeType);
     imagePart.setHeader(QNetworkRequest::ContentDispositionHeader,
-                        QString("form-data; name=\"image\"; filename=\"%1\"")
-                            .arg(QFileInfo(filePath).fileName()));
+                        QString("form-data; name=\"image\"; filename=\"%1\"").arg(fileName));
     imagePart.setBodyDevice(file);
     file->setParent(multiPart);
 
@@ -503,11 +648,18 @@ void ApiManager::uploadProfileImage(const QString &filePath)
 
     QUrl url(m_baseUrl + "/api/user/upload-image");
     QNetworkRequest request(url);
+    request.setOriginatingObject(this);
     request.setRawHeader("Authorization", ("Bearer " + m_accessToken).toUtf8());
 
     QNetworkReply *reply = m_networkManager->post(request, multiPart);
     multiPart->setParent(reply);
 
+    connect(reply, &QNetworkReply::uploadProgress, this, [this](qint64 bytesSent, qint64 bytesTotal) {
+        if (bytesTotal > 0) {
+            emit profileImageUploadProgress(bytesSent, bytesTotal);
+        }
+    });
+
     connect(reply, &QNetworkReply::finished, this, [this, reply]() {
         reply->deleteLater();
         emit requestFinished();
@@ -592,6 +744,42 @@ void ApiManager::getDashboardStats()
     });
 }
 
+void ApiManager::getDashboardActivity(int limit)
+{
+    emit requestStarted();
+
+    QNetworkRequest request = createRequest(QString("/api/dashboard/activity?limit=%1").arg(limit), true);
+
+    QNetworkReply *reply = m_networkManager->get(request);
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        emit requestFinished();
+
+        if (reply->error() != QNetworkReply::NoError) {
+            if (reply->error() == QNetworkReply::AuthenticationRequiredError) {
+                refreshAccessToken();
+            }
+
+            QJsonObject response = parseResponse(reply);
+            QString errorMsg = response.isEmpty() ?
+                                   reply->errorString() :
+                                   response["message"].toString();
+
+            emit dashboardActivityLoadFailed(errorMsg);
+            return;
+        }
+
+        QJsonObject response = parseResponse(reply);
+
+        if (response["success"].toBool()) {
+            emit dashboardActivityLoaded(response["data"].toObject());
+        } else {
+            emit dashboardActivityLoadFailed(response["message"].toString());
+        }
+    });
+}
+
 void ApiManager::getInstructors(const QString &status)
 {
     emit requestStarted();
@@ -846,13 +1034,25 @@ void ApiManager::updateCourseStatus(const QString &courseId,
         }
     });
 }
-void ApiManager::getStudents(const QString &isActive, const QString &search)
+void ApiManager::getStudents(const QString &isActive, const QString &search, int page, int limit)
 {
     emit requestStarted();
 
     QString endpoint = "/api/students";
     QStringList params;
 
+    if (fieldProjectionEnabled()) {
+        params << "fields=id,firstName,lastName,email,profileImage,isActive,createdAt";
+    }
+
+    // Only sent when paging; the students page loads the full list
+    if (page > 0) {
+        params << QString("page=%1").arg(page);
+    }
+    if (limit > 0) {
+        params << QString("limit=%1").arg(limit);
+    }
+
     if (!isActive.isEmpty()) {
         params << QString("isActive=%1").arg(isActive);
     }
@@ -905,6 +1105,10 @@ void ApiManager::getTransactions(int page, int limit, const QString &status, con
     params << QString("page=%1").arg(page);
     params << QString("limit=%1").arg(limit);
 
+    if (fieldProjectionEnabled()) {
+        params << "fields=orderId,orderNumber,amount,createdAt,status,paymentMethod,student,courses";
+    }
+
     if (!status.isEmpty()) {
         params << QString("status=%1").arg(status);
     }
@@ -956,6 +1160,10 @@ void ApiManager::getNotifications(int limit, const QString &status)
 
     params << QString("limit=%1").arg(limit);
 
+    if (fieldProjectionEnabled()) {
+        params << "fields=id,type,title,message,isRead,actionUrl,createdAt";
+    }
+
     if (!status.isEmpty()) {
         params << QString("status=%1").arg(status);
     }
@@ -1108,3 +1316,142 @@ void ApiManager::markAllNotificationsAsRead()
         }
     });
 }
+
+void ApiManager::createUpload(const QJsonObject &metadata)
+{
+    emit requestStarted();
+
+    QNetworkRequest request = createRequest("/api/uploads", true);
+    QNetworkReply *reply = m_networkManager->post(request, QJsonDocument(metadata).toJson());
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        emit requestFinished();
+
+        if (reply->error() != QNetworkReply::NoError) {
+            if (reply->error() == QNetworkReply::AuthenticationRequiredError) {
+                refreshAccessToken();
+            }
+
+            QJsonObject response = parseResponse(reply);
+            QString errorMsg = response.isEmpty() ?
+                                   reply->errorString() :
+                                   response["message"].toString();
+
+            emit uploadCreateFailed(errorMsg);
+            return;
+        }
+
+        QJsonObject response = parseResponse(reply);
+
+        if (response["success"].toBool()) {
+            emit uploadCreated(response["data"].toObject());
+        } else {
+            emit uploadCreateFailed(response["message"].toString());
+        }
+    });
+}
+
+void ApiManager::getUploadStatus(const QString &uploadId)
+{
+    emit requestStarted();
+
+    QNetworkRequest request = createRequest(QString("/api/uploads/%1").arg(uploadId), true);
+    QNetworkReply *reply = m_networkManager->get(request);
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, uploadId]() {
+        reply->deleteLater();
+        emit requestFinished();
+
+        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        QJsonObject response = parseResponse(reply);
+
+        if (reply->error() != QNetworkReply::NoError || !response["success"].toBool()) {
+            QString errorMsg = response.isEmpty() ?
+                                   reply->errorString() :
+                                   response["message"].toString();
+
+            emit uploadStatusFailed(uploadId, httpStatus, errorMsg);
+            return;
+        }
+
+        emit uploadStatusLoaded(uploadId, response["data"].toObject());
+    });
+}
+
+QNetworkReply *ApiManager::uploadChunk(const QString &uploadId, int index, qint64 offset, qint64 totalSize,
+                                       const QByteArray &data, const QByteArray &sha256Hex)
+{
+    emit requestStarted();
+
+    QNetworkRequest request = createRequest(QString("/api/uploads/%1/chunks/%2").arg(uploadId).arg(index), true);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/octet-stream");
+    request.setRawHeader("Content-Range", QString("bytes %1-%2/%3")
+                                              .arg(offset)
+                                              .arg(offset + data.size() - 1)
+                                              .arg(totalSize)
+                                              .toUtf8());
+    request.setRawHeader("X-Chunk-Sha256", sha256Hex);
+
+    QNetworkReply *reply = m_networkManager->put(request, data);
+
+    connect(reply, &QNetworkReply::uploadProgress, this, [this, uploadId, index](qint64 bytesSent, qint64) {
+        emit uploadChunkProgress(uploadId, index, bytesSent);
+    });
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, uploadId, index]() {
+        reply->deleteLater();
+        emit requestFinished();
+
+        int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+        if (reply->error() != QNetworkReply::NoError) {
+            if (reply->error() == QNetworkReply::AuthenticationRequiredError) {
+                refreshAccessToken();
+            }
+
+            QJsonObject response = parseResponse(reply);
+            QString errorMsg = response.isEmpty() ?
+                                   reply->errorString() :
+                                   response["message"].toString();
+
+            emit uploadChunkFailed(uploadId, index, httpStatus, errorMsg);
+            return;
+        }
+
+        emit uploadChunkAcknowledged(uploadId, index);
+    });
+
+    return reply;
+}
+
+void ApiManager::completeUpload(const QString &uploadId)
+{
+    emit requestStarted();
+
+    QNetworkRequest request = createRequest(QString("/api/uploads/%1/complete").arg(uploadId), true);
+    QNetworkReply *reply = m_networkManager->post(request, QByteArray("{}"));
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, uploadId]() {
+        reply->deleteLater();
+        emit requestFinished();
+
+        if (reply->error() != QNetworkReply::NoError) {
+            QJsonObject response = parseResponse(reply);
+            QString errorMsg = response.isEmpty() ?
+                                   reply->errorString() :
+                                   response["message"].toString();
+
+            emit uploadCompleteFailed(uploadId, errorMsg);
+            return;
+        }
+
+        QJsonObject response = parseResponse(reply);
+
+        if (response["success"].toBool()) {
+            emit uploadCompleted(uploadId, response["data"].toObject());
+        } else {
+            emit uploadCompleteFailed(uploadId, response["message"].toString());
+        }
+    });
+}
@@ -1,6 +1,7 @@
 #ifndef APIMANAGER_H
 #define APIMANAGER_H
 
+#include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -12,6 +13,8 @@
 #include <QUrl>
 #include <QUrlQuery>
 
+class ApiNetworkManager;
+
 class ApiManager : public QObject
 {
     Q_OBJECT
@@ -34,9 +37,13 @@ public:
     void updateProfile(const QJsonObject &data);
     void changePassword(const QString &currentPassword, const QString &newPassword);
     void uploadProfileImage(const QString &filePath);
+    // Profile images larger than maxDimension are downscaled and re-encoded
+    // (JPEG at the given quality, PNG when the image has transparency)
+    void setProfileImageLimits(int maxDimension, int quality);
     void removeProfileImage();
 
     void getDashboardStats();
+    void getDashboardActivity(int limit = 10);
 
     void getInstructors(const QString &status = "");
     void updateInstructorStatus(const QString &instructorId, const QString &status);
@@ -63,7 +70,22 @@ public:
     void setBaseUrl(const QString &url);
     QString baseUrl() const;
 
-    void getStudents(const QString &isActive = "", const QString &search = "");
+    // Opens the connection to the base URL before the first request needs
+    // it; the connection is shared by every ApiManager on this thread
+    void preconnect();
+
+    // Asks the list endpoints for only the row fields the list models read
+    // (fields=...). Off by default; LUMIN_API_FIELDS=1 turns it on.
+    static void setFieldProjectionEnabled(bool enabled);
+    static bool fieldProjectionEnabled();
+
+    // Base URL new instances start with. The production API unless
+    // LUMIN_API_BASE_URL is set, e.g. to a local lumin-mockserver.
+    static void setDefaultBaseUrl(const QString &url);
+    static QString defaultBaseUrl();
+
+    void getStudents(const QString &isActive = "", const QString &search = "",
+                     int page = 0, int limit = 0);
 
     void getTransactions(int page = 1, int limit = 20,
                          const QString &status = "", const QString &search = "");
@@ -73,6 +95,18 @@ public:
     void markNotificationAsRead(const QString &notificationId);
     void markAllNotificationsAsRead();
 
+    // Resumable uploads (see ChunkedUploader)
+    void createUpload(const QJsonObject &metadata);
+    void getUploadStatus(const QString &uploadId);
+    // Returns the reply so the caller can abort the chunk; it is still
+    // deleted by ApiManager once finished
+    QNetworkReply *uploadChunk(const QString &uploadId, int index, qint64 offset, qint64 totalSize,
+                               const QByteArray &data, const QByteArray &sha256Hex);
+    void completeUpload(const QString &uploadId);
+
+    // Reads the whole reply body as a JSON object; empty when it is not JSON
+    static QJsonObject parseResponse(QNetworkReply *reply);
+
 signals:
     void loginSuccess(const QString &sessionToken, const QString &maskedEmail);
     void loginFailed(const QString &errorCode, const QString &errorMessage);
@@ -105,12 +139,15 @@ signals:
 
     void profileImageUploaded(const QString &imageUrl);
     void profileImageUploadFailed(const QString &errorMessage);
+    void profileImageUploadProgress(qint64 bytesSent, qint64 bytesTotal);
 
     void profileImageRemoved();
     void profileImageRemoveFailed(const QString &errorMessage);
 
     void dashboardStatsLoaded(const QJsonObject &stats);
     void dashboardStatsLoadFailed(const QString &errorMessage);
+    void dashboardActivityLoaded(const QJsonObject &data);
+    void dashboardActivityLoadFailed(const QString &errorMessage);
 
     void requestStarted();
     void requestFinished();
@@ -144,19 +181,28 @@ signals:
     void allMarkedAsRead(const QJsonObject &data);
     void markAllAsReadFailed(const QString &errorMessage);
 
+    void uploadCreated(const QJsonObject &data);
+    void uploadCreateFailed(const QString &errorMessage);
+    void uploadStatusLoaded(const QString &uploadId, const QJsonObject &data);
+    void uploadStatusFailed(const QString &uploadId, int httpStatus, const QString &errorMessage);
+    void uploadChunkProgress(const QString &uploadId, int index, qint64 bytesSent);
+    void uploadChunkAcknowledged(const QString &uploadId, int index);
+    void uploadChunkFailed(const QString &uploadId, int index, int httpStatus, const QString &errorMessage);
+    void uploadCompleted(const QString &uploadId, const QJsonObject &data);
+    void uploadCompleteFailed(const QString &uploadId, const QString &errorMessage);
+
 
 private:
-    QNetworkAccessManager *m_networkManager;
+    ApiNetworkManager *m_networkManager;
     QString m_baseUrl;
     QString m_accessToken;
     QString m_refreshToken;
+    int m_profileImageMaxDimension;
+    int m_profileImageQuality;
 
+    void postProfileImage(QFile *file, const QString &fileName, const QString &mimeType);
     QNetworkRequest createRequest(const QString &endpoint, bool withAuth = false);
     void handleNetworkError(QNetworkReply *reply);
-    QJsonObject parseResponse(QNetworkReply *reply);
-
-private slots:
-    void onSslErrors(QNetworkReply *reply, const QList<QSslError> &errors);
 };
 
 #endif // APIMANAGER_H
@@ -0,0 +1,212 @@
+#include "apimetrics.h"
+#include <QJsonArray>
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double BucketGrowth = 1.25;
+
+} // namespace
+
+void ApiMetrics::Histogram::add(double ms)
+{
+    ms = qMax(0.0, ms);
+    ++m_buckets[bucketFor(ms)];
+    ++m_count;
+    m_sum += ms;
+    m_max = qMax(m_max, ms);
+}
+
+int ApiMetrics::Histogram::bucketFor(double ms)
+{
+    if (ms <= 1.0) {
+        return 0;
+    }
+    int bucket = int(std::ceil(std::log(ms) / std::log(BucketGrowth)));
+    return qBound(0, bucket, BucketCount - 1);
+}
+
+double ApiMetrics::Histogram::upperBound(int bucket)
+{
+    return std::pow(BucketGrowth, bucket);
+}
+
+double ApiMetrics::Histogram::percentile(double p) const
+{
+    if (m_count == 0) {
+        return 0.0;
+    }
+
+    qint64 rank = qMax<qint64>(1, qint64(std::ceil(p * m_count)));
+    qint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            // The bucket bound can overshoot the largest sample seen
+            return qMin(upperBound(i), m_max);
+        }
+    }
+    return m_max;
+}
+
+QJsonObject ApiMetrics::Histogram::toJson() const
+{
+    QJsonObject json;
+    json["count"] = m_count;
+    json["mean"] = m_count > 0 ? m_sum / m_count : 0.0;
+    json["p50"] = percentile(0.50);
+    json["p95"] = percentile(0.95);
+    json["p99"] = percentile(0.99);
+    json["max"] = m_max;
+    return json;
+}
+
+ApiMetrics *ApiMetrics::instance()
+{
+    static ApiMetrics metrics;
+    return &metrics;
+}
+
+QString ApiMetrics::endpointKey(const QUrl &url)
+{
+    QStringList segments = url.path().split('/');
+
+    // Ids are the only path segments with digits in them (ObjectIds, cuids,
+    // uuids, numeric ids); resource names never contain any
+    for (QString &segment : segments) {
+        bool hasDigit = std::any_of(segment.cbegin(), segment.cend(),
+                                    [](QChar c) { return c.isDigit(); });
+        if (hasDigit) {
+            segment = QStringLiteral(":id");
+        }
+    }
+
+    return segments.join('/');
+}
+
+void ApiMetrics::record(const QString &endpoint, const Sample &sample)
+{
+    QMutexLocker locker(&m_mutex);
+
+    EndpointStats &stats = m_endpoints[endpoint];
+    ++stats.responses;
+    stats.bodyBytes += sample.bodyBytes;
+    stats.bytesOut += sample.bytesOut;
+
+    if (!sample.encoding.isEmpty() && sample.encoding != "identity") {
+        ++stats.compressedResponses;
+        ++stats.encodings[sample.encoding];
+    }
+
+    if (sample.wireBytes >= 0) {
+        stats.wireBytes += sample.wireBytes;
+        stats.wireBodyBytes += sample.bodyBytes;
+    }
+
+    if (sample.http2) {
+        ++stats.http2Responses;
+    } else {
+        ++stats.http1Responses;
+    }
+
+    if (sample.fromCache) {
+        ++stats.cacheHits;
+    }
+
+    if (sample.httpStatus >= 400) {
+        ++stats.errors[QString::number(sample.httpStatus)];
+    } else if (sample.networkError != 0 && sample.httpStatus == 0) {
+        ++stats.errors[QString("network:%1").arg(sample.networkError)];
+    }
+
+    if (sample.connectMs >= 0) {
+        ++stats.newConnections;
+        stats.connect.add(sample.connectMs);
+    }
+    if (sample.ttfbMs >= 0) {
+        stats.ttfb.add(sample.ttfbMs);
+    }
+    if (sample.totalMs >= 0) {
+        stats.total.add(sample.totalMs);
+    }
+}
+
+void ApiMetrics::recordRetry(const QString &endpoint)
+{
+    QMutexLocker locker(&m_mutex);
+    ++m_endpoints[endpoint].retries;
+}
+
+QJsonObject ApiMetrics::snapshot() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QJsonObject endpoints;
+    for (auto it = m_endpoints.constBegin(); it != m_endpoints.constEnd(); ++it) {
+        const EndpointStats &stats = it.value();
+
+        QJsonObject encodings;
+        for (auto enc = stats.encodings.constBegin(); enc != stats.encodings.constEnd(); ++enc) {
+            encodings[QString::fromLatin1(enc.key())] = enc.value();
+        }
+
+        QJsonObject errors;
+        for (auto err = stats.errors.constBegin(); err != stats.errors.constEnd(); ++err) {
+            errors[err.key()] = err.value();
+        }
+
+        QJsonObject entry;
+        entry["responses"] = stats.responses;
+        entry["compressedResponses"] = stats.compressedResponses;
+        entry["wireBytes"] = stats.wireBytes;
+        entry["bodyBytes"] = stats.bodyBytes;
+        entry["bytesOut"] = stats.bytesOut;
+        entry["encodings"] = encodings;
+        entry["compressionRatio"] = stats.wireBytes > 0 ?
+                                        double(stats.wireBodyBytes) / stats.wireBytes : 1.0;
+        entry["http2Responses"] = stats.http2Responses;
+        entry["http1Responses"] = stats.http1Responses;
+        entry["cacheHits"] = stats.cacheHits;
+        entry["newConnections"] = stats.newConnections;
+        entry["retries"] = stats.retries;
+        entry["errors"] = errors;
+        entry["connectMs"] = stats.connect.toJson();
+        entry["ttfbMs"] = stats.ttfb.toJson();
+        entry["totalMs"] = stats.total.toJson();
+        endpoints[it.key()] = entry;
+    }
+
+    return endpoints;
+}
+
+QString ApiMetrics::summary() const
+{
+    QJsonObject endpoints = snapshot();
+    QStringList lines;
+
+    for (auto it = endpoints.constBegin(); it != endpoints.constEnd(); ++it) {
+        QJsonObject entry = it.value().toObject();
+        QJsonObject total = entry["totalMs"].toObject();
+        lines << QString("%1 %2 responses, p50/p95/p99 %3/%4/%5 ms, %6 KiB decoded, "
+                         "%7 KiB on the wire (x%8), %9 over HTTP/2")
+                     .arg(it.key(), -40)
+                     .arg(entry["responses"].toInteger())
+                     .arg(total["p50"].toDouble(), 0, 'f', 0)
+                     .arg(total["p95"].toDouble(), 0, 'f', 0)
+                     .arg(total["p99"].toDouble(), 0, 'f', 0)
+                     .arg(entry["bodyBytes"].toDouble() / 1024.0, 0, 'f', 1)
+                     .arg(entry["wireBytes"].toDouble() / 1024.0, 0, 'f', 1)
+                     .arg(entry["compressionRatio"].toDouble(), 0, 'f', 2)
+                     .arg(entry["http2Responses"].toInteger());
+    }
+
+    return lines.join('\n');
+}
+
+void ApiMetrics::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_endpoints.clear();
+}
@@ -0,0 +1,96 @@
+#ifndef APIMETRICS_H
+#define APIMETRICS_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+#include <QUrl>
+#include <array>
+
+// Process-wide counters for API traffic, keyed by endpoint with ids folded
+// ("/api/courses/:id/status"). Fed by ApiNetworkManager for every reply, so
+// all ApiManager instances report into the same table. Thread-safe.
+class ApiMetrics
+{
+public:
+    // Log-scale latency histogram: buckets grow by 25% from 1 ms to about
+    // ten minutes, so percentiles are accurate to within one bucket.
+    class Histogram
+    {
+    public:
+        void add(double ms);
+        qint64 count() const { return m_count; }
+        double percentile(double p) const;
+        // count, mean, p50, p95, p99, max
+        QJsonObject toJson() const;
+
+    private:
+        static const int BucketCount = 62;
+        static int bucketFor(double ms);
+        static double upperBound(int bucket);
+
+        std::array<qint64, BucketCount> m_buckets{};
+        qint64 m_count = 0;
+        double m_sum = 0.0;
+        double m_max = 0.0;
+    };
+
+    // One finished reply. Durations are milliseconds from the request being
+    // issued; -1 when the phase did not happen (connect on a reused
+    // connection) or could not be observed.
+    struct Sample {
+        QByteArray encoding;
+        qint64 wireBytes = -1;        // encoded body size, -1 when unknown (chunked)
+        qint64 bodyBytes = 0;         // decoded size handed to the caller
+        qint64 bytesOut = 0;          // request body
+        bool http2 = false;
+        bool fromCache = false;
+        int httpStatus = 0;           // 0 when no response arrived
+        int networkError = 0;         // QNetworkReply::NetworkError
+        double connectMs = -1;        // lookup + TCP + TLS, new connections only
+        double ttfbMs = -1;           // response headers received
+        double totalMs = -1;
+    };
+
+    static ApiMetrics *instance();
+
+    // "/api/instructors/65f0c2.../status" -> "/api/instructors/:id/status"
+    static QString endpointKey(const QUrl &url);
+
+    void record(const QString &endpoint, const Sample &sample);
+    // A request that was sent again after failing (chunk uploads)
+    void recordRetry(const QString &endpoint);
+
+    QJsonObject snapshot() const;
+    QString summary() const;
+    void reset();
+
+private:
+    ApiMetrics() = default;
+
+    struct EndpointStats {
+        qint64 responses = 0;
+        qint64 compressedResponses = 0;
+        qint64 wireBytes = 0;         // only responses with a known wire size
+        qint64 wireBodyBytes = 0;     // decoded size of those same responses
+        qint64 bodyBytes = 0;
+        qint64 bytesOut = 0;
+        qint64 http2Responses = 0;
+        qint64 http1Responses = 0;
+        qint64 cacheHits = 0;
+        qint64 newConnections = 0;
+        qint64 retries = 0;
+        QHash<QByteArray, qint64> encodings;
+        QHash<QString, qint64> errors;   // "404", "network:99"
+        Histogram connect;
+        Histogram ttfb;
+        Histogram total;
+    };
+
+    mutable QMutex m_mutex;
+    QHash<QString, EndpointStats> m_endpoints;
+};
+
+#endif // APIMETRICS_H
@@ -0,0 +1,401 @@
+#include "apinetworkmanager.h"
+#include "apimetrics.h"
+#include "apitraffic.h"
+#include "fallbackreply.h"
+#include "framemonitor.h"
+#include "harlog.h"
+#include "logging.h"
+#include "replayreply.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QGuiApplication>
+#include <QNetworkReply>
+#include <QPointer>
+#include <QSettings>
+#include <QSslError>
+#include <QThread>
+#include <QThreadStorage>
+
+namespace {
+
+QByteArray methodName(QNetworkAccessManager::Operation op, const QNetworkRequest &request)
+{
+    switch (op) {
+    case QNetworkAccessManager::HeadOperation: return "HEAD";
+    case QNetworkAccessManager::GetOperation: return "GET";
+    case QNetworkAccessManager::PutOperation: return "PUT";
+    case QNetworkAccessManager::PostOperation: return "POST";
+    case QNetworkAccessManager::DeleteOperation: return "DELETE";
+    default: return request.attribute(QNetworkRequest::CustomVerbAttribute).toByteArray();
+    }
+}
+
+} // namespace
+
+ApiNetworkManager::ApiNetworkManager(QObject *parent)
+    : QNetworkAccessManager(parent)
+    , m_idleReconnectMs(30 * 1000)
+    , m_watchingApplicationState(false)
+{
+    connect(this, &QNetworkAccessManager::sslErrors, this, &ApiNetworkManager::onSslErrors);
+
+    // Earlier versions persisted session tickets in plaintext settings;
+    // purge them once per process
+    static const bool purgedStoredTickets = []() {
+        QSettings().remove("network/tls");
+        return true;
+    }();
+    Q_UNUSED(purgedStoredTickets)
+}
+
+ApiNetworkManager::~ApiNetworkManager()
+{
+}
+
+ApiNetworkManager *ApiNetworkManager::shared()
+{
+    static QThreadStorage<QPointer<ApiNetworkManager>> managers;
+
+    QPointer<ApiNetworkManager> &manager = managers.localData();
+    if (!manager) {
+        manager = new ApiNetworkManager;
+
+        QCoreApplication *app = QCoreApplication::instance();
+        if (app && QThread::currentThread() == app->thread()) {
+            manager->setParent(app);
+        } else {
+            ApiNetworkManager *owned = manager;
+            QObject::connect(QThread::currentThread(), &QThread::finished, owned,
+                             [owned]() { delete owned; }, Qt::DirectConnection);
+        }
+    }
+
+    return manager;
+}
+
+void ApiNetworkManager::preconnect(const QUrl &baseUrl)
+{
+    if (baseUrl.host().isEmpty() || ApiTraffic::instance()->isReplaying()) {
+        return;
+    }
+
+    m_preconnectUrl = baseUrl;
+
+    // Only the GUI application has a notion of being active; the headless
+    // tools just pre-connect once
+    if (!m_watchingApplicationState) {
+        if (auto *app = qobject_cast<QGuiApplication *>(QCoreApplication::instance())) {
+            connect(app, &QGuiApplication::applicationStateChanged,
+                    this, &ApiNetworkManager::onApplicationStateChanged);
+            m_watchingApplicationState = true;
+        }
+    }
+
+    if (baseUrl.scheme() == QLatin1String("https")) {
+        QSslConfiguration config = sslConfigurationFor(baseUrl,
+                                                       QSslConfiguration::defaultConfiguration());
+
+        // Without h2 in ALPN the warmed-up connection would be HTTP/1.1 and
+        // the first real request could not use it
+        if (http2Enabled(baseUrl.host())) {
+            config.setAllowedNextProtocols({QSslConfiguration::ALPNProtocolHTTP2,
+                                            QSslConfiguration::NextProtocolHttp1_1});
+        }
+        connectToHostEncrypted(baseUrl.host(), quint16(baseUrl.port(443)), config);
+    } else {
+        connectToHost(baseUrl.host(), quint16(baseUrl.port(80)));
+    }
+
+    m_lastActivity.start();
+    qCDebug(lcNetwork) << "Pre-connecting to" << baseUrl.host()
+                       << (sessionTicket(baseUrl.host()).isEmpty() ? "(full handshake)"
+                                                                   : "(resuming TLS session)");
+}
+
+QNetworkReply *ApiNetworkManager::createRequest(Operation op, const QNetworkRequest &request,
+                                                QIODevice *outgoingData)
+{
+    ApiTraffic *traffic = ApiTraffic::instance();
+    if (traffic->isReplaying()) {
+        return createReplayReply(op, request);
+    }
+
+    QNetworkRequest prepared(request);
+    if (prepared.url().scheme() == QLatin1String("https")) {
+        prepared.setSslConfiguration(sslConfigurationFor(prepared.url(),
+                                                         prepared.sslConfiguration()));
+    }
+    prepared.setAttribute(QNetworkRequest::Http2AllowedAttribute,
+                          http2Enabled(prepared.url().host()));
+    if (cache() && !request.attribute(DiskCacheAttribute).toBool()) {
+        prepared.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+        prepared.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+    }
+
+    m_lastActivity.start();
+
+    auto timing = std::make_shared<ReplyTiming>();
+    timing->clock.start();
+    timing->startedAt = QDateTime::currentDateTimeUtc();
+    timing->method = methodName(op, request);
+    if (outgoingData && !outgoingData->isSequential()) {
+        timing->bytesOut = outgoingData->size();
+    }
+
+    // Read before Qt starts consuming the device. Multipart and file
+    // uploads are sequential and recorded without their body, like large
+    // upload chunks.
+    QByteArray requestBody;
+    if (traffic->isRecording()) {
+        if (outgoingData && !outgoingData->isSequential()
+            && outgoingData->size() <= ApiTraffic::MaxRequestBodyBytes) {
+            requestBody = outgoingData->peek(outgoingData->size());
+        }
+    }
+
+    bool encrypted = prepared.url().scheme() == QLatin1String("https");
+
+    // GETs that may go over h2 are wrapped so an h2 protocol failure is
+    // retried over HTTP/1.1 instead of reaching the caller. Only the wrapper
+    // carries the caller as originating object (see ~ApiManager).
+    bool fallback = encrypted && op == GetOperation
+                    && prepared.attribute(QNetworkRequest::Http2AllowedAttribute).toBool();
+    QNetworkRequest sent(prepared);
+    if (fallback) {
+        sent.setOriginatingObject(nullptr);
+    }
+
+    // See the class comment: Accept-Encoding is left to Qt
+    QNetworkReply *reply = QNetworkAccessManager::createRequest(op, sent, outgoingData);
+
+    if (fallback) {
+        reply = new FallbackReply(prepared, reply, [this](QNetworkReply *failed) {
+            checkProtocol(failed);
+            ApiMetrics::instance()->recordRetry(ApiMetrics::endpointKey(failed->url()));
+
+            QNetworkRequest retry = failed->request();
+            retry.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
+            return QNetworkAccessManager::createRequest(GetOperation, retry);
+        }, this);
+    }
+    if (encrypted) {
+        connect(reply, &QNetworkReply::encrypted, this, [this, reply]() {
+            storeSessionTicket(reply);
+        });
+    }
+    trackTiming(reply, timing, encrypted);
+
+    // Connected before the caller's own finished handler, so the whole body
+    // is still buffered in the reply when this runs
+    connect(reply, &QNetworkReply::finished, this, [this, reply, timing, requestBody]() {
+        checkProtocol(reply);
+        recordReply(reply, *timing);
+        ApiTraffic *traffic = ApiTraffic::instance();
+        if (traffic->isRecording()) {
+            traffic->record(reply, timing->method, requestBody, timing->ttfbMs,
+                            timing->clock.nsecsElapsed() / 1e6);
+        }
+    });
+
+    return reply;
+}
+
+QNetworkReply *ApiNetworkManager::createReplayReply(Operation op, const QNetworkRequest &request)
+{
+    // Timed and reported like a network reply, so ApiMetrics shows where
+    // the client spends its time on the recorded session
+    auto timing = std::make_shared<ReplyTiming>();
+    timing->clock.start();
+    timing->startedAt = QDateTime::currentDateTimeUtc();
+    timing->method = methodName(op, request);
+
+    ReplayReply *reply = new ReplayReply(op, request, timing->method, this);
+    trackTiming(reply, timing, false);
+    connect(reply, &QNetworkReply::finished, this, [this, reply, timing]() {
+        recordReply(reply, *timing);
+    });
+
+    return reply;
+}
+
+void ApiNetworkManager::trackTiming(QNetworkReply *reply, const std::shared_ptr<ReplyTiming> &timing,
+                                    bool encrypted)
+{
+    // Qt resolves the host inside the connect, so lookup, TCP and TLS are
+    // one phase here. It only starts when no idle connection was available.
+    connect(reply, &QNetworkReply::socketStartedConnecting, this, [timing]() {
+        if (timing->connectStartMs < 0) {
+            timing->connectStartMs = timing->clock.nsecsElapsed() / 1e6;
+        }
+    });
+
+    auto connectDone = [timing]() {
+        if (timing->connectStartMs >= 0 && timing->connectMs < 0) {
+            timing->connectMs = timing->clock.nsecsElapsed() / 1e6 - timing->connectStartMs;
+        }
+    };
+    if (encrypted) {
+        connect(reply, &QNetworkReply::encrypted, this, connectDone);
+    }
+    connect(reply, &QNetworkReply::requestSent, this, connectDone);
+
+    connect(reply, &QNetworkReply::metaDataChanged, this, [timing]() {
+        if (timing->ttfbMs < 0) {
+            timing->ttfbMs = timing->clock.nsecsElapsed() / 1e6;
+        }
+    });
+
+    connect(reply, &QNetworkReply::uploadProgress, this, [timing](qint64, qint64 bytesTotal) {
+        timing->bytesOut = qMax(timing->bytesOut, bytesTotal);
+    });
+}
+
+bool ApiNetworkManager::http2Enabled(const QString &host) const
+{
+    return !m_http2DisabledHosts.contains(host);
+}
+
+void ApiNetworkManager::checkProtocol(QNetworkReply *reply)
+{
+    QString host = reply->url().host();
+    bool http2 = reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+
+    if (reply->error() == QNetworkReply::ProtocolFailure
+        && reply->request().attribute(QNetworkRequest::Http2AllowedAttribute).toBool()) {
+        // Typically a proxy or middlebox mangling h2 frames. New requests go
+        // out over HTTP/1.1; GETs in flight are reissued by FallbackReply,
+        // other requests in flight fail.
+        if (!m_http2DisabledHosts.contains(host)) {
+            qCWarning(lcNetwork) << "HTTP/2 failed for" << host
+                                 << "(" << reply->errorString() << "), falling back to HTTP/1.1";
+            m_http2DisabledHosts.insert(host);
+            m_protocolLoggedHosts.remove(host);
+        }
+        return;
+    }
+
+    if (reply->error() == QNetworkReply::OperationCanceledError) {
+        return;
+    }
+
+    if (!m_protocolLoggedHosts.contains(host)) {
+        m_protocolLoggedHosts.insert(host);
+        qCInfo(lcNetwork) << host << "is using" << (http2 ? "HTTP/2" : "HTTP/1.1");
+    }
+}
+
+void ApiNetworkManager::onApplicationStateChanged(Qt::ApplicationState state)
+{
+    if (state != Qt::ApplicationActive || !m_preconnectUrl.isValid()) {
+        return;
+    }
+
+    // Recently used connections are still open; only warm up after the
+    // server has had time to drop them
+    if (m_lastActivity.isValid() && m_lastActivity.elapsed() < m_idleReconnectMs) {
+        return;
+    }
+
+    preconnect(m_preconnectUrl);
+}
+
+void ApiNetworkManager::onSslErrors(QNetworkReply *reply, const QList<QSslError> &errors)
+{
+    for (const QSslError &error : errors) {
+        qCWarning(lcNetwork) << "SSL error:" << error.errorString();
+    }
+    Q_UNUSED(reply)
+}
+
+QSslConfiguration ApiNetworkManager::sslConfigurationFor(const QUrl &url,
+                                                         const QSslConfiguration &base)
+{
+    QSslConfiguration config = base;
+
+    // Needed for sessionTicket() to be filled in after the handshake
+    config.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+
+    QByteArray ticket = sessionTicket(url.host());
+    if (!ticket.isEmpty()) {
+        config.setSessionTicket(ticket);
+    }
+
+    return config;
+}
+
+QByteArray ApiNetworkManager::sessionTicket(const QString &host) const
+{
+    auto it = m_sessionTickets.constFind(host);
+    if (it == m_sessionTickets.constEnd() || it->expiresAt <= QDateTime::currentDateTimeUtc()) {
+        return QByteArray();
+    }
+    return it->ticket;
+}
+
+void ApiNetworkManager::storeSessionTicket(QNetworkReply *reply)
+{
+    QSslConfiguration config = reply->sslConfiguration();
+    QByteArray ticket = config.sessionTicket();
+    QString host = reply->url().host();
+
+    if (ticket.isEmpty() || m_sessionTickets.value(host).ticket == ticket) {
+        return;
+    }
+
+    // Servers that give no hint usually keep tickets for a day at most
+    int lifetime = config.sessionTicketLifeTimeHint();
+    if (lifetime <= 0) {
+        lifetime = 12 * 60 * 60;
+    }
+
+    m_sessionTickets.insert(host, { ticket, QDateTime::currentDateTimeUtc().addSecs(lifetime) });
+}
+
+qint64 ApiNetworkManager::wireBytes(const QNetworkReply *reply)
+{
+    // When Qt decompresses a body it removes Content-Length, which counted
+    // the encoded bytes, and keeps the value in OriginalContentLengthAttribute.
+    // Chunked responses carry neither, so their wire size stays unknown.
+    QVariant originalLength = reply->attribute(QNetworkRequest::OriginalContentLengthAttribute);
+    if (originalLength.isValid()) {
+        return originalLength.toLongLong();
+    }
+    if (reply->hasRawHeader("Content-Length")) {
+        return reply->rawHeader("Content-Length").toLongLong();
+    }
+    return -1;
+}
+
+void ApiNetworkManager::recordReply(QNetworkReply *reply, const ReplyTiming &timing)
+{
+    if (reply->error() == QNetworkReply::OperationCanceledError) {
+        return;
+    }
+
+    ApiMetrics::Sample sample;
+    sample.encoding = reply->rawHeader("Content-Encoding").trimmed().toLower();
+    sample.wireBytes = wireBytes(reply);
+    if (sample.encoding.isEmpty() && reply->attribute(QNetworkRequest::OriginalContentLengthAttribute).isValid()) {
+        // Qt decoded the body and did not keep the header naming the encoding
+        sample.encoding = "decoded";
+    }
+    sample.bodyBytes = reply->bytesAvailable();
+    sample.bytesOut = timing.bytesOut;
+    sample.http2 = reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+    sample.fromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+    sample.httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    sample.networkError = int(reply->error());
+    sample.connectMs = timing.connectMs;
+    sample.ttfbMs = timing.ttfbMs;
+    sample.totalMs = timing.clock.nsecsElapsed() / 1e6;
+
+    QString endpoint = ApiMetrics::endpointKey(reply->url());
+    ApiMetrics::instance()->record(endpoint, sample);
+
+    // The caller's finished handler runs next; if it stalls the GUI thread
+    // the long frame is attributed to this endpoint
+    FrameMonitor::note(endpoint);
+
+    HarLog::instance()->record(reply, timing.method, timing.startedAt, timing.bytesOut, sample.wireBytes,
+                               timing.connectMs, timing.ttfbMs, sample.totalMs);
+}
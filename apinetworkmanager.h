@@ -0,0 +1,122 @@
+#ifndef APINETWORKMANAGER_H
+#define APINETWORKMANAGER_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QSet>
+#include <QSslConfiguration>
+#include <QUrl>
+#include <memory>
+
+// QNetworkAccessManager used by ApiManager. createRequest() is the single
+// place every API request passes through, so request policy and per-reply
+// measurements live here rather than in each endpoint method. Every reply
+// is timed (new-connection setup, time to first byte, total) and reported
+// to ApiMetrics.
+//
+// Compression: Accept-Encoding is deliberately left unset. Qt then
+// advertises every decoder it was built with (gzip, deflate, and brotli /
+// zstd where available) and decompresses transparently; setting the header
+// by hand would turn that off and hand us compressed bytes. Qt removes
+// Content-Length from a body it decoded; the encoded size reported to
+// ApiMetrics and HarLog comes from OriginalContentLengthAttribute instead
+// (see wireBytes()), and is unknown for chunked responses.
+//
+// Connections: every ApiManager on a thread shares one instance (shared()),
+// so the controllers reuse the same keep-alive connections instead of each
+// opening their own. preconnect() opens DNS + TCP + TLS to the API host
+// ahead of the first request and again when the application becomes active
+// after being idle. TLS session tickets are kept per host in memory for the
+// life of the process, so reconnects resume the session instead of doing a
+// full handshake. They hold session secrets and are never written to disk.
+//
+// HTTP/2: requests to the API host ask for h2 via ALPN, so the dashboard's
+// parallel loads are multiplexed over one connection. The protocol each
+// response used is recorded in ApiMetrics and the first one per host is
+// logged. A protocol-level failure on an h2 connection turns HTTP/2 off for
+// that host for the rest of the session; later requests use HTTP/1.1, and
+// a GET that hit the failure is reissued once over HTTP/1.1 (FallbackReply)
+// so the caller never sees it.
+//
+// Record / replay: with LUMIN_API_RECORD set every exchange is also written
+// to a file; with LUMIN_API_REPLAY set requests are answered from such a
+// file by ReplayReply and never reach the network (see ApiTraffic).
+// Every finished reply also goes into HarLog for HAR export.
+//
+// Disk cache: RemoteImageLoader fetches images through the shared instance
+// too and installs a QNetworkDiskCache on it. Only requests that set
+// DiskCacheAttribute read or write that cache; API responses always go to
+// the network and are never stored.
+class ApiNetworkManager : public QNetworkAccessManager
+{
+    Q_OBJECT
+
+public:
+    // true on requests allowed to use the disk cache (see the class comment)
+    static constexpr QNetworkRequest::Attribute DiskCacheAttribute =
+        QNetworkRequest::Attribute(QNetworkRequest::User + 1);
+
+    explicit ApiNetworkManager(QObject *parent = nullptr);
+    ~ApiNetworkManager();
+
+    // One instance per thread, owned by the application (GUI thread) or
+    // deleted when its thread finishes
+    static ApiNetworkManager *shared();
+
+    void preconnect(const QUrl &baseUrl);
+
+    bool http2Enabled(const QString &host) const;
+
+    // Encoded size of a finished reply's body, -1 when the server did not
+    // say (chunked)
+    static qint64 wireBytes(const QNetworkReply *reply);
+
+protected:
+    QNetworkReply *createRequest(Operation op, const QNetworkRequest &request,
+                                 QIODevice *outgoingData = nullptr) override;
+
+private slots:
+    void onApplicationStateChanged(Qt::ApplicationState state);
+    void onSslErrors(QNetworkReply *reply, const QList<QSslError> &errors);
+
+private:
+    // Per-reply phase clock, from createRequest() to finished
+    struct ReplyTiming {
+        QElapsedTimer clock;
+        QDateTime startedAt;
+        QByteArray method;
+        double connectStartMs = -1;
+        double connectMs = -1;
+        double ttfbMs = -1;
+        qint64 bytesOut = 0;
+    };
+
+    QNetworkReply *createReplayReply(Operation op, const QNetworkRequest &request);
+    void trackTiming(QNetworkReply *reply, const std::shared_ptr<ReplyTiming> &timing,
+                     bool encrypted);
+    void recordReply(QNetworkReply *reply, const ReplyTiming &timing);
+    void checkProtocol(QNetworkReply *reply);
+    QSslConfiguration sslConfigurationFor(const QUrl &url,
+                                          const QSslConfiguration &base);
+    void storeSessionTicket(QNetworkReply *reply);
+    QByteArray sessionTicket(const QString &host) const;
+
+    struct SessionTicket {
+        QByteArray ticket;
+        QDateTime expiresAt;
+    };
+
+    QUrl m_preconnectUrl;
+    QHash<QString, SessionTicket> m_sessionTickets;
+    QSet<QString> m_http2DisabledHosts;
+    QSet<QString> m_protocolLoggedHosts;
+    QElapsedTimer m_lastActivity;
+    qint64 m_idleReconnectMs;
+    bool m_watchingApplicationState;
+};
+
+#endif // APINETWORKMANAGER_H
@@ -0,0 +1,307 @@
+#include "apitraffic.h"
+#include "logging.h"
+#include <QDataStream>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QNetworkReply>
+
+namespace {
+
+const quint32 Magic = 0x4C4D5452;   // "LMTR"
+const quint16 Version = 1;
+
+QString exchangeKey(const QByteArray &method, const QString &pathAndQuery)
+{
+    return QString::fromLatin1(method) + ' ' + pathAndQuery;
+}
+
+QString pathKey(const QByteArray &method, const QString &pathAndQuery)
+{
+    return exchangeKey(method, pathAndQuery.section('?', 0, 0));
+}
+
+} // namespace
+
+ApiTraffic::ApiTraffic()
+    : m_recorded(0)
+    , m_replaying(false)
+    , m_latencyScale(1.0)
+{
+    m_clock.start();
+
+    QString replayPath = qEnvironmentVariable("LUMIN_API_REPLAY");
+    if (!replayPath.isEmpty()) {
+        bool ok = false;
+        double scale = qEnvironmentVariable("LUMIN_API_REPLAY_LATENCY").toDouble(&ok);
+        startReplay(replayPath, ok && scale >= 0.0 ? scale : 1.0);
+    }
+
+    // Recording a replay would only copy the file
+    QString recordPath = qEnvironmentVariable("LUMIN_API_RECORD");
+    if (!recordPath.isEmpty() && !m_replaying) {
+        startRecording(recordPath);
+    }
+}
+
+ApiTraffic::~ApiTraffic()
+{
+    stopRecording();
+}
+
+ApiTraffic *ApiTraffic::instance()
+{
+    static ApiTraffic traffic;
+    return &traffic;
+}
+
+QString ApiTraffic::pathAndQuery(const QUrl &url)
+{
+    return url.toString(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemoveFragment
+                        | QUrl::FullyEncoded);
+}
+
+bool ApiTraffic::isRecording() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_recordFile.isOpen();
+}
+
+void ApiTraffic::startRecording(const QString &path)
+{
+    if (m_replaying) {
+        return;
+    }
+
+    stopRecording();
+
+    QMutexLocker locker(&m_mutex);
+    m_recorded = 0;
+    m_clock.start();   // startMs counts from here
+    m_recordFile.setFileName(path);
+    if (!m_recordFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(lcNetwork) << "Cannot record API traffic to" << path << ":" << m_recordFile.errorString();
+        return;
+    }
+
+    QDataStream out(&m_recordFile);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << Magic << Version << QDateTime::currentDateTimeUtc();
+    m_recordFile.flush();
+
+    qCInfo(lcNetwork) << "Recording API traffic to" << path;
+}
+
+void ApiTraffic::stopRecording()
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_recordFile.isOpen()) {
+        return;
+    }
+
+    m_recordFile.close();
+    qCInfo(lcNetwork) << "Recorded" << m_recorded << "API exchanges to" << m_recordFile.fileName();
+}
+
+bool ApiTraffic::startReplay(const QString &path, double latencyScale)
+{
+    // Recording a replay would only copy the file
+    stopRecording();
+
+    QMutexLocker locker(&m_mutex);
+    m_exchanges.clear();
+    m_cursors.clear();
+    m_pathFallbacks.clear();
+    m_latencyScale = qMax(0.0, latencyScale);
+    m_replaying = loadReplay(path);
+    return m_replaying;
+}
+
+void ApiTraffic::stopReplay()
+{
+    QMutexLocker locker(&m_mutex);
+    m_replaying = false;
+    m_exchanges.clear();
+    m_cursors.clear();
+    m_pathFallbacks.clear();
+}
+
+bool ApiTraffic::readRecording(const QString &path, QList<Exchange> *exchanges, QDateTime *recordedAt)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(lcNetwork) << "Cannot read" << path << ":" << file.errorString();
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    QDateTime startedAt;
+    in >> magic >> version >> startedAt;
+    if (magic != Magic || version != Version) {
+        qCWarning(lcNetwork) << path << "is not an API recording";
+        return false;
+    }
+
+    if (recordedAt) {
+        *recordedAt = startedAt;
+    }
+
+    while (!in.atEnd()) {
+        Exchange exchange;
+        QByteArray requestBody;
+        QByteArray responseBody;
+        qint16 httpStatus = 0;
+        qint16 networkError = 0;
+        in >> exchange.startMs >> exchange.ttfbMs >> exchange.totalMs
+           >> exchange.method >> exchange.pathAndQuery >> requestBody
+           >> httpStatus >> networkError >> exchange.http2
+           >> exchange.contentType >> responseBody;
+
+        // A recording cut short by a crash still replays up to the last
+        // complete record
+        if (in.status() != QDataStream::Ok) {
+            qCWarning(lcNetwork) << path << "is truncated after" << exchanges->size() << "exchanges";
+            break;
+        }
+
+        exchange.requestBody = requestBody.isEmpty() ? QByteArray() : qUncompress(requestBody);
+        exchange.responseBody = responseBody.isEmpty() ? QByteArray() : qUncompress(responseBody);
+        exchange.httpStatus = httpStatus;
+        exchange.networkError = networkError;
+        exchanges->append(exchange);
+    }
+
+    return true;
+}
+
+bool ApiTraffic::loadReplay(const QString &path)
+{
+    QList<Exchange> exchanges;
+    QDateTime recordedAt;
+    if (!readRecording(path, &exchanges, &recordedAt)) {
+        return false;
+    }
+
+    for (const Exchange &exchange : std::as_const(exchanges)) {
+        QString key = exchangeKey(exchange.method, exchange.pathAndQuery);
+        if (!m_pathFallbacks.contains(pathKey(exchange.method, exchange.pathAndQuery))) {
+            m_pathFallbacks.insert(pathKey(exchange.method, exchange.pathAndQuery), key);
+        }
+        m_exchanges[key].append(exchange);
+    }
+
+    qCInfo(lcNetwork) << "Replaying" << exchanges.size() << "API exchanges recorded"
+                      << recordedAt.toString(Qt::ISODate) << "from" << path
+                      << "at" << m_latencyScale << "x latency";
+    return true;
+}
+
+QByteArray ApiTraffic::redactTokens(const QString &path, const QByteArray &body)
+{
+    if (!path.startsWith(QLatin1String("/api/auth/"))) {
+        return body;
+    }
+
+    QJsonObject root = QJsonDocument::fromJson(body).object();
+    QJsonObject data = root["data"].toObject();
+    bool changed = false;
+    for (const char *key : { "accessToken", "refreshToken", "sessionToken" }) {
+        if (data.contains(QLatin1String(key))) {
+            data[QLatin1String(key)] = QStringLiteral("recorded-%1").arg(QLatin1String(key));
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return body;
+    }
+
+    root["data"] = data;
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+QByteArray ApiTraffic::redactRequestBody(const QString &path, const QByteArray &body)
+{
+    if (body.isEmpty()
+        || (!path.startsWith(QLatin1String("/api/auth/"))
+            && path != QLatin1String("/api/user/change-password"))) {
+        return body;
+    }
+
+    // Not JSON: nothing to redact key by key, so nothing is kept
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(body, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+        return QByteArray();
+    }
+
+    QJsonObject json = document.object();
+    for (const char *key : { "password", "currentPassword", "newPassword", "refreshToken",
+                             "sessionToken", "token", "code" }) {
+        if (json.contains(QLatin1String(key))) {
+            json[QLatin1String(key)] = QStringLiteral("recorded-%1").arg(QLatin1String(key));
+        }
+    }
+    return QJsonDocument(json).toJson(QJsonDocument::Compact);
+}
+
+void ApiTraffic::record(QNetworkReply *reply, const QByteArray &method, const QByteArray &requestBody,
+                        double ttfbMs, double totalMs)
+{
+    if (reply->error() == QNetworkReply::OperationCanceledError) {
+        return;
+    }
+
+    QString path = pathAndQuery(reply->url());
+    QByteArray responseBody = redactTokens(reply->url().path(),
+                                           reply->peek(reply->bytesAvailable()));
+    QByteArray storedRequest = requestBody.size() <= MaxRequestBodyBytes
+                                   ? redactRequestBody(reply->url().path(), requestBody)
+                                   : QByteArray();
+
+    QMutexLocker locker(&m_mutex);
+    if (!m_recordFile.isOpen()) {
+        return;
+    }
+
+    QDataStream out(&m_recordFile);
+    out.setVersion(QDataStream::Qt_6_5);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    out << qint64(m_clock.elapsed() - qint64(totalMs)) << float(ttfbMs) << float(totalMs)
+        << method << path
+        << (storedRequest.isEmpty() ? QByteArray() : qCompress(storedRequest))
+        << qint16(reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt())
+        << qint16(reply->error())
+        << reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool()
+        << reply->rawHeader("Content-Type")
+        << (responseBody.isEmpty() ? QByteArray() : qCompress(responseBody));
+
+    // Flushed per exchange: the sessions worth recording are the ones that
+    // end badly
+    m_recordFile.flush();
+    ++m_recorded;
+}
+
+bool ApiTraffic::take(const QByteArray &method, const QString &pathAndQuery, Exchange *exchange)
+{
+    QMutexLocker locker(&m_mutex);
+
+    QString key = exchangeKey(method, pathAndQuery);
+    if (!m_exchanges.contains(key)) {
+        key = m_pathFallbacks.value(pathKey(method, pathAndQuery));
+        if (key.isEmpty()) {
+            return false;
+        }
+    }
+
+    const QList<Exchange> &recorded = m_exchanges[key];
+    int &cursor = m_cursors[key];
+    *exchange = recorded.at(qMin(cursor, int(recorded.size()) - 1));
+    ++cursor;
+    return true;
+}
@@ -0,0 +1,116 @@
+#ifndef APITRAFFIC_H
+#define APITRAFFIC_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QUrl>
+
+class QNetworkReply;
+
+// Records API request/response pairs to a file, or serves a recorded file
+// back instead of the network, so a slow session reported by an admin can
+// be profiled on a developer machine against exactly the same data.
+// ApiNetworkManager consults it for every request; nothing changes unless
+// one of these is set:
+//   LUMIN_API_RECORD=<file.lrec>        append every exchange to the file
+//   LUMIN_API_REPLAY=<file.lrec>        answer requests from the file
+//   LUMIN_API_REPLAY_LATENCY=<factor>   scale recorded latencies (default 1,
+//                                       0 answers as soon as possible)
+//
+// File format: QDataStream (Qt 6.5), a header of magic "LMTR", version and
+// recording time, then one record per exchange: start offset, time to first
+// byte and total time in ms, method, path + query, request body, HTTP status,
+// network error, whether h2 was used, Content-Type and response body. Bodies
+// are qCompress()ed. Request headers are not stored, so the Authorization
+// header never reaches the file. Passwords, OTP codes and tokens in the
+// request bodies of /api/auth/* and /api/user/change-password, and the
+// tokens in /api/auth responses, are replaced by placeholders. The rest is
+// real account data: treat recordings like a database dump.
+//
+// Replay matches on method and path + query, in recorded order, repeating
+// the last response once a request has been asked for more often than it
+// was recorded. A request never recorded with that query falls back to any
+// recording of the same path, then to a 404.
+class ApiTraffic
+{
+public:
+    struct Exchange {
+        qint64 startMs = 0;      // since recording started
+        float ttfbMs = -1;
+        float totalMs = 0;
+        QByteArray method;
+        QString pathAndQuery;
+        QByteArray requestBody;
+        int httpStatus = 0;
+        int networkError = 0;
+        bool http2 = false;
+        QByteArray contentType;
+        QByteArray responseBody;
+    };
+
+    // Larger request bodies (upload chunks) are recorded without the body
+    static const qint64 MaxRequestBodyBytes = 64 * 1024;
+
+    static ApiTraffic *instance();
+
+    bool isRecording() const;
+    bool isReplaying() const { return m_replaying; }
+    double latencyScale() const { return m_latencyScale; }
+
+    // What LUMIN_API_RECORD does, for a recording started at runtime
+    void startRecording(const QString &path);
+    void stopRecording();
+
+    // What LUMIN_API_REPLAY and LUMIN_API_REPLAY_LATENCY do; replies
+    // created from then on are answered from the file. False when it is
+    // not a recording.
+    bool startReplay(const QString &path, double latencyScale = 1.0);
+    void stopReplay();
+
+    // Called from ApiNetworkManager when a reply finishes, before anyone has
+    // read its body
+    void record(QNetworkReply *reply, const QByteArray &method, const QByteArray &requestBody,
+                double ttfbMs, double totalMs);
+
+    // Next recorded response for this request; false when there is none
+    bool take(const QByteArray &method, const QString &pathAndQuery, Exchange *exchange);
+
+    static QString pathAndQuery(const QUrl &url);
+
+    // Every complete exchange in a recording, in recorded order (bodies
+    // uncompressed); false when the file is not a recording
+    static bool readRecording(const QString &path, QList<Exchange> *exchanges,
+                              QDateTime *recordedAt = nullptr);
+
+    // The request body as it is stored: credentials in auth and
+    // change-password requests become placeholders
+    static QByteArray redactRequestBody(const QString &path, const QByteArray &body);
+
+private:
+    ApiTraffic();
+    ~ApiTraffic();
+    Q_DISABLE_COPY(ApiTraffic)
+
+    bool loadReplay(const QString &path);
+    static QByteArray redactTokens(const QString &path, const QByteArray &body);
+
+    mutable QMutex m_mutex;
+    QElapsedTimer m_clock;
+
+    QFile m_recordFile;
+    int m_recorded;
+
+    bool m_replaying;
+    double m_latencyScale;
+    QHash<QString, QList<Exchange>> m_exchanges;   // "METHOD path?query"
+    QHash<QString, int> m_cursors;
+    QHash<QString, QString> m_pathFallbacks;       // "METHOD path" -> first key
+};
+
+#endif // APITRAFFIC_H
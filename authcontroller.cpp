@@ -1,10 +1,12 @@
 #include "authcontroller.h"
-#include <QDebug>
+#include "logging.h"
 
 AuthController::AuthController(QObject *parent)
     : QObject(parent)
     , m_api(new ApiManager(this))
     , m_isLoading(false)
+    , m_isUploadingImage(false)
+    , m_uploadProgress(0.0)
 {
     connect(m_api, &ApiManager::loginSuccess,    this, &AuthController::onLoginSuccess);
     connect(m_api, &ApiManager::loginFailed,     this, &AuthController::onLoginFailed);
@@ -22,6 +24,9 @@ AuthController::AuthController(QObject *parent)
     connect(m_api, &ApiManager::profileUpdateFailed, this, &AuthController::onProfileUpdateFailed);
     connect(m_api, &ApiManager::passwordChanged, this, &AuthController::onPasswordChanged);
     connect(m_api, &ApiManager::passwordChangeFailed, this, &AuthController::onPasswordChangeFailed);
+    connect(m_api, &ApiManager::profileImageUploaded, this, &AuthController::onProfileImageUploaded);
+    connect(m_api, &ApiManager::profileImageUploadFailed, this, &AuthController::onProfileImageUploadFailed);
+    connect(m_api, &ApiManager::profileImageUploadProgress, this, &AuthController::onProfileImageUploadProgress);
     connect(m_api, &ApiManager::requestStarted,  this, &AuthController::onRequestStarted);
     connect(m_api, &ApiManager::requestFinished, this, &AuthController::onRequestFinished);
 
@@ -50,6 +55,8 @@ void AuthController::setError(const QString &error)
 
 void AuthController::setUserFromJson(const QJsonObject &user)
 {
+    m_user = user;
+
     QString firstName = user["firstName"].toString();
     QString lastName  = user["lastName"].toString();
     QString fullName  = firstName;
@@ -132,6 +139,7 @@ void AuthController::logout()
     m_sessionToken.clear(); m_maskedEmail.clear();
     m_lastEmail.clear();    m_lastPassword.clear();
     m_userName.clear(); m_userEmail.clear(); m_userImage.clear(); m_userId.clear();
+    m_user = QJsonObject();
     emit userNameChanged(); emit userEmailChanged(); emit userImageChanged(); emit userIdChanged();
     emit accessTokenChanged();
     emit isLoggedInChanged();
@@ -139,6 +147,22 @@ void AuthController::logout()
 }
 
 void AuthController::clearError() { setError(""); }
+
+void AuthController::reloadTokens()
+{
+    // Another ApiManager (e.g. SessionSnapshot) refreshed the stored tokens
+    m_api->loadTokens();
+    emit accessTokenChanged();
+    emit isLoggedInChanged();
+}
+
+void AuthController::preconnect()
+{
+    // Called while the login form is up, so the handshake is done by the
+    // time the user submits
+    m_api->preconnect();
+}
+
 void AuthController::loadProfile() { m_api->getProfile(); }
 
 void AuthController::updateProfile(const QString &firstName, const QString &lastName)
@@ -160,6 +184,18 @@ void AuthController::changePassword(const QString &currentPassword, const QStrin
     m_api->changePassword(currentPassword, newPassword);
 }
 
+void AuthController::uploadProfileImage(const QUrl &fileUrl)
+{
+    clearError();
+    if (m_isUploadingImage) return;
+    QString filePath = fileUrl.isLocalFile() ? fileUrl.toLocalFile() : fileUrl.toString();
+    if (filePath.isEmpty()) { setError("Please choose an image."); return; }
+    m_isUploadingImage = true;
+    m_uploadProgress = 0.0;
+    emit uploadProgressChanged();
+    m_api->uploadProfileImage(filePath);
+}
+
 // ─── slots ────────────────────────────────────────────────────────────────────
 
 void AuthController::onLoginSuccess(const QString &sessionToken, const QString &maskedEmail)
@@ -229,7 +265,7 @@ void AuthController::onResetPasswordFailed(const QString &errorCode, const QStri
 void AuthController::onProfileLoaded(const QJsonObject &user)   { setUserFromJson(user); }
 void AuthController::onProfileLoadFailed(const QString &errorMessage)
 {
-    qDebug() << "Failed to load profile:" << errorMessage;
+    qCWarning(lcControllers) << "Failed to load profile:" << errorMessage;
 }
 
 void AuthController::onProfileUpdated(const QJsonObject &user)
@@ -245,6 +281,30 @@ void AuthController::onProfileUpdateFailed(const QString &errorMessage)
 
 void AuthController::onPasswordChanged()  { emit passwordChanged(); }
 void AuthController::onPasswordChangeFailed(const QString &errorMessage) { setError(errorMessage); }
+
+void AuthController::onProfileImageUploaded(const QString &imageUrl)
+{
+    m_isUploadingImage = false;
+    m_uploadProgress = 1.0;
+    emit uploadProgressChanged();
+    m_user["image"] = imageUrl;
+    if (m_userImage != imageUrl) { m_userImage = imageUrl; emit userImageChanged(); }
+    emit profileImageUploaded();
+}
+
+void AuthController::onProfileImageUploadFailed(const QString &errorMessage)
+{
+    m_isUploadingImage = false;
+    m_uploadProgress = 0.0;
+    emit uploadProgressChanged();
+    setError(errorMessage.isEmpty() ? "Failed to upload image. Please try again." : errorMessage);
+}
+
+void AuthController::onProfileImageUploadProgress(qint64 bytesSent, qint64 bytesTotal)
+{
+    m_uploadProgress = double(bytesSent) / bytesTotal;
+    emit uploadProgressChanged();
+}
 void AuthController::onRequestStarted()   { setLoading(true); }
 void AuthController::onRequestFinished()  { setLoading(false); }
 
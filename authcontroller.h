@@ -4,6 +4,7 @@
 #include <QJsonObject>
 #include <QObject>
 #include <QString>
+#include <QUrl>
 #include "apimanager.h"
 
 class AuthController : public QObject
@@ -19,6 +20,9 @@ class AuthController : public QObject
     Q_PROPERTY(QString userImage READ userImage NOTIFY userImageChanged)
     Q_PROPERTY(QString userId READ userId NOTIFY userIdChanged)
     Q_PROPERTY(QString accessToken READ accessToken NOTIFY accessTokenChanged)  // ← new
+    Q_PROPERTY(bool isUploadingImage READ isUploadingImage NOTIFY uploadProgressChanged)
+    Q_PROPERTY(double uploadProgress READ uploadProgress NOTIFY uploadProgressChanged)
+    Q_PROPERTY(QString apiBaseUrl READ apiBaseUrl CONSTANT)
 
 public:
     explicit AuthController(QObject *parent = nullptr);
@@ -33,6 +37,9 @@ public:
     QString userImage() const { return m_userImage; }
     QString userId() const { return m_userId; }
     QString accessToken() const { return m_api->accessToken(); }  // ← new
+    bool isUploadingImage() const { return m_isUploadingImage; }
+    double uploadProgress() const { return m_uploadProgress; }
+    QString apiBaseUrl() const { return m_api->baseUrl(); }
 
     Q_INVOKABLE void login(const QString &email, const QString &password);
     Q_INVOKABLE void verifyOtp(const QString &code);
@@ -48,6 +55,12 @@ public:
     Q_INVOKABLE void loadProfile();
     Q_INVOKABLE void changePassword(const QString &currentPassword, const QString &newPassword);
     Q_INVOKABLE void updateProfile(const QString &firstName, const QString &lastName);  // ← new
+    Q_INVOKABLE void uploadProfileImage(const QUrl &fileUrl);
+    Q_INVOKABLE void reloadTokens();
+    Q_INVOKABLE void preconnect();
+
+    QJsonObject snapshot() const { return m_user; }
+    void restoreSnapshot(const QJsonObject &user) { setUserFromJson(user); }
 
 signals:
     void isLoadingChanged();
@@ -67,6 +80,8 @@ signals:
     void passwordResetSuccessful();
     void passwordChanged();
     void profileUpdated();       // ← new
+    void profileImageUploaded();
+    void uploadProgressChanged();
     void loggedOut();
 
 private slots:
@@ -88,6 +103,9 @@ private slots:
     void onProfileUpdateFailed(const QString &errorMessage); // ← new
     void onPasswordChanged();
     void onPasswordChangeFailed(const QString &errorMessage);
+    void onProfileImageUploaded(const QString &imageUrl);
+    void onProfileImageUploadFailed(const QString &errorMessage);
+    void onProfileImageUploadProgress(qint64 bytesSent, qint64 bytesTotal);
     void onRequestStarted();
     void onRequestFinished();
 
@@ -95,6 +113,8 @@ private:
     ApiManager *m_api;
 
     bool m_isLoading;
+    bool m_isUploadingImage;
+    double m_uploadProgress;
     QString m_errorMessage;
     QString m_sessionToken;
     QString m_maskedEmail;
@@ -103,6 +123,7 @@ private:
     QString m_userEmail;
     QString m_userImage;
     QString m_userId;
+    QJsonObject m_user;
 
     QString m_lastEmail;
     QString m_lastPassword;
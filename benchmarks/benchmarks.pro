@@ -0,0 +1,17 @@
+# QBENCHMARK suite for the decode and list-building paths. Runs with the
+# rest of the checks (make check from a lumin-all.pro build) or on its own:
+#   ./lumin-benchmarks -tickcounter        # or -callgrind, -perf
+#   ./lumin-benchmarks parseResponse:100k
+
+include(../lumin.pri)
+
+QT += testlib
+CONFIG += testcase
+TARGET = lumin-benchmarks
+
+SOURCES += \
+    bufferedreply.cpp \
+    listbenchmarks.cpp
+
+HEADERS += \
+    bufferedreply.h
@@ -0,0 +1,41 @@
+#include "bufferedreply.h"
+#include <cstring>
+
+BufferedReply::BufferedReply(const QByteArray &body, QObject *parent)
+    : QNetworkReply(parent)
+    , m_body(body)
+    , m_offset(0)
+{
+    setUrl(QUrl("https://benchmark.invalid/api/transactions"));
+    setAttribute(QNetworkRequest::HttpStatusCodeAttribute, 200);
+    setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    setHeader(QNetworkRequest::ContentLengthHeader, m_body.size());
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    setFinished(true);
+}
+
+BufferedReply::~BufferedReply()
+{
+}
+
+void BufferedReply::abort()
+{
+    m_offset = m_body.size();
+}
+
+qint64 BufferedReply::bytesAvailable() const
+{
+    return m_body.size() - m_offset + QNetworkReply::bytesAvailable();
+}
+
+qint64 BufferedReply::readData(char *data, qint64 maxSize)
+{
+    qint64 count = qMin(maxSize, m_body.size() - m_offset);
+    if (count <= 0) {
+        return -1;
+    }
+
+    std::memcpy(data, m_body.constData() + m_offset, size_t(count));
+    m_offset += count;
+    return count;
+}
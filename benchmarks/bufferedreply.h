@@ -0,0 +1,29 @@
+#ifndef BUFFEREDREPLY_H
+#define BUFFEREDREPLY_H
+
+#include <QByteArray>
+#include <QNetworkReply>
+
+// Finished QNetworkReply over an in-memory body, so code that consumes
+// replies (ApiManager::parseResponse) can run without a network.
+class BufferedReply : public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    explicit BufferedReply(const QByteArray &body, QObject *parent = nullptr);
+    ~BufferedReply();
+
+    void abort() override;
+    qint64 bytesAvailable() const override;
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+
+private:
+    QByteArray m_body;
+    qint64 m_offset;
+};
+
+#endif // BUFFEREDREPLY_H
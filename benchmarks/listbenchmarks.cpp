@@ -0,0 +1,347 @@
+#include "apimanager.h"
+#include "bufferedreply.h"
+#include "instructorcontroller.h"
+#include "notificationcontroller.h"
+#include "transactioncontroller.h"
+#include "usercontroller.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaObject>
+#include <QSettings>
+#include <QtTest>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Global allocation counter; AllocationScope reads the difference around
+// one call. On glibc malloc, calloc and realloc are wrapped, which also
+// catches QString / QByteArray / container data that Qt allocates with
+// malloc rather than operator new. Elsewhere only operator new is counted,
+// and the report says so.
+namespace {
+
+std::atomic<qint64> g_allocations{0};
+
+struct AllocationScope
+{
+    qint64 start = g_allocations.load(std::memory_order_relaxed);
+    qint64 count() const { return g_allocations.load(std::memory_order_relaxed) - start; }
+};
+
+} // namespace
+
+#if defined(__GLIBC__)
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *p, size_t size);
+
+void *malloc(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(p, size);
+}
+}
+
+namespace {
+const char *const AllocationUnit = "malloc calls";
+}
+
+#else
+
+namespace {
+const char *const AllocationUnit = "operator new calls";
+}
+
+void *operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+#endif
+
+namespace {
+
+// Synthetic payloads shaped like the API's list responses. Values vary per
+// row so string sharing does not flatter the numbers.
+const char *const FirstNames[] = { "Anna", "Aram", "Lilit", "Davit", "Mariam", "Narek", "Sona", "Tigran" };
+const char *const LastNames[] = { "Hakobyan", "Petrosyan", "Sargsyan", "Grigoryan", "Avetisyan", "Karapetyan" };
+const char *const TransactionStatuses[] = { "completed", "pending", "failed", "refunded" };
+const char *const PaymentMethods[] = { "card", "paypal", "bank_transfer" };
+const char *const InstructorStatuses[] = { "pending", "verified", "rejected" };
+const char *const NotificationTypes[] = { "instructor_registration", "course_submitted", "payment_received", "system" };
+
+template <typename T, size_t N>
+const char *pick(const T (&values)[N], int i)
+{
+    return values[i % N];
+}
+
+QString isoDate(int i)
+{
+    static const QDateTime now = QDateTime::currentDateTimeUtc();
+    return now.addSecs(-qint64(i) * 617).toString(Qt::ISODateWithMs);
+}
+
+QJsonObject person(int i)
+{
+    QJsonObject p;
+    p["id"] = QString("65f0c2%1").arg(i, 18, 16, QChar('0'));
+    p["firstName"] = pick(FirstNames, i);
+    p["lastName"] = pick(LastNames, i / 3);
+    p["email"] = QString("user%1@example.com").arg(i);
+    p["createdAt"] = isoDate(i);
+    return p;
+}
+
+QJsonObject transactionsPayload(int rows)
+{
+    QJsonArray transactions;
+    for (int i = 0; i < rows; ++i) {
+        QJsonObject student = person(i);
+        QJsonObject t;
+        t["orderId"] = QString("ord_%1").arg(i);
+        t["orderNumber"] = QString("ORD-%1").arg(100000 + i);
+        t["amount"] = 19.99 + (i % 50);
+        t["status"] = pick(TransactionStatuses, i);
+        t["paymentMethod"] = pick(PaymentMethods, i);
+        t["createdAt"] = isoDate(i);
+        t["student"] = QJsonObject{
+            { "name", student["firstName"].toString() + " " + student["lastName"].toString() },
+            { "email", student["email"] },
+            { "profileImage", QString("https://cdn.example.com/u/%1.jpg").arg(i) },
+        };
+        QJsonArray courses;
+        for (int c = 0; c < 1 + i % 3; ++c) {
+            courses.append(QJsonObject{
+                { "courseId", QString("crs_%1").arg(i * 3 + c) },
+                { "title", QString("Course %1").arg(i % 40 + c) },
+                { "price", 9.99 + c * 10 },
+            });
+        }
+        t["courses"] = courses;
+        transactions.append(t);
+    }
+
+    return QJsonObject{
+        { "transactions", transactions },
+        { "pagination", QJsonObject{ { "page", 2 }, { "limit", rows }, { "total", rows }, { "totalPages", 1 } } },
+    };
+}
+
+QJsonObject studentsPayload(int rows)
+{
+    QJsonArray students;
+    for (int i = 0; i < rows; ++i) {
+        QJsonObject s = person(i);
+        s["isActive"] = i % 4 != 0;
+        s["profileImage"] = QString("https://cdn.example.com/u/%1.jpg").arg(i);
+        students.append(s);
+    }
+    return QJsonObject{ { "students", students } };
+}
+
+QJsonObject instructorsPayload(int rows)
+{
+    QJsonArray instructors;
+    for (int i = 0; i < rows; ++i) {
+        QJsonObject s = person(i);
+        s["instructorStatus"] = pick(InstructorStatuses, i);
+        s["image"] = QString("https://cdn.example.com/i/%1.jpg").arg(i);
+        instructors.append(s);
+    }
+    return QJsonObject{ { "instructors", instructors } };
+}
+
+QJsonObject notificationsPayload(int rows)
+{
+    QJsonArray notifications;
+    for (int i = 0; i < rows; ++i) {
+        notifications.append(QJsonObject{
+            { "id", QString("ntf_%1").arg(i) },
+            { "type", pick(NotificationTypes, i) },
+            { "title", QString("Notification %1").arg(i) },
+            { "message", QString("Something happened to item %1 and needs attention").arg(i) },
+            { "isRead", i % 3 == 0 },
+            { "actionUrl", QString("/instructors/%1").arg(i) },
+            { "createdAt", isoDate(i) },
+        });
+    }
+    return QJsonObject{ { "notifications", notifications }, { "unreadCount", rows / 3 } };
+}
+
+} // namespace
+
+// Times the list hot paths at 10, 1k and 100k rows. Each benchmark also
+// prints how many heap allocations one pass makes, and per row (see
+// AllocationUnit for what is counted).
+class ListBenchmarks : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void parseResponse_data() { addRowCounts(); }
+    void parseResponse();
+    void transactionsList_data() { addRowCounts(); }
+    void transactionsList();
+    void studentsList_data() { addRowCounts(); }
+    void studentsList();
+    void instructorsList_data() { addRowCounts(); }
+    void instructorsList();
+    void notificationsList_data() { addRowCounts(); }
+    void notificationsList();
+
+private:
+    void addRowCounts();
+    // Runs the controller's private "loaded" slot, which builds the list
+    void benchmarkSlot(QObject *controller, const char *slot, const QJsonObject &data);
+    void reportAllocations(qint64 allocations);
+};
+
+void ListBenchmarks::initTestCase()
+{
+    // Keep away from the real application's tokens: not logged in means the
+    // controllers issue no requests on construction
+    QCoreApplication::setOrganizationName("PicsartAcademy-Benchmarks");
+    QCoreApplication::setApplicationName("lumin-benchmarks");
+    QSettings().clear();
+}
+
+void ListBenchmarks::addRowCounts()
+{
+    QTest::addColumn<int>("rows");
+    QTest::newRow("10") << 10;
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("100k") << 100000;
+}
+
+void ListBenchmarks::reportAllocations(qint64 allocations)
+{
+    QFETCH(int, rows);
+    qInfo("%s: %lld %s, %.1f per row", QTest::currentDataTag(),
+          allocations, AllocationUnit, double(allocations) / rows);
+}
+
+void ListBenchmarks::parseResponse()
+{
+    QFETCH(int, rows);
+
+    QJsonObject envelope{ { "success", true }, { "data", transactionsPayload(rows) } };
+    const QByteArray body = QJsonDocument(envelope).toJson(QJsonDocument::Compact);
+
+    {
+        BufferedReply reply(body);
+        AllocationScope scope;
+        QJsonObject parsed = ApiManager::parseResponse(&reply);
+        reportAllocations(scope.count());
+        QCOMPARE(parsed["data"].toObject()["transactions"].toArray().size(), rows);
+    }
+
+    QBENCHMARK {
+        BufferedReply reply(body);
+        QJsonObject parsed = ApiManager::parseResponse(&reply);
+        Q_UNUSED(parsed)
+    }
+}
+
+void ListBenchmarks::benchmarkSlot(QObject *controller, const char *slot, const QJsonObject &data)
+{
+    auto invoke = [&]() {
+        bool ok = QMetaObject::invokeMethod(controller, slot, Qt::DirectConnection,
+                                            Q_ARG(QJsonObject, data));
+        QVERIFY2(ok, slot);
+    };
+
+    {
+        AllocationScope scope;
+        invoke();
+        reportAllocations(scope.count());
+    }
+
+    QBENCHMARK {
+        invoke();
+    }
+}
+
+void ListBenchmarks::transactionsList()
+{
+    QFETCH(int, rows);
+    TransactionController controller;
+    benchmarkSlot(&controller, "onTransactionsLoaded", transactionsPayload(rows));
+    QCOMPARE(controller.transactions().size(), rows);
+}
+
+void ListBenchmarks::studentsList()
+{
+    QFETCH(int, rows);
+    UserController controller;
+    benchmarkSlot(&controller, "onStudentsLoaded", studentsPayload(rows));
+    QCOMPARE(controller.students().size(), rows);
+}
+
+void ListBenchmarks::instructorsList()
+{
+    QFETCH(int, rows);
+    InstructorController controller;
+    benchmarkSlot(&controller, "onInstructorsLoaded", instructorsPayload(rows));
+    QCOMPARE(controller.instructors().size(), rows);
+}
+
+void ListBenchmarks::notificationsList()
+{
+    QFETCH(int, rows);
+    NotificationController controller;
+    benchmarkSlot(&controller, "onNotificationsLoaded", notificationsPayload(rows));
+    QCOMPARE(controller.notifications().size(), rows);
+}
+
+QTEST_GUILESS_MAIN(ListBenchmarks)
+
+#include "listbenchmarks.moc"
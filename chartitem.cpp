@@ -0,0 +1,389 @@
+#include "chartitem.h"
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Root node layout: first child fills, second child strokes
+QSGGeometryNode *createGeometryNode(QSGGeometry::DrawingMode mode)
+{
+    QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(mode);
+
+    QSGGeometryNode *node = new QSGGeometryNode;
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+    node->setMaterial(new QSGFlatColorMaterial);
+    node->setFlag(QSGNode::OwnsMaterial);
+    return node;
+}
+
+void setNodeColor(QSGGeometryNode *node, const QColor &color)
+{
+    QSGFlatColorMaterial *material = static_cast<QSGFlatColorMaterial *>(node->material());
+    if (material->color() != color) {
+        material->setColor(color);
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
+}
+
+} // namespace
+
+ChartItem::ChartItem(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_type(Line)
+    , m_color("#6366F1")
+    , m_lineWidth(2.0)
+    , m_maxValue(0.0)
+    , m_geometryDirty(true)
+    , m_materialDirty(true)
+{
+    setFlag(ItemHasContents, true);
+}
+
+ChartItem::~ChartItem()
+{
+}
+
+void ChartItem::setValues(const QList<qreal> &values)
+{
+    if (m_values == values) {
+        return;
+    }
+
+    m_values = values;
+    emit valuesChanged();
+    markGeometryDirty();
+}
+
+void ChartItem::setType(ChartType type)
+{
+    if (m_type == type) {
+        return;
+    }
+
+    m_type = type;
+    emit typeChanged();
+    m_materialDirty = true;
+    markGeometryDirty();
+}
+
+void ChartItem::setColor(const QColor &color)
+{
+    if (m_color == color) {
+        return;
+    }
+
+    m_color = color;
+    emit colorChanged();
+    m_materialDirty = true;
+    update();
+}
+
+void ChartItem::setFillColor(const QColor &color)
+{
+    if (m_fillColor == color) {
+        return;
+    }
+
+    m_fillColor = color;
+    emit fillColorChanged();
+    m_materialDirty = true;
+    update();
+}
+
+void ChartItem::setLineWidth(qreal width)
+{
+    if (qFuzzyCompare(m_lineWidth, width)) {
+        return;
+    }
+
+    m_lineWidth = width;
+    emit lineWidthChanged();
+    markGeometryDirty();
+}
+
+void ChartItem::setMaxValue(qreal value)
+{
+    if (qFuzzyCompare(m_maxValue, value)) {
+        return;
+    }
+
+    m_maxValue = value;
+    emit maxValueChanged();
+    markGeometryDirty();
+}
+
+int ChartItem::indexAt(qreal x) const
+{
+    int count = m_values.size();
+    if (count == 0 || width() <= 0) {
+        return -1;
+    }
+
+    if (m_type == Bar) {
+        int index = int(x / (width() / count));
+        return qBound(0, index, count - 1);
+    }
+
+    if (count == 1) {
+        return 0;
+    }
+    int index = qRound(x / width() * (count - 1));
+    return qBound(0, index, count - 1);
+}
+
+void ChartItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+
+    if (newGeometry.size() != oldGeometry.size()) {
+        markGeometryDirty();
+    }
+}
+
+void ChartItem::markGeometryDirty()
+{
+    m_geometryDirty = true;
+    polish();
+    update();
+}
+
+void ChartItem::updatePolish()
+{
+    // Downsample on the GUI thread, before the sync with the render thread
+    resample();
+}
+
+QList<QPointF> ChartItem::largestTriangleThreeBuckets(const QList<QPointF> &points, int threshold)
+{
+    int count = points.size();
+    if (threshold >= count || threshold < 3) {
+        return points;
+    }
+
+    QList<QPointF> sampled;
+    sampled.reserve(threshold);
+
+    // First and last points are always kept; the rest is split into
+    // threshold - 2 buckets and each bucket keeps the point forming the
+    // largest triangle with the previous pick and the next bucket's average.
+    double every = double(count - 2) / (threshold - 2);
+    int a = 0;
+    sampled.append(points.at(0));
+
+    for (int i = 0; i < threshold - 2; ++i) {
+        int nextStart = int(std::floor((i + 1) * every)) + 1;
+        int nextEnd = qMin(int(std::floor((i + 2) * every)) + 1, count);
+
+        double avgX = 0.0;
+        double avgY = 0.0;
+        for (int j = nextStart; j < nextEnd; ++j) {
+            avgX += points.at(j).x();
+            avgY += points.at(j).y();
+        }
+        int nextCount = qMax(1, nextEnd - nextStart);
+        avgX /= nextCount;
+        avgY /= nextCount;
+
+        int rangeStart = int(std::floor(i * every)) + 1;
+        int rangeEnd = nextStart;
+
+        const QPointF &pointA = points.at(a);
+        double maxArea = -1.0;
+        int picked = rangeStart;
+
+        for (int j = rangeStart; j < rangeEnd; ++j) {
+            const QPointF &candidate = points.at(j);
+            double area = std::abs((pointA.x() - avgX) * (candidate.y() - pointA.y())
+                                   - (pointA.x() - candidate.x()) * (avgY - pointA.y()));
+            if (area > maxArea) {
+                maxArea = area;
+                picked = j;
+            }
+        }
+
+        sampled.append(points.at(picked));
+        a = picked;
+    }
+
+    sampled.append(points.at(count - 1));
+    return sampled;
+}
+
+void ChartItem::resample()
+{
+    int previous = m_samples.size();
+
+    QList<QPointF> points;
+    points.reserve(m_values.size());
+    for (int i = 0; i < m_values.size(); ++i) {
+        points.append(QPointF(i, m_values.at(i)));
+    }
+
+    // One point per pixel for lines; bars need at least 2 px to stay visible
+    int pixels = qMax(3, int(width()));
+    int threshold = m_type == Bar ? qMax(3, pixels / 2) : pixels;
+
+    m_samples = largestTriangleThreeBuckets(points, threshold);
+
+    if (m_samples.size() != previous) {
+        emit renderedPointsChanged();
+    }
+}
+
+QPointF ChartItem::mapPoint(const QPointF &sample, qreal scaleMax) const
+{
+    int count = m_values.size();
+    qreal x = count > 1 ? sample.x() / (count - 1) * width() : width() / 2;
+    qreal y = height() - qBound(0.0, sample.y() / scaleMax, 1.0) * height();
+    return QPointF(x, y);
+}
+
+void ChartItem::buildLine(QSGGeometryNode *node, const QList<QPointF> &points) const
+{
+    QSGGeometry *geometry = node->geometry();
+    int segments = qMax(0, int(points.size()) - 1);
+    geometry->allocate(segments * 6);
+
+    // Each segment is a quad of two triangles, offset along its normal
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+    qreal half = m_lineWidth / 2.0;
+
+    for (int i = 0; i < segments; ++i) {
+        QPointF p1 = points.at(i);
+        QPointF p2 = points.at(i + 1);
+        QPointF d = p2 - p1;
+        qreal length = std::hypot(d.x(), d.y());
+        QPointF n = length > 0 ? QPointF(-d.y() / length, d.x() / length) * half : QPointF(0, half);
+
+        QSGGeometry::Point2D *v = vertices + i * 6;
+        v[0].set(p1.x() + n.x(), p1.y() + n.y());
+        v[1].set(p1.x() - n.x(), p1.y() - n.y());
+        v[2].set(p2.x() + n.x(), p2.y() + n.y());
+        v[3].set(p2.x() + n.x(), p2.y() + n.y());
+        v[4].set(p1.x() - n.x(), p1.y() - n.y());
+        v[5].set(p2.x() - n.x(), p2.y() - n.y());
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+void ChartItem::buildArea(QSGGeometryNode *node, const QList<QPointF> &points) const
+{
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate(points.size() < 2 ? 0 : points.size() * 2);
+
+    // Strip alternating between the baseline and the series
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+    qreal baseline = height();
+
+    for (int i = 0; i < geometry->vertexCount() / 2; ++i) {
+        const QPointF &p = points.at(i);
+        vertices[i * 2].set(p.x(), baseline);
+        vertices[i * 2 + 1].set(p.x(), p.y());
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+void ChartItem::buildBars(QSGGeometryNode *node, qreal scaleMax) const
+{
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate(m_samples.size() * 6);
+
+    int count = m_values.size();
+
+    // Bars keep their slot in the full series so downsampled bars line up
+    // with indexAt(); gaps are 30% of a slot but at least 1 px
+    qreal slot = count > 0 ? width() / count : 0;
+    qreal barWidth = qMax(1.0, slot * 0.7);
+    if (m_samples.size() < count && width() > 0) {
+        barWidth = qMax(1.0, width() / m_samples.size() * 0.7);
+    }
+
+    QSGGeometry::Point2D *v = geometry->vertexDataAsPoint2D();
+    for (const QPointF &sample : m_samples) {
+        qreal centre = (sample.x() + 0.5) * slot;
+        qreal left = centre - barWidth / 2;
+        qreal right = centre + barWidth / 2;
+        qreal top = height() - qBound(0.0, sample.y() / scaleMax, 1.0) * height();
+        qreal bottom = height();
+
+        v[0].set(left, top);
+        v[1].set(left, bottom);
+        v[2].set(right, top);
+        v[3].set(right, top);
+        v[4].set(left, bottom);
+        v[5].set(right, bottom);
+        v += 6;
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+}
+
+QSGNode *ChartItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    QSGNode *root = oldNode;
+    if (!root) {
+        root = new QSGNode;
+        root->appendChildNode(createGeometryNode(QSGGeometry::DrawTriangleStrip));
+        root->appendChildNode(createGeometryNode(QSGGeometry::DrawTriangles));
+        m_geometryDirty = true;
+        m_materialDirty = true;
+    }
+
+    QSGGeometryNode *fillNode = static_cast<QSGGeometryNode *>(root->firstChild());
+    QSGGeometryNode *lineNode = static_cast<QSGGeometryNode *>(root->lastChild());
+
+    if (m_materialDirty) {
+        QColor fill = m_fillColor.isValid() ? m_fillColor : m_color;
+        if (m_type == Area && !m_fillColor.isValid()) {
+            fill.setAlphaF(0.15f);
+        }
+        setNodeColor(fillNode, fill);
+        setNodeColor(lineNode, m_color);
+        m_materialDirty = false;
+    }
+
+    if (!m_geometryDirty) {
+        return root;
+    }
+    m_geometryDirty = false;
+
+    qreal scaleMax = m_maxValue;
+    if (scaleMax <= 0) {
+        scaleMax = 1.0;
+        for (qreal value : m_values) {
+            scaleMax = qMax(scaleMax, value);
+        }
+    }
+
+    if (m_type == Bar) {
+        fillNode->geometry()->setDrawingMode(QSGGeometry::DrawTriangles);
+        buildBars(fillNode, scaleMax);
+        lineNode->geometry()->allocate(0);
+        lineNode->markDirty(QSGNode::DirtyGeometry);
+        return root;
+    }
+
+    QList<QPointF> points;
+    points.reserve(m_samples.size());
+    for (const QPointF &sample : m_samples) {
+        points.append(mapPoint(sample, scaleMax));
+    }
+
+    fillNode->geometry()->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+    if (m_type == Area) {
+        buildArea(fillNode, points);
+    } else {
+        fillNode->geometry()->allocate(0);
+        fillNode->markDirty(QSGNode::DirtyGeometry);
+    }
+    buildLine(lineNode, points);
+
+    return root;
+}
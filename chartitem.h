@@ -0,0 +1,95 @@
+#ifndef CHARTITEM_H
+#define CHARTITEM_H
+
+#include <QColor>
+#include <QList>
+#include <QPointF>
+#include <QQuickItem>
+#include <QtQml/qqmlregistration.h>
+
+class QSGGeometryNode;
+
+// Line / area / bar chart drawn directly into the scene graph: one geometry
+// node for the fill (area, bars) and one for the line, so a series costs two
+// draw calls however many points it has. Series longer than the item is wide
+// are reduced with Largest-Triangle-Three-Buckets before building geometry,
+// and geometry is only rebuilt when the values, type or size change.
+class ChartItem : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(QList<qreal> values READ values WRITE setValues NOTIFY valuesChanged)
+    Q_PROPERTY(ChartType type READ type WRITE setType NOTIFY typeChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QColor fillColor READ fillColor WRITE setFillColor NOTIFY fillColorChanged)
+    Q_PROPERTY(qreal lineWidth READ lineWidth WRITE setLineWidth NOTIFY lineWidthChanged)
+    Q_PROPERTY(qreal maxValue READ maxValue WRITE setMaxValue NOTIFY maxValueChanged)
+    Q_PROPERTY(int renderedPoints READ renderedPoints NOTIFY renderedPointsChanged)
+
+public:
+    enum ChartType {
+        Line,
+        Area,
+        Bar
+    };
+    Q_ENUM(ChartType)
+
+    explicit ChartItem(QQuickItem *parent = nullptr);
+    ~ChartItem();
+
+    QList<qreal> values() const { return m_values; }
+    ChartType type() const { return m_type; }
+    QColor color() const { return m_color; }
+    QColor fillColor() const { return m_fillColor; }
+    qreal lineWidth() const { return m_lineWidth; }
+    qreal maxValue() const { return m_maxValue; }
+    int renderedPoints() const { return m_samples.size(); }
+
+    void setValues(const QList<qreal> &values);
+    void setType(ChartType type);
+    void setColor(const QColor &color);
+    void setFillColor(const QColor &color);
+    void setLineWidth(qreal width);
+    void setMaxValue(qreal value);
+
+    // Index into values for an x position in item coordinates, or -1
+    Q_INVOKABLE int indexAt(qreal x) const;
+
+    // Reduces points (sorted by x) to at most threshold points
+    static QList<QPointF> largestTriangleThreeBuckets(const QList<QPointF> &points, int threshold);
+
+signals:
+    void valuesChanged();
+    void typeChanged();
+    void colorChanged();
+    void fillColorChanged();
+    void lineWidthChanged();
+    void maxValueChanged();
+    void renderedPointsChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void updatePolish() override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private:
+    void markGeometryDirty();
+    void resample();
+    void buildLine(QSGGeometryNode *node, const QList<QPointF> &points) const;
+    void buildArea(QSGGeometryNode *node, const QList<QPointF> &points) const;
+    void buildBars(QSGGeometryNode *node, qreal scaleMax) const;
+    QPointF mapPoint(const QPointF &sample, qreal scaleMax) const;
+
+    QList<qreal> m_values;
+    QList<QPointF> m_samples;   // (index, value) after downsampling
+    ChartType m_type;
+    QColor m_color;
+    QColor m_fillColor;
+    qreal m_lineWidth;
+    qreal m_maxValue;           // 0 = scale to the largest value
+    bool m_geometryDirty;
+    bool m_materialDirty;
+};
+
+#endif // CHARTITEM_H
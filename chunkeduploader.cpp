@@ -0,0 +1,384 @@
+#include "chunkeduploader.h"
+#include "apimetrics.h"
+#include "logging.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QMimeDatabase>
+#include <QSettings>
+#include <QTimer>
+
+ChunkedUploader::ChunkedUploader(QObject *parent)
+    : QObject(parent)
+    , m_api(new ApiManager(this))
+    , m_totalSize(0)
+    , m_chunkSize(4 * 1024 * 1024)
+    , m_maxParallel(3)
+    , m_maxRetries(3)
+    , m_running(false)
+    , m_completing(false)
+    , m_inFlight(0)
+    , m_generation(0)
+{
+    connect(m_api, &ApiManager::uploadCreated, this, &ChunkedUploader::onUploadCreated);
+    connect(m_api, &ApiManager::uploadCreateFailed, this, &ChunkedUploader::onUploadCreateFailed);
+    connect(m_api, &ApiManager::uploadStatusLoaded, this, &ChunkedUploader::onUploadStatusLoaded);
+    connect(m_api, &ApiManager::uploadStatusFailed, this, &ChunkedUploader::onUploadStatusFailed);
+    connect(m_api, &ApiManager::uploadChunkProgress, this, &ChunkedUploader::onChunkProgress);
+    connect(m_api, &ApiManager::uploadChunkAcknowledged, this, &ChunkedUploader::onChunkAcknowledged);
+    connect(m_api, &ApiManager::uploadChunkFailed, this, &ChunkedUploader::onChunkFailed);
+    connect(m_api, &ApiManager::uploadCompleted, this, &ChunkedUploader::onUploadCompleted);
+    connect(m_api, &ApiManager::uploadCompleteFailed, this, &ChunkedUploader::onUploadCompleteFailed);
+}
+
+ChunkedUploader::~ChunkedUploader()
+{
+}
+
+qint64 ChunkedUploader::bytesUploaded() const
+{
+    qint64 bytes = 0;
+    for (int i = 0; i < m_chunks.size(); ++i) {
+        bytes += m_chunks.at(i).state == Done ? chunkLength(i) : m_chunks.at(i).sent;
+    }
+    return bytes;
+}
+
+double ChunkedUploader::progress() const
+{
+    if (m_totalSize <= 0) {
+        return 0.0;
+    }
+    return double(bytesUploaded()) / m_totalSize;
+}
+
+void ChunkedUploader::start(const QString &filePath, const QJsonObject &metadata)
+{
+    if (m_running) {
+        return;
+    }
+
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        emit finished(false, QString(), QString("Cannot open %1: %2").arg(filePath, m_file.errorString()));
+        return;
+    }
+
+    QFileInfo info(filePath);
+    m_metadata = metadata;
+    m_totalSize = m_file.size();
+    m_uploadId.clear();
+    m_inFlight = 0;
+    m_completing = false;
+    m_running = true;
+
+    // Same file, same bytes: path, size and modification time
+    QByteArray identity = QString("%1|%2|%3")
+                              .arg(info.absoluteFilePath())
+                              .arg(m_totalSize)
+                              .arg(info.lastModified().toMSecsSinceEpoch())
+                              .toUtf8();
+    m_resumeKey = QCryptographicHash::hash(identity, QCryptographicHash::Sha1).toHex();
+
+    QSettings settings;
+    settings.beginGroup("uploads/" + m_resumeKey);
+    QString uploadId = settings.value("uploadId").toString();
+    qint64 chunkSize = settings.value("chunkSize").toLongLong();
+    settings.endGroup();
+
+    if (!uploadId.isEmpty() && chunkSize > 0) {
+        qCInfo(lcNetwork) << "ChunkedUploader: resuming" << uploadId;
+        m_uploadId = uploadId;
+        m_chunkSize = chunkSize;
+        prepareChunks();
+        m_api->getUploadStatus(m_uploadId);
+        return;
+    }
+
+    createUpload();
+}
+
+void ChunkedUploader::cancel()
+{
+    if (!m_running) {
+        return;
+    }
+
+    // Acknowledged chunks stay recorded on the server and in the resume state
+    finish(false, QString(), "Upload cancelled");
+}
+
+void ChunkedUploader::createUpload()
+{
+    QFileInfo info(m_file.fileName());
+    prepareChunks();
+
+    QJsonObject request = m_metadata;
+    request["fileName"] = info.fileName();
+    request["size"] = m_totalSize;
+    request["mimeType"] = QMimeDatabase().mimeTypeForFile(info).name();
+    request["chunkSize"] = m_chunkSize;
+    request["chunkCount"] = m_chunks.size();
+
+    m_api->createUpload(request);
+}
+
+void ChunkedUploader::prepareChunks()
+{
+    int count = int((m_totalSize + m_chunkSize - 1) / m_chunkSize);
+    m_chunks = QVector<Chunk>(qMax(1, count));
+}
+
+qint64 ChunkedUploader::chunkLength(int index) const
+{
+    qint64 offset = index * m_chunkSize;
+    return qMax<qint64>(0, qMin(m_chunkSize, m_totalSize - offset));
+}
+
+void ChunkedUploader::fillWindow()
+{
+    if (!m_running || m_completing) {
+        return;
+    }
+
+    bool allDone = true;
+    for (int i = 0; i < m_chunks.size() && m_running && m_inFlight < m_maxParallel; ++i) {
+        if (m_chunks.at(i).state == Pending) {
+            sendChunk(i);
+        }
+    }
+    if (!m_running) {
+        return;
+    }
+    for (const Chunk &chunk : m_chunks) {
+        if (chunk.state != Done) {
+            allDone = false;
+            break;
+        }
+    }
+
+    if (allDone) {
+        m_completing = true;
+        m_api->completeUpload(m_uploadId);
+    }
+}
+
+void ChunkedUploader::sendChunk(int index)
+{
+    qint64 offset = index * m_chunkSize;
+    if (!m_file.seek(offset)) {
+        finish(false, QString(), m_file.errorString());
+        return;
+    }
+
+    QByteArray data = m_file.read(chunkLength(index));
+    QByteArray checksum = QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex();
+
+    Chunk &chunk = m_chunks[index];
+    chunk.state = InFlight;
+    chunk.sent = 0;
+    ++m_inFlight;
+
+    chunk.reply = m_api->uploadChunk(m_uploadId, index, offset, m_totalSize, data, checksum);
+}
+
+void ChunkedUploader::onUploadCreated(const QJsonObject &data)
+{
+    if (!m_running || !m_uploadId.isEmpty()) {
+        return;
+    }
+
+    m_uploadId = data["uploadId"].toString();
+    if (m_uploadId.isEmpty()) {
+        finish(false, QString(), "Upload was not accepted by the server");
+        return;
+    }
+
+    // The server may pick a different chunk size
+    qint64 chunkSize = data["chunkSize"].toVariant().toLongLong();
+    if (chunkSize > 0 && chunkSize != m_chunkSize) {
+        m_chunkSize = chunkSize;
+        prepareChunks();
+    }
+
+    saveResumeState();
+    fillWindow();
+}
+
+void ChunkedUploader::onUploadCreateFailed(const QString &errorMessage)
+{
+    if (!m_running) {
+        return;
+    }
+
+    finish(false, QString(), errorMessage.isEmpty() ? "Failed to start upload" : errorMessage);
+}
+
+void ChunkedUploader::onUploadStatusLoaded(const QString &uploadId, const QJsonObject &data)
+{
+    if (!m_running || uploadId != m_uploadId) {
+        return;
+    }
+
+    // The server's list is authoritative; chunks it lost are sent again
+    for (const QJsonValue &value : data["receivedChunks"].toArray()) {
+        int index = value.toInt(-1);
+        if (index >= 0 && index < m_chunks.size()) {
+            m_chunks[index].state = Done;
+        }
+    }
+
+    emit progressChanged();
+    fillWindow();
+}
+
+void ChunkedUploader::onUploadStatusFailed(const QString &uploadId, int httpStatus, const QString &errorMessage)
+{
+    if (!m_running || uploadId != m_uploadId) {
+        return;
+    }
+
+    // Expired or unknown on the server: start over
+    if (httpStatus == 404 || httpStatus == 410) {
+        qCDebug(lcNetwork) << "ChunkedUploader: upload" << uploadId << "expired, restarting";
+        clearResumeState();
+        m_uploadId.clear();
+        createUpload();
+        return;
+    }
+
+    finish(false, QString(), errorMessage);
+}
+
+void ChunkedUploader::onChunkProgress(const QString &uploadId, int index, qint64 bytesSent)
+{
+    if (!isCurrentChunk(uploadId, index)) {
+        return;
+    }
+
+    m_chunks[index].sent = bytesSent;
+    emit progressChanged();
+}
+
+void ChunkedUploader::onChunkAcknowledged(const QString &uploadId, int index)
+{
+    if (!isCurrentChunk(uploadId, index)) {
+        return;
+    }
+
+    m_chunks[index].state = Done;
+    m_chunks[index].reply = nullptr;
+    --m_inFlight;
+
+    saveResumeState();
+    emit progressChanged();
+    fillWindow();
+}
+
+void ChunkedUploader::onChunkFailed(const QString &uploadId, int index, int httpStatus, const QString &errorMessage)
+{
+    if (!isCurrentChunk(uploadId, index)) {
+        return;
+    }
+
+    --m_inFlight;
+    Chunk &chunk = m_chunks[index];
+    chunk.sent = 0;
+    chunk.reply = nullptr;
+
+    if (httpStatus == 404 || httpStatus == 410) {
+        clearResumeState();
+        finish(false, QString(), "Upload expired on the server. Please try again.");
+        return;
+    }
+
+    if (chunk.retries >= m_maxRetries) {
+        finish(false, QString(), errorMessage.isEmpty() ? "Failed to upload file" : errorMessage);
+        return;
+    }
+
+    // Checksum mismatches (422) and transient errors are retried with backoff
+    ++chunk.retries;
+    ApiMetrics::instance()->recordRetry(
+        ApiMetrics::endpointKey(QUrl(QString("/api/uploads/%1/chunks/%2").arg(m_uploadId).arg(index))));
+    chunk.state = Pending;
+    int delayMs = 500 * (1 << (chunk.retries - 1));
+    qCWarning(lcNetwork) << "ChunkedUploader: chunk" << index << "failed (" << httpStatus << errorMessage
+                         << "), retry" << chunk.retries << "in" << delayMs << "ms";
+
+    int generation = m_generation;
+    QTimer::singleShot(delayMs, this, [this, generation]() {
+        if (generation == m_generation) {
+            fillWindow();
+        }
+    });
+}
+
+bool ChunkedUploader::isCurrentChunk(const QString &uploadId, int index) const
+{
+    // Acks and failures only count for chunks this run has in flight; after
+    // a cancel and restart with the same upload id anything else is stale
+    return m_running && uploadId == m_uploadId && index >= 0 && index < m_chunks.size()
+           && m_chunks.at(index).state == InFlight;
+}
+
+void ChunkedUploader::onUploadCompleted(const QString &uploadId, const QJsonObject &data)
+{
+    if (!m_running || uploadId != m_uploadId) {
+        return;
+    }
+
+    clearResumeState();
+    finish(true, data["url"].toString(), "Upload complete");
+}
+
+void ChunkedUploader::onUploadCompleteFailed(const QString &uploadId, const QString &errorMessage)
+{
+    if (!m_running || uploadId != m_uploadId) {
+        return;
+    }
+
+    finish(false, QString(), errorMessage.isEmpty() ? "Failed to finish upload" : errorMessage);
+}
+
+void ChunkedUploader::saveResumeState() const
+{
+    QSettings settings;
+    settings.beginGroup("uploads/" + m_resumeKey);
+    settings.setValue("uploadId", m_uploadId);
+    settings.setValue("chunkSize", m_chunkSize);
+    settings.setValue("updatedAt", QDateTime::currentDateTimeUtc());
+    settings.endGroup();
+}
+
+void ChunkedUploader::clearResumeState() const
+{
+    QSettings settings;
+    settings.remove("uploads/" + m_resumeKey);
+}
+
+void ChunkedUploader::finish(bool success, const QString &url, const QString &message)
+{
+    ++m_generation;
+    m_running = false;
+    m_completing = false;
+    m_inFlight = 0;
+    m_file.close();
+
+    // Aborting reports each chunk as failed, which is ignored now that the
+    // run is over
+    for (Chunk &chunk : m_chunks) {
+        if (QNetworkReply *reply = chunk.reply) {
+            chunk.reply = nullptr;
+            reply->abort();
+        }
+        if (chunk.state == InFlight) {
+            chunk.state = Pending;
+            chunk.sent = 0;
+        }
+    }
+
+    qCInfo(lcNetwork) << "ChunkedUploader:" << message;
+    emit finished(success, url, message);
+}
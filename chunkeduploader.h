@@ -0,0 +1,106 @@
+#ifndef CHUNKEDUPLOADER_H
+#define CHUNKEDUPLOADER_H
+
+#include <QFile>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+#include <QVector>
+#include "apimanager.h"
+
+// Uploads a file to /api/uploads in fixed-size chunks:
+//
+//   POST /api/uploads                     {fileName, size, mimeType, chunkSize, chunkCount, ...}
+//                                         -> {uploadId, chunkSize?}
+//   GET  /api/uploads/<id>                -> {receivedChunks: [index, ...]}
+//   PUT  /api/uploads/<id>/chunks/<index> raw bytes, Content-Range and
+//                                         X-Chunk-Sha256 (hex) headers
+//   POST /api/uploads/<id>/complete       -> {url}
+//
+// Up to maxParallel chunks are in flight at once and a failed chunk is
+// retried with backoff. The upload id is kept in QSettings ("uploads"),
+// keyed by the file's path, size and modification time, so starting the
+// same file again after a restart asks the server which chunks it already
+// has and only sends the rest. Point the ApiManager at a local server with
+// setBaseUrl() to exercise it without the production backend.
+class ChunkedUploader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ChunkedUploader(QObject *parent = nullptr);
+    ~ChunkedUploader();
+
+    void setChunkSize(qint64 chunkSize) { m_chunkSize = qMax<qint64>(64 * 1024, chunkSize); }
+    void setMaxParallel(int maxParallel) { m_maxParallel = qMax(1, maxParallel); }
+    void setMaxRetries(int maxRetries) { m_maxRetries = qMax(0, maxRetries); }
+    ApiManager *api() const { return m_api; }
+
+    bool isRunning() const { return m_running; }
+    qint64 totalBytes() const { return m_totalSize; }
+    qint64 bytesUploaded() const;
+    double progress() const;
+
+    // metadata is merged into the create request (e.g. purpose, courseId)
+    void start(const QString &filePath, const QJsonObject &metadata = QJsonObject());
+
+    // Stops sending and aborts the chunks in flight; the upload can be
+    // resumed by starting the same file again
+    void cancel();
+
+signals:
+    void progressChanged();
+    void finished(bool success, const QString &url, const QString &message);
+
+private slots:
+    void onUploadCreated(const QJsonObject &data);
+    void onUploadCreateFailed(const QString &errorMessage);
+    void onUploadStatusLoaded(const QString &uploadId, const QJsonObject &data);
+    void onUploadStatusFailed(const QString &uploadId, int httpStatus, const QString &errorMessage);
+    void onChunkProgress(const QString &uploadId, int index, qint64 bytesSent);
+    void onChunkAcknowledged(const QString &uploadId, int index);
+    void onChunkFailed(const QString &uploadId, int index, int httpStatus, const QString &errorMessage);
+    void onUploadCompleted(const QString &uploadId, const QJsonObject &data);
+    void onUploadCompleteFailed(const QString &uploadId, const QString &errorMessage);
+
+private:
+    enum ChunkState {
+        Pending,
+        InFlight,
+        Done
+    };
+
+    struct Chunk {
+        ChunkState state = Pending;
+        int retries = 0;
+        qint64 sent = 0;
+        QPointer<QNetworkReply> reply;   // while InFlight
+    };
+
+    void createUpload();
+    void prepareChunks();
+    void fillWindow();
+    void sendChunk(int index);
+    qint64 chunkLength(int index) const;
+    bool isCurrentChunk(const QString &uploadId, int index) const;
+    void saveResumeState() const;
+    void clearResumeState() const;
+    void finish(bool success, const QString &url, const QString &message);
+
+    ApiManager *m_api;
+    QFile m_file;
+    QJsonObject m_metadata;
+    QString m_resumeKey;
+    QString m_uploadId;
+    qint64 m_totalSize;
+    qint64 m_chunkSize;
+    int m_maxParallel;
+    int m_maxRetries;
+    bool m_running;
+    bool m_completing;
+    int m_inFlight;
+    int m_generation;                   // bumped by finish(); retry timers check it
+    QVector<Chunk> m_chunks;
+};
+
+#endif // CHUNKEDUPLOADER_H
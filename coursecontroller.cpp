@@ -1,5 +1,6 @@
 #include "coursecontroller.h"
-#include <QDebug>
+#include "chunkeduploader.h"
+#include "logging.h"
 
 CourseController::CourseController(QObject *parent)
     : QObject(parent)
@@ -10,6 +11,7 @@ CourseController::CourseController(QObject *parent)
     , m_pendingReviewCourses(0)
     , m_publishedCourses(0)
     , m_rejectedCourses(0)
+    , m_uploader(nullptr)
 {
     connect(m_api, &ApiManager::courseStatsLoaded,
             this, &CourseController::onCourseStatsLoaded);
@@ -47,8 +49,59 @@ void CourseController::reloadTokens()
     // Re-read the access token from QSettings so this controller's
     // ApiManager picks up the token saved by AuthController after login.
     m_api->loadTokens();
-    qDebug() << "CourseController: tokens reloaded, logged in:"
-             << m_api->isLoggedIn();
+    qCDebug(lcControllers) << "CourseController: tokens reloaded, logged in:"
+                           << m_api->isLoggedIn();
+}
+
+double CourseController::mediaUploadProgress() const
+{
+    return m_uploader ? m_uploader->progress() : 0.0;
+}
+
+void CourseController::uploadCourseMedia(const QUrl &fileUrl, const QString &courseId,
+                                         const QString &purpose)
+{
+    if (m_uploader) {
+        return;
+    }
+
+    QString filePath = fileUrl.isLocalFile() ? fileUrl.toLocalFile() : fileUrl.toString();
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QJsonObject metadata;
+    metadata["purpose"] = purpose;
+    if (!courseId.isEmpty()) {
+        metadata["courseId"] = courseId;
+    }
+
+    m_uploader = new ChunkedUploader(this);
+    connect(m_uploader, &ChunkedUploader::progressChanged, this, &CourseController::mediaUploadChanged);
+    connect(m_uploader, &ChunkedUploader::finished, this,
+            [this, purpose](bool success, const QString &url, const QString &message) {
+                m_uploader->deleteLater();
+                m_uploader = nullptr;
+                emit mediaUploadChanged();
+
+                if (success) {
+                    emit mediaUploaded(url, purpose);
+                } else {
+                    setError(message);
+                    emit mediaUploadFailed(message);
+                }
+            });
+
+    clearError();
+    emit mediaUploadChanged();
+    m_uploader->start(filePath, metadata);
+}
+
+void CourseController::cancelMediaUpload()
+{
+    if (m_uploader) {
+        m_uploader->cancel();
+    }
 }
 
 void CourseController::loadStats()
@@ -67,9 +120,14 @@ void CourseController::refresh()
     loadStats();
 }
 
+void CourseController::restoreSnapshot(const QJsonObject &data)
+{
+    onCourseStatsLoaded(data);
+}
+
 void CourseController::onCourseStatsLoaded(const QJsonObject &data)
 {
-    qDebug() << "Course stats response:" << data;
+    m_lastStats = data;
 
     if (data.contains("stats")) {
         updateStats(data["stats"].toObject());
@@ -99,8 +157,6 @@ void CourseController::onRequestFinished()
 
 void CourseController::updateStats(const QJsonObject &stats)
 {
-    qDebug() << "Updating stats with:" << stats;
-
     m_totalCourses = stats.contains("total") ? stats["total"].toInt() : 0;
     m_draftCourses = stats.contains("draft") ? stats["draft"].toInt() : 0;
 
@@ -115,11 +171,11 @@ void CourseController::updateStats(const QJsonObject &stats)
     m_publishedCourses = stats.contains("published") ? stats["published"].toInt() : 0;
     m_rejectedCourses  = stats.contains("rejected")  ? stats["rejected"].toInt()  : 0;
 
-    qDebug() << "Stats updated - Total:" << m_totalCourses
-             << "Draft:" << m_draftCourses
-             << "Pending:" << m_pendingReviewCourses
-             << "Published:" << m_publishedCourses
-             << "Rejected:" << m_rejectedCourses;
+    qCDebug(lcControllers) << "Stats updated - Total:" << m_totalCourses
+                           << "Draft:" << m_draftCourses
+                           << "Pending:" << m_pendingReviewCourses
+                           << "Published:" << m_publishedCourses
+                           << "Rejected:" << m_rejectedCourses;
 
     emit statsChanged();
 }
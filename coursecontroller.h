@@ -2,9 +2,12 @@
 #define COURSECONTROLLER_H
 
 #include <QObject>
+#include <QUrl>
 #include <QJsonObject>
 #include "apimanager.h"
 
+class ChunkedUploader;
+
 class CourseController : public QObject
 {
     Q_OBJECT
@@ -16,6 +19,8 @@ class CourseController : public QObject
     Q_PROPERTY(int pendingReviewCourses READ pendingReviewCourses NOTIFY statsChanged)
     Q_PROPERTY(int publishedCourses READ publishedCourses NOTIFY statsChanged)
     Q_PROPERTY(int rejectedCourses READ rejectedCourses NOTIFY statsChanged)
+    Q_PROPERTY(bool isUploadingMedia READ isUploadingMedia NOTIFY mediaUploadChanged)
+    Q_PROPERTY(double mediaUploadProgress READ mediaUploadProgress NOTIFY mediaUploadChanged)
 
 public:
     explicit CourseController(QObject *parent = nullptr);
@@ -28,17 +33,31 @@ public:
     int pendingReviewCourses() const { return m_pendingReviewCourses; }
     int publishedCourses() const { return m_publishedCourses; }
     int rejectedCourses() const { return m_rejectedCourses; }
+    bool isUploadingMedia() const { return m_uploader != nullptr; }
+    double mediaUploadProgress() const;
 
     Q_INVOKABLE void loadStats();
     Q_INVOKABLE void clearError();
     Q_INVOKABLE void refresh();
     Q_INVOKABLE void reloadTokens();   // ← reloads auth token from QSettings
 
+    // Resumable chunked upload of a thumbnail or lesson media file;
+    // starting the same file again after a failure resumes it
+    Q_INVOKABLE void uploadCourseMedia(const QUrl &fileUrl, const QString &courseId,
+                                       const QString &purpose = "thumbnail");
+    Q_INVOKABLE void cancelMediaUpload();
+
+    QJsonObject snapshot() const { return m_lastStats; }
+    void restoreSnapshot(const QJsonObject &data);
+
 signals:
     void isLoadingChanged();
     void errorMessageChanged();
     void statsChanged();
     void statsLoaded();
+    void mediaUploadChanged();
+    void mediaUploaded(const QString &url, const QString &purpose);
+    void mediaUploadFailed(const QString &errorMessage);
 
 private slots:
     void onCourseStatsLoaded(const QJsonObject &data);
@@ -56,6 +75,8 @@ private:
     int m_pendingReviewCourses;
     int m_publishedCourses;
     int m_rejectedCourses;
+    QJsonObject m_lastStats;
+    ChunkedUploader *m_uploader;
 
     void setLoading(bool loading);
     void setError(const QString &error);
@@ -1,11 +1,13 @@
 #include "dashboardcontroller.h"
+#include "logging.h"
+#include <QJsonArray>
 #include <QLocale>
-#include <QDebug>
 
 DashboardController::DashboardController(QObject *parent)
     : QObject(parent)
     , m_api(new ApiManager(this))
     , m_isLoading(false)
+    , m_activeRequests(0)
     , m_totalInstructors(0)
     , m_verifiedInstructors(0)
     , m_pendingInstructors(0)
@@ -16,12 +18,31 @@ DashboardController::DashboardController(QObject *parent)
     , m_draftCourses(0)
     , m_totalRevenue(0.0)
     , m_monthlyRevenue(0.0)
+    , m_bootWaiting(0)
 {
     connect(m_api, &ApiManager::dashboardStatsLoaded,
             this, &DashboardController::onStatsLoaded);
     connect(m_api, &ApiManager::dashboardStatsLoadFailed,
             this, &DashboardController::onStatsLoadFailed);
 
+    // Only bootstrap() issues these on this controller's ApiManager; each
+    // part counts once per round (see bootstrap())
+    connect(m_api, &ApiManager::instructorsLoaded,
+            this, &DashboardController::onBootstrapInstructors);
+    connect(m_api, &ApiManager::instructorsLoadFailed, this, [this](const QString &errorMessage) {
+        failBootstrapPart(BootInstructors, errorMessage);
+    });
+    connect(m_api, &ApiManager::dashboardActivityLoaded,
+            this, &DashboardController::onBootstrapActivity);
+    connect(m_api, &ApiManager::dashboardActivityLoadFailed, this, [this](const QString &errorMessage) {
+        failBootstrapPart(BootActivity, errorMessage);
+    });
+    connect(m_api, &ApiManager::notificationsLoaded,
+            this, &DashboardController::onBootstrapNotifications);
+    connect(m_api, &ApiManager::notificationsLoadFailed, this, [this](const QString &errorMessage) {
+        failBootstrapPart(BootNotifications, errorMessage);
+    });
+
     connect(m_api, &ApiManager::requestStarted,
             this, &DashboardController::onRequestStarted);
     connect(m_api, &ApiManager::requestFinished,
@@ -72,10 +93,40 @@ void DashboardController::loadStats()
     m_api->getDashboardStats();
 }
 
+void DashboardController::bootstrap(int activityLimit)
+{
+    // One join at a time
+    if (m_bootWaiting != 0) {
+        return;
+    }
+
+    clearError();
+    m_bootStats = QJsonObject();
+    m_bootInstructors = QJsonObject();
+    m_bootActivity = QJsonObject();
+    m_bootNotifications = QJsonObject();
+    m_bootErrors.clear();
+    m_bootStatsError.clear();
+
+    // The round runs on m_api, so a 401 refreshes the controller's own
+    // token. Each part is taken from the first reply of its kind while it is
+    // outstanding, and later ones are not counted again: a loadStats() reply
+    // carries the same data, so whichever stats reply comes first joins the
+    // round and the other takes the normal path.
+    m_bootWaiting = AllBootstrapParts;
+    emit isBootstrappingChanged();
+
+    // Issued back to back so they share the (HTTP/2) connection
+    m_api->getDashboardStats();
+    m_api->getInstructors("pending");
+    m_api->getDashboardActivity(activityLimit);
+    m_api->getRecentNotifications();
+}
+
 void DashboardController::reloadTokens()
 {
     m_api->loadTokens();
-    qDebug() << "DashboardController: tokens reloaded, logged in:" << m_api->isLoggedIn();
+    qCDebug(lcControllers) << "DashboardController: tokens reloaded, logged in:" << m_api->isLoggedIn();
 }
 
 void DashboardController::clearError()
@@ -84,8 +135,31 @@ void DashboardController::clearError()
 }
 
 
+void DashboardController::restoreSnapshot(const QJsonObject &stats)
+{
+    // Not a reply: never taken as a bootstrap part
+    applyStats(stats);
+    emit statsChanged();
+    emit statsLoaded();
+}
+
 void DashboardController::onStatsLoaded(const QJsonObject &stats)
 {
+    if (m_bootWaiting & BootStats) {
+        m_bootStats = stats;
+        finishBootstrapPart(BootStats);
+        return;
+    }
+
+    applyStats(stats);
+    emit statsChanged();
+    emit statsLoaded();
+}
+
+void DashboardController::applyStats(const QJsonObject &stats)
+{
+    m_lastStats = stats;
+
     QJsonObject instructors = stats["instructors"].toObject();
     m_totalInstructors = instructors["total"].toInt();
     m_verifiedInstructors = instructors["verified"].toInt();
@@ -103,24 +177,125 @@ void DashboardController::onStatsLoaded(const QJsonObject &stats)
     QJsonObject revenue = stats["revenue"].toObject();
     m_totalRevenue = revenue["total"].toDouble();
     m_monthlyRevenue = revenue["thisMonth"].toDouble();
-
-    emit statsChanged();
-    emit statsLoaded();
 }
 
 void DashboardController::onStatsLoadFailed(const QString &errorMessage)
 {
+    if (m_bootWaiting & BootStats) {
+        m_bootStatsError = errorMessage;
+        failBootstrapPart(BootStats, errorMessage);
+        return;
+    }
+
     setError(errorMessage.isEmpty() ?
                  "Failed to load dashboard statistics. Please try again." :
                  errorMessage);
 }
 
+void DashboardController::onBootstrapInstructors(const QJsonObject &data)
+{
+    if (!(m_bootWaiting & BootInstructors)) {
+        return;
+    }
+
+    m_bootInstructors = data;
+    finishBootstrapPart(BootInstructors);
+}
+
+void DashboardController::onBootstrapActivity(const QJsonObject &data)
+{
+    if (!(m_bootWaiting & BootActivity)) {
+        return;
+    }
+
+    m_bootActivity = data;
+    finishBootstrapPart(BootActivity);
+}
+
+void DashboardController::onBootstrapNotifications(const QJsonObject &data)
+{
+    if (!(m_bootWaiting & BootNotifications)) {
+        return;
+    }
+
+    m_bootNotifications = data;
+    finishBootstrapPart(BootNotifications);
+}
+
+void DashboardController::failBootstrapPart(BootstrapPart part, const QString &errorMessage)
+{
+    if (!(m_bootWaiting & part)) {
+        return;
+    }
+
+    m_bootErrors << errorMessage;
+    finishBootstrapPart(part);
+}
+
+void DashboardController::finishBootstrapPart(BootstrapPart part)
+{
+    if (!(m_bootWaiting & part)) {
+        return;
+    }
+
+    m_bootWaiting &= ~part;
+    if (m_bootWaiting == 0) {
+        publishBootstrap();
+        emit isBootstrappingChanged();
+    }
+}
+
+void DashboardController::publishBootstrap()
+{
+    // Parts that failed keep showing their previous values
+    if (!m_bootStats.isEmpty()) {
+        applyStats(m_bootStats);
+    }
+
+    if (!m_bootInstructors.isEmpty()) {
+        QJsonArray instructors = m_bootInstructors["instructors"].toArray();
+        QVariantList pending;
+        for (int i = 0; i < instructors.size() && i < 5; ++i) {
+            pending.append(instructors.at(i).toObject().toVariantMap());
+        }
+
+        int totalPending = m_bootInstructors["stats"].toObject()["pending"].toInt();
+        m_overview["pendingInstructors"] = pending;
+        m_overview["totalPending"] = totalPending > 0 ? totalPending : instructors.size();
+    }
+
+    if (!m_bootActivity.isEmpty()) {
+        m_overview["activities"] = m_bootActivity["activities"].toArray().toVariantList();
+        m_overview["totalActivities"] = m_bootActivity["total"].toInt();
+    }
+
+    if (!m_bootErrors.isEmpty()) {
+        qCWarning(lcControllers) << "DashboardController: bootstrap finished with errors:" << m_bootErrors;
+        if (m_bootStats.isEmpty()) {
+            onStatsLoadFailed(m_bootStatsError);
+        }
+    }
+
+    // Everything below runs before control returns to the event loop, so
+    // QML lays the dashboard out once
+    if (!m_bootNotifications.isEmpty()) {
+        emit recentNotificationsBootstrapped(m_bootNotifications);
+    }
+    emit overviewChanged();
+    if (!m_bootStats.isEmpty()) {
+        emit statsChanged();
+        emit statsLoaded();
+    }
+}
+
 void DashboardController::onRequestStarted()
 {
+    ++m_activeRequests;
     setLoading(true);
 }
 
 void DashboardController::onRequestFinished()
 {
-    setLoading(false);
+    m_activeRequests = qMax(0, m_activeRequests - 1);
+    setLoading(m_activeRequests > 0);
 }
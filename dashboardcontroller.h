@@ -3,6 +3,8 @@
 
 #include <QObject>
 #include <QJsonObject>
+#include <QStringList>
+#include <QVariantMap>
 #include "apimanager.h"
 
 class DashboardController : public QObject
@@ -28,6 +30,11 @@ class DashboardController : public QObject
     Q_PROPERTY(QString formattedTotalRevenue READ formattedTotalRevenue NOTIFY statsChanged)
     Q_PROPERTY(QString formattedMonthlyRevenue READ formattedMonthlyRevenue NOTIFY statsChanged)
 
+    // Everything bootstrap() joined besides the stats: pendingInstructors
+    // (first five), totalPending, activities, totalActivities
+    Q_PROPERTY(QVariantMap overview READ overview NOTIFY overviewChanged)
+    Q_PROPERTY(bool isBootstrapping READ isBootstrapping NOTIFY isBootstrappingChanged)
+
 public:
     explicit DashboardController(QObject *parent = nullptr);
     ~DashboardController();
@@ -51,20 +58,37 @@ public:
     QString formattedTotalRevenue() const;
     QString formattedMonthlyRevenue() const;
 
+    QVariantMap overview() const { return m_overview; }
+    bool isBootstrapping() const { return m_bootWaiting != 0; }
+
     Q_INVOKABLE void loadStats();
+    // Requests stats, pending instructors, recent activity and recent
+    // notifications together and publishes them in one update once all
+    // four have answered
+    Q_INVOKABLE void bootstrap(int activityLimit = 10);
     Q_INVOKABLE void clearError();
     Q_INVOKABLE void reloadTokens();
 
+    QJsonObject snapshot() const { return m_lastStats; }
+    void restoreSnapshot(const QJsonObject &stats);
+
 signals:
     void isLoadingChanged();
     void errorMessageChanged();
     void statsChanged();
+    void overviewChanged();
+    void isBootstrappingChanged();
 
     void statsLoaded();
+    // Recent-notifications payload from bootstrap(), for NotificationController
+    void recentNotificationsBootstrapped(const QJsonObject &data);
 
 private slots:
     void onStatsLoaded(const QJsonObject &stats);
     void onStatsLoadFailed(const QString &errorMessage);
+    void onBootstrapInstructors(const QJsonObject &data);
+    void onBootstrapActivity(const QJsonObject &data);
+    void onBootstrapNotifications(const QJsonObject &data);
     void onRequestStarted();
     void onRequestFinished();
 
@@ -72,6 +96,7 @@ private:
     ApiManager *m_api;
 
     bool m_isLoading;
+    int m_activeRequests;
     QString m_errorMessage;
 
     int m_totalInstructors;
@@ -88,6 +113,30 @@ private:
     double m_totalRevenue;
     double m_monthlyRevenue;
 
+    QJsonObject m_lastStats;
+    QVariantMap m_overview;
+
+    enum BootstrapPart {
+        BootStats = 0x1,
+        BootInstructors = 0x2,
+        BootActivity = 0x4,
+        BootNotifications = 0x8,
+        AllBootstrapParts = 0xf
+    };
+
+    // Joined bootstrap results; empty objects for parts that failed
+    int m_bootWaiting;               // BootstrapPart bits still outstanding
+    QJsonObject m_bootStats;
+    QJsonObject m_bootInstructors;
+    QJsonObject m_bootActivity;
+    QJsonObject m_bootNotifications;
+    QStringList m_bootErrors;
+    QString m_bootStatsError;
+
+    void applyStats(const QJsonObject &stats);
+    void failBootstrapPart(BootstrapPart part, const QString &errorMessage);
+    void finishBootstrapPart(BootstrapPart part);
+    void publishBootstrap();
     void setLoading(bool loading);
     void setError(const QString &error);
     QString formatCurrency(double amount) const;
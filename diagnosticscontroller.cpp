@@ -0,0 +1,254 @@
+#include "diagnosticscontroller.h"
+#include "apimetrics.h"
+#include "harlog.h"
+#include "memoryreport.h"
+#include "remoteimageprovider.h"
+#include "logging.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaProperty>
+#include <QQmlEngine>
+#include <QQuickWindow>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+
+DiagnosticsController::DiagnosticsController(QObject *parent)
+    : QObject(parent)
+    , m_totalResponses(0)
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    m_dumpPath = QDir(dir).filePath("api-metrics.json");
+
+    int interval = qEnvironmentVariableIntValue("LUMIN_METRICS_DUMP_SECS");
+    m_dumpTimer.setInterval((interval > 0 ? interval : 300) * 1000);
+    connect(&m_dumpTimer, &QTimer::timeout, this, &DiagnosticsController::dumpNow);
+    m_dumpTimer.start();
+}
+
+DiagnosticsController::~DiagnosticsController()
+{
+}
+
+void DiagnosticsController::setDumpIntervalSeconds(int seconds)
+{
+    seconds = qMax(10, seconds);
+    if (seconds != dumpIntervalSeconds()) {
+        m_dumpTimer.start(seconds * 1000);
+        emit dumpIntervalSecondsChanged();
+    }
+}
+
+QVariantMap DiagnosticsController::snapshot() const
+{
+    return ApiMetrics::instance()->snapshot().toVariantMap();
+}
+
+void DiagnosticsController::refresh()
+{
+    QJsonObject endpoints = ApiMetrics::instance()->snapshot();
+
+    QVariantList rows;
+    int totalResponses = 0;
+    for (auto it = endpoints.constBegin(); it != endpoints.constEnd(); ++it) {
+        QJsonObject entry = it.value().toObject();
+        QJsonObject total = entry["totalMs"].toObject();
+        QJsonObject ttfb = entry["ttfbMs"].toObject();
+
+        int errors = 0;
+        QJsonObject errorCodes = entry["errors"].toObject();
+        for (const QJsonValue &count : errorCodes) {
+            errors += count.toInt();
+        }
+
+        QVariantMap row;
+        row["endpoint"] = it.key();
+        row["responses"] = entry["responses"].toInt();
+        row["p50"] = qRound(total["p50"].toDouble());
+        row["p95"] = qRound(total["p95"].toDouble());
+        row["p99"] = qRound(total["p99"].toDouble());
+        row["ttfbP50"] = qRound(ttfb["p50"].toDouble());
+        row["errors"] = errors;
+        row["retries"] = entry["retries"].toInt();
+        row["kibIn"] = entry["bodyBytes"].toDouble() / 1024.0;
+        rows.append(row);
+
+        totalResponses += entry["responses"].toInt();
+    }
+
+    // Slowest first
+    std::sort(rows.begin(), rows.end(), [](const QVariant &a, const QVariant &b) {
+        return a.toMap()["p95"].toInt() > b.toMap()["p95"].toInt();
+    });
+
+    m_endpoints = rows;
+    m_totalResponses = totalResponses;
+    emit metricsChanged();
+}
+
+bool DiagnosticsController::dumpNow()
+{
+    QJsonObject dump;
+    dump["generatedAt"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+    dump["endpoints"] = ApiMetrics::instance()->snapshot();
+
+    QDir().mkpath(QFileInfo(m_dumpPath).absolutePath());
+
+    QSaveFile file(m_dumpPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(lcControllers) << "DiagnosticsController: cannot write" << m_dumpPath << file.errorString();
+        return false;
+    }
+
+    file.write(QJsonDocument(dump).toJson(QJsonDocument::Indented));
+    return file.commit();
+}
+
+void DiagnosticsController::reset()
+{
+    ApiMetrics::instance()->reset();
+    refresh();
+}
+
+QString DiagnosticsController::exportHar(int minutes)
+{
+    QJsonObject har = HarLog::instance()->toHar(qMax(1, minutes));
+
+    QString name = QString("network-%1.har")
+                       .arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss"));
+    QString path = QFileInfo(m_dumpPath).absoluteDir().filePath(name);
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(lcControllers) << "DiagnosticsController: cannot write" << path << file.errorString();
+        return QString();
+    }
+
+    file.write(QJsonDocument(har).toJson(QJsonDocument::Indented));
+    if (!file.commit()) {
+        qCWarning(lcControllers) << "DiagnosticsController: cannot write" << path << file.errorString();
+        return QString();
+    }
+
+    qCInfo(lcControllers) << "Exported" << har["log"].toObject()["entries"].toArray().size()
+                          << "requests to" << path;
+    return path;
+}
+
+void DiagnosticsController::setMemorySources(QQmlEngine *engine, RemoteImageLoader *imageLoader,
+                                             const QList<QObject *> &controllers)
+{
+    m_engine = engine;
+    m_imageLoader = imageLoader;
+    m_controllers.clear();
+    for (QObject *controller : controllers) {
+        m_controllers.append(controller);
+    }
+}
+
+void DiagnosticsController::refreshMemory()
+{
+    QVariantList models;
+    qint64 modelBytes = 0;
+    for (const QPointer<QObject> &controller : std::as_const(m_controllers)) {
+        if (!controller) {
+            continue;
+        }
+
+        const QMetaObject *meta = controller->metaObject();
+        for (int i = QObject::staticMetaObject.propertyCount(); i < meta->propertyCount(); ++i) {
+            QMetaProperty property = meta->property(i);
+            int type = property.typeId();
+            if (type != QMetaType::QVariantList && type != QMetaType::QVariantMap
+                && type != QMetaType::QStringList) {
+                continue;
+            }
+
+            // Reading the property shares the controller's data, no copy
+            QVariant value = property.read(controller);
+            qint64 bytes = MemoryReport::estimateBytes(value);
+            int rows = type == QMetaType::QVariantMap ? int(value.toMap().size())
+                                                      : int(value.toList().size());
+
+            QVariantMap row;
+            row["name"] = QString::fromLatin1(meta->className()) + "." + QString::fromLatin1(property.name());
+            row["rows"] = rows;
+            row["bytes"] = bytes;
+            models.append(row);
+            modelBytes += bytes;
+        }
+    }
+
+    std::sort(models.begin(), models.end(), [](const QVariant &a, const QVariant &b) {
+        return a.toMap()["bytes"].toLongLong() > b.toMap()["bytes"].toLongLong();
+    });
+
+    QVariantList caches;
+    qint64 cacheBytes = 0;
+    if (m_imageLoader) {
+        RemoteImageLoader::CacheStats images = m_imageLoader->cacheStats();
+        QVariantMap row;
+        row["name"] = "Decoded images";
+        row["entries"] = images.entries;
+        row["bytes"] = images.bytes;
+        row["limitBytes"] = images.maxBytes;
+        row["diskBytes"] = images.diskBytes;
+        caches.append(row);
+        cacheBytes += images.bytes;
+    }
+
+    QVariantMap har;
+    har["name"] = "Network trace (HAR)";
+    har["entries"] = HarLog::instance()->entryCount();
+    har["bytes"] = HarLog::instance()->approximateBytes();
+    caches.append(har);
+    cacheBytes += har["bytes"].toLongLong();
+
+    QVariantMap memory;
+    memory["residentBytes"] = MemoryReport::residentBytes();
+    memory["models"] = models;
+    memory["modelBytes"] = modelBytes;
+    memory["caches"] = caches;
+    memory["cacheBytes"] = cacheBytes;
+    memory["measuredAt"] = QDateTime::currentDateTime();
+
+    m_memory = memory;
+    emit memoryChanged();
+}
+
+QVariantMap DiagnosticsController::trimCaches()
+{
+    qint64 before = MemoryReport::residentBytes();
+
+    if (m_imageLoader) {
+        m_imageLoader->trimMemoryCache();
+    }
+    if (m_engine) {
+        m_engine->trimComponentCache();
+        m_engine->collectGarbage();
+    }
+    const auto windows = QGuiApplication::topLevelWindows();
+    for (QWindow *window : windows) {
+        if (auto *quickWindow = qobject_cast<QQuickWindow *>(window)) {
+            quickWindow->releaseResources();
+        }
+    }
+    MemoryReport::releaseFreeHeap();
+
+    qint64 after = MemoryReport::residentBytes();
+    qCInfo(lcControllers) << "Trimmed caches: resident" << before / 1024 << "KiB ->" << after / 1024 << "KiB";
+
+    refreshMemory();
+
+    QVariantMap result;
+    result["residentBeforeBytes"] = before;
+    result["residentAfterBytes"] = after;
+    result["releasedBytes"] = before >= 0 && after >= 0 ? qMax<qint64>(0, before - after) : 0;
+    return result;
+}
@@ -0,0 +1,84 @@
+#ifndef DIAGNOSTICSCONTROLLER_H
+#define DIAGNOSTICSCONTROLLER_H
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+#include <QVariantList>
+#include <QVariantMap>
+
+// QML view of ApiMetrics. endpoints is a table of per-endpoint latency
+// percentiles for the settings page, refreshed on demand; snapshot()
+// returns the full registry. The registry is also written to dumpPath
+// every dumpIntervalSeconds and on exit, so numbers from a user's machine
+// can be collected without a debugger. exportHar() writes the recent
+// requests themselves (HarLog) for browser network tooling.
+//
+// memory estimates what the list models and caches hold (MemoryReport)
+// next to the process resident size. The QML/JS heap has no public size
+// API, so it is only visible inside the resident size; trimCaches() runs
+// the garbage collector along with emptying the caches and reports how
+// much resident memory that gave back.
+class QQmlEngine;
+class RemoteImageLoader;
+
+class DiagnosticsController : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QVariantList endpoints READ endpoints NOTIFY metricsChanged)
+    Q_PROPERTY(int totalResponses READ totalResponses NOTIFY metricsChanged)
+    Q_PROPERTY(QString dumpPath READ dumpPath CONSTANT)
+    Q_PROPERTY(int dumpIntervalSeconds READ dumpIntervalSeconds WRITE setDumpIntervalSeconds NOTIFY dumpIntervalSecondsChanged)
+    Q_PROPERTY(QVariantMap memory READ memory NOTIFY memoryChanged)
+
+public:
+    explicit DiagnosticsController(QObject *parent = nullptr);
+    ~DiagnosticsController();
+
+    QVariantList endpoints() const { return m_endpoints; }
+    int totalResponses() const { return m_totalResponses; }
+    QString dumpPath() const { return m_dumpPath; }
+    int dumpIntervalSeconds() const { return m_dumpTimer.interval() / 1000; }
+    void setDumpIntervalSeconds(int seconds);
+    QVariantMap memory() const { return m_memory; }
+
+    // What memory() reports on: every QVariantList / QVariantMap /
+    // QStringList property of the controllers, and the image cache
+    void setMemorySources(QQmlEngine *engine, RemoteImageLoader *imageLoader,
+                          const QList<QObject *> &controllers);
+
+    Q_INVOKABLE QVariantMap snapshot() const;
+    Q_INVOKABLE void refresh();
+    Q_INVOKABLE bool dumpNow();
+    Q_INVOKABLE void reset();
+    // Writes the last `minutes` of API traffic as a HAR file next to the
+    // metrics dump; returns its path, or an empty string on failure
+    Q_INVOKABLE QString exportHar(int minutes = 15);
+
+    Q_INVOKABLE void refreshMemory();
+    // Empties the image cache, trims the QML component cache, collects JS
+    // garbage and releases scene graph resources; returns resident bytes
+    // before and after
+    Q_INVOKABLE QVariantMap trimCaches();
+
+signals:
+    void metricsChanged();
+    void dumpIntervalSecondsChanged();
+    void memoryChanged();
+
+private:
+    QVariantList m_endpoints;
+    int m_totalResponses;
+    QString m_dumpPath;
+    QTimer m_dumpTimer;
+
+    QPointer<QQmlEngine> m_engine;
+    QPointer<RemoteImageLoader> m_imageLoader;
+    QList<QPointer<QObject>> m_controllers;
+    QVariantMap m_memory;
+};
+
+#endif // DIAGNOSTICSCONTROLLER_H
@@ -0,0 +1,263 @@
+#include "exportjob.h"
+#include "logging.h"
+#include <QFileInfo>
+#include <QJsonDocument>
+
+ExportJob::ExportJob(Kind kind, const QString &filePath, QObject *parent)
+    : QObject(parent)
+    , m_kind(kind)
+    , m_format(formatForPath(filePath))
+    , m_filePath(filePath)
+    , m_file(filePath)
+    , m_pageSize(100)
+    , m_maxInFlight(4)
+    , m_running(false)
+    , m_totalPages(0)
+    , m_nextToRequest(1)
+    , m_nextToWrite(1)
+    , m_rowsWritten(0)
+{
+}
+
+ExportJob::~ExportJob()
+{
+    if (m_running) {
+        m_file.cancelWriting();
+    }
+}
+
+void ExportJob::setFilters(const QString &status, const QString &search)
+{
+    m_status = status;
+    m_search = search;
+}
+
+double ExportJob::progress() const
+{
+    if (m_totalPages <= 0) {
+        return 0.0;
+    }
+    return double(pagesWritten()) / m_totalPages;
+}
+
+ExportJob::Format ExportJob::formatForPath(const QString &filePath)
+{
+    QString suffix = QFileInfo(filePath).suffix().toLower();
+    return (suffix == "jsonl" || suffix == "ndjson") ? JsonLines : Csv;
+}
+
+void ExportJob::start()
+{
+    if (m_running) {
+        return;
+    }
+
+    if (!m_file.open(QIODevice::WriteOnly)) {
+        finish(false, QString("Cannot write %1: %2").arg(m_filePath, m_file.errorString()));
+        return;
+    }
+
+    m_running = true;
+
+    if (m_format == Csv) {
+        QStringList header;
+        for (const QString &column : csvColumns()) {
+            header << QString(csvEscape(column));
+        }
+        m_file.write(header.join(',').toUtf8() + "\n");
+    }
+
+    qCDebug(lcNetwork) << "Export: started" << m_filePath;
+
+    // The page count is only known once page 1 has arrived
+    requestPage(m_nextToRequest++);
+}
+
+void ExportJob::cancel()
+{
+    if (!m_running) {
+        return;
+    }
+
+    finish(false, "Export cancelled");
+}
+
+ApiManager *ExportJob::idleWorker()
+{
+    for (ApiManager *worker : std::as_const(m_workers)) {
+        if (!m_inFlight.contains(worker)) {
+            return worker;
+        }
+    }
+
+    ApiManager *worker = new ApiManager(this);
+    if (m_kind == Transactions) {
+        connect(worker, &ApiManager::transactionsLoaded, this, &ExportJob::onPageLoaded);
+        connect(worker, &ApiManager::transactionsLoadFailed, this, &ExportJob::onPageFailed);
+    } else {
+        connect(worker, &ApiManager::studentsLoaded, this, &ExportJob::onPageLoaded);
+        connect(worker, &ApiManager::studentsLoadFailed, this, &ExportJob::onPageFailed);
+    }
+    m_workers.append(worker);
+    return worker;
+}
+
+void ExportJob::requestPage(int page)
+{
+    ApiManager *worker = idleWorker();
+    m_inFlight.insert(worker, page);
+
+    if (m_kind == Transactions) {
+        worker->getTransactions(page, m_pageSize, m_status, m_search);
+    } else {
+        worker->getStudents(m_status, m_search, page, m_pageSize);
+    }
+}
+
+void ExportJob::fillWindow()
+{
+    while (m_nextToRequest <= m_totalPages && m_inFlight.size() < m_maxInFlight) {
+        requestPage(m_nextToRequest++);
+    }
+}
+
+void ExportJob::onPageLoaded(const QJsonObject &data)
+{
+    if (!m_running) {
+        return;
+    }
+
+    ApiManager *worker = qobject_cast<ApiManager *>(sender());
+    if (!m_inFlight.contains(worker)) {
+        return;
+    }
+    int page = m_inFlight.take(worker);
+
+    // Unpaginated responses carry every row on page 1
+    QJsonObject pagination = data["pagination"].toObject();
+    if (m_totalPages == 0) {
+        m_totalPages = pagination.isEmpty() ? 1 : qMax(1, pagination["pages"].toInt(1));
+    }
+
+    m_pending.insert(page, data[rowsKey()].toArray());
+
+    while (!m_pending.isEmpty() && m_pending.firstKey() == m_nextToWrite) {
+        writePage(m_pending.take(m_nextToWrite));
+        ++m_nextToWrite;
+    }
+
+    emit progressChanged();
+
+    if (m_nextToWrite > m_totalPages) {
+        if (!m_file.commit()) {
+            m_running = false;
+            finish(false, QString("Cannot write %1: %2").arg(m_filePath, m_file.errorString()));
+            return;
+        }
+        m_running = false;
+        finish(true, QString("Exported %1 rows to %2").arg(m_rowsWritten).arg(m_filePath));
+        return;
+    }
+
+    fillWindow();
+}
+
+void ExportJob::onPageFailed(const QString &errorMessage)
+{
+    if (!m_running || !m_inFlight.contains(qobject_cast<ApiManager *>(sender()))) {
+        return;
+    }
+
+    finish(false, errorMessage.isEmpty() ? "Export failed. Please try again." : errorMessage);
+}
+
+void ExportJob::writePage(const QJsonArray &rows)
+{
+    // Rows that shift to the next page while the export runs (new orders
+    // arriving) may appear twice; none are skipped.
+    QByteArray chunk;
+    const QStringList columns = csvColumns();
+
+    for (const QJsonValue &value : rows) {
+        QJsonObject row = value.toObject();
+
+        if (m_format == JsonLines) {
+            chunk += QJsonDocument(row).toJson(QJsonDocument::Compact);
+        } else {
+            for (int i = 0; i < columns.size(); ++i) {
+                if (i > 0) {
+                    chunk += ',';
+                }
+                chunk += csvEscape(csvValue(row, columns.at(i)));
+            }
+        }
+        chunk += '\n';
+    }
+
+    m_file.write(chunk);
+    m_rowsWritten += rows.size();
+}
+
+void ExportJob::finish(bool success, const QString &message)
+{
+    if (m_running) {
+        m_file.cancelWriting();
+        m_running = false;
+    }
+
+    m_inFlight.clear();
+    m_pending.clear();
+
+    qCDebug(lcNetwork) << "Export:" << message;
+    emit finished(success, message);
+}
+
+QString ExportJob::rowsKey() const
+{
+    return m_kind == Transactions ? "transactions" : "students";
+}
+
+QStringList ExportJob::csvColumns() const
+{
+    if (m_kind == Transactions) {
+        return {"orderId", "orderNumber", "createdAt", "status", "paymentMethod",
+                "amount", "student.name", "student.email", "courses"};
+    }
+    return {"id", "firstName", "lastName", "email", "isActive", "createdAt"};
+}
+
+QString ExportJob::csvValue(const QJsonObject &row, const QString &column) const
+{
+    if (column == "courses") {
+        QStringList titles;
+        for (const QJsonValue &course : row["courses"].toArray()) {
+            titles << course.toObject()["title"].toString();
+        }
+        return titles.join("; ");
+    }
+
+    QJsonValue value = row;
+    for (const QString &key : column.split('.')) {
+        value = value.toObject().value(key);
+    }
+
+    switch (value.type()) {
+    case QJsonValue::Double:
+        return QString::number(value.toDouble(), 'g', 15);
+    case QJsonValue::Bool:
+        return value.toBool() ? "true" : "false";
+    default:
+        return value.toString();
+    }
+}
+
+QByteArray ExportJob::csvEscape(const QString &value)
+{
+    QByteArray bytes = value.toUtf8();
+    if (!bytes.contains(',') && !bytes.contains('"') && !bytes.contains('\n') && !bytes.contains('\r')) {
+        return bytes;
+    }
+
+    bytes.replace('"', "\"\"");
+    return '"' + bytes + '"';
+}
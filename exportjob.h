@@ -0,0 +1,99 @@
+#ifndef EXPORTJOB_H
+#define EXPORTJOB_H
+
+#include <QHash>
+#include <QJsonArray>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QSaveFile>
+#include <QStringList>
+#include "apimanager.h"
+
+// Walks every page of /api/transactions or /api/students and streams the rows
+// to a CSV or JSONL file. Page 1 is fetched alone to learn the page count,
+// then up to maxInFlight pages are requested at a time; pages that arrive
+// out of order wait in a small buffer until their predecessors are written,
+// so at most maxInFlight pages are held in memory whatever the export size.
+// Each page in flight has its own ApiManager, so a reply is matched to the
+// page that was asked for, not to the page number the server echoes back
+// (which it may clamp, drop or send as a string).
+//
+// The file is written through QSaveFile and only replaces the target once
+// every page has been written; cancel() or a failed page leaves it untouched.
+class ExportJob : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Kind {
+        Transactions,
+        Students
+    };
+
+    enum Format {
+        Csv,
+        JsonLines
+    };
+
+    ExportJob(Kind kind, const QString &filePath, QObject *parent = nullptr);
+    ~ExportJob();
+
+    // Filters are forwarded to every page request
+    void setFilters(const QString &status, const QString &search);
+    void setPageSize(int pageSize) { m_pageSize = pageSize; }
+    void setMaxInFlight(int maxInFlight) { m_maxInFlight = qMax(1, maxInFlight); }
+
+    bool isRunning() const { return m_running; }
+    Format format() const { return m_format; }
+    QString filePath() const { return m_filePath; }
+    int rowsWritten() const { return m_rowsWritten; }
+    int pagesWritten() const { return m_nextToWrite - 1; }
+    int totalPages() const { return m_totalPages; }
+    double progress() const;
+
+    static Format formatForPath(const QString &filePath);
+
+public slots:
+    void start();
+    void cancel();
+
+signals:
+    void progressChanged();
+    void finished(bool success, const QString &message);
+
+private slots:
+    void onPageLoaded(const QJsonObject &data);
+    void onPageFailed(const QString &errorMessage);
+
+private:
+    ApiManager *idleWorker();
+    void requestPage(int page);
+    void fillWindow();
+    void writePage(const QJsonArray &rows);
+    void finish(bool success, const QString &message);
+    QString rowsKey() const;
+    QStringList csvColumns() const;
+    QString csvValue(const QJsonObject &row, const QString &column) const;
+    static QByteArray csvEscape(const QString &value);
+
+    Kind m_kind;
+    Format m_format;
+    QString m_filePath;
+    QSaveFile m_file;
+    QString m_status;
+    QString m_search;
+    int m_pageSize;
+    int m_maxInFlight;
+
+    bool m_running;
+    int m_totalPages;           // 0 until page 1 has arrived
+    int m_nextToRequest;
+    int m_nextToWrite;
+    int m_rowsWritten;
+    QList<ApiManager *> m_workers;      // at most maxInFlight, kept for the job
+    QHash<ApiManager *, int> m_inFlight;   // worker -> page it was asked for
+    QMap<int, QJsonArray> m_pending;   // arrived ahead of m_nextToWrite
+};
+
+#endif // EXPORTJOB_H
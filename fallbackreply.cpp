@@ -0,0 +1,145 @@
+#include "fallbackreply.h"
+#include <QSslConfiguration>
+#include <cstring>
+
+FallbackReply::FallbackReply(const QNetworkRequest &request, QNetworkReply *attempt, Reissue reissue,
+                             QObject *parent)
+    : QNetworkReply(parent)
+    , m_reissue(std::move(reissue))
+    , m_reissued(false)
+    , m_offset(0)
+{
+    setOperation(QNetworkAccessManager::GetOperation);
+    setRequest(request);
+    setUrl(request.url());
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+    attach(attempt);
+}
+
+FallbackReply::~FallbackReply()
+{
+    if (m_attempt) {
+        m_attempt->disconnect(this);
+        m_attempt->abort();
+        m_attempt->deleteLater();
+    }
+}
+
+void FallbackReply::attach(QNetworkReply *attempt)
+{
+    m_attempt = attempt;
+
+    connect(attempt, &QNetworkReply::metaDataChanged, this, [this]() {
+        copyMetaData();
+        emit metaDataChanged();
+    });
+    connect(attempt, &QNetworkReply::socketStartedConnecting, this, &QNetworkReply::socketStartedConnecting);
+    connect(attempt, &QNetworkReply::requestSent, this, &QNetworkReply::requestSent);
+    connect(attempt, &QNetworkReply::encrypted, this, &QNetworkReply::encrypted);
+    connect(attempt, &QNetworkReply::sslErrors, this, &QNetworkReply::sslErrors);
+    connect(attempt, &QNetworkReply::downloadProgress, this, &QNetworkReply::downloadProgress);
+    connect(attempt, &QNetworkReply::uploadProgress, this, &QNetworkReply::uploadProgress);
+    connect(attempt, &QNetworkReply::finished, this, &FallbackReply::onAttemptFinished);
+}
+
+void FallbackReply::onAttemptFinished()
+{
+    QNetworkReply *attempt = m_attempt;
+    if (!attempt || isFinished()) {
+        return;
+    }
+
+    if (attempt->error() == ProtocolFailure && !m_reissued) {
+        m_reissued = true;
+        attempt->disconnect(this);
+        attempt->deleteLater();
+        attach(m_reissue(attempt));
+        return;
+    }
+
+    copyMetaData();
+    m_body = attempt->readAll();
+
+    NetworkError error = attempt->error();
+    if (error != NoError) {
+        setError(error, attempt->errorString());
+    }
+    setFinished(true);
+
+    if (!m_body.isEmpty()) {
+        emit readyRead();
+    }
+    if (error != NoError) {
+        emit errorOccurred(error);
+    }
+    emit finished();
+}
+
+void FallbackReply::copyMetaData()
+{
+    static const QNetworkRequest::Attribute attributes[] = {
+        QNetworkRequest::HttpStatusCodeAttribute,
+        QNetworkRequest::HttpReasonPhraseAttribute,
+        QNetworkRequest::Http2WasUsedAttribute,
+        QNetworkRequest::SourceIsFromCacheAttribute,
+        QNetworkRequest::RedirectionTargetAttribute,
+        QNetworkRequest::ConnectionEncryptedAttribute,
+        QNetworkRequest::OriginalContentLengthAttribute,
+    };
+    for (QNetworkRequest::Attribute attribute : attributes) {
+        QVariant value = m_attempt->attribute(attribute);
+        if (value.isValid()) {
+            setAttribute(attribute, value);
+        }
+    }
+
+    const auto headers = m_attempt->rawHeaderPairs();
+    for (const auto &header : headers) {
+        setRawHeader(header.first, header.second);
+    }
+    setUrl(m_attempt->url());
+}
+
+void FallbackReply::abort()
+{
+    if (isFinished()) {
+        return;
+    }
+
+    // The attempt finishes with OperationCanceledError, and so do we
+    if (m_attempt) {
+        m_attempt->abort();
+    }
+}
+
+void FallbackReply::ignoreSslErrors()
+{
+    if (m_attempt) {
+        m_attempt->ignoreSslErrors();
+    }
+}
+
+void FallbackReply::sslConfigurationImplementation(QSslConfiguration &configuration) const
+{
+    if (m_attempt) {
+        configuration = m_attempt->sslConfiguration();
+    }
+}
+
+qint64 FallbackReply::bytesAvailable() const
+{
+    return m_body.size() - m_offset + QNetworkReply::bytesAvailable();
+}
+
+qint64 FallbackReply::readData(char *data, qint64 maxSize)
+{
+    qint64 count = qMin(maxSize, m_body.size() - m_offset);
+    if (count <= 0) {
+        return isFinished() ? -1 : 0;
+    }
+
+    std::memcpy(data, m_body.constData() + m_offset, size_t(count));
+    m_offset += count;
+    return count;
+}
@@ -0,0 +1,49 @@
+#ifndef FALLBACKREPLY_H
+#define FALLBACKREPLY_H
+
+#include <QByteArray>
+#include <QNetworkReply>
+#include <QPointer>
+#include <functional>
+
+// GET over HTTP/2 that is sent again once, over HTTP/1.1, when the h2
+// connection fails with a ProtocolFailure. ApiNetworkManager hands this to
+// the caller in place of the real reply; the caller only sees the attempt
+// that counted. Progress, connection and TLS signals are forwarded as they
+// happen; the body is delivered when the final attempt finishes.
+class FallbackReply : public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    // Called with the failed attempt; returns the HTTP/1.1 attempt
+    using Reissue = std::function<QNetworkReply *(QNetworkReply *failed)>;
+
+    FallbackReply(const QNetworkRequest &request, QNetworkReply *attempt, Reissue reissue,
+                  QObject *parent = nullptr);
+    ~FallbackReply();
+
+    void abort() override;
+    qint64 bytesAvailable() const override;
+    bool isSequential() const override { return true; }
+
+public slots:
+    void ignoreSslErrors() override;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    void sslConfigurationImplementation(QSslConfiguration &configuration) const override;
+
+private:
+    void attach(QNetworkReply *attempt);
+    void onAttemptFinished();
+    void copyMetaData();
+
+    QPointer<QNetworkReply> m_attempt;
+    Reissue m_reissue;
+    bool m_reissued;
+    QByteArray m_body;
+    qint64 m_offset;
+};
+
+#endif // FALLBACKREPLY_H
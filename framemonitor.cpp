@@ -0,0 +1,298 @@
+#include "framemonitor.h"
+#include "logging.h"
+#include "startuptrace.h"
+#include <QMetaMethod>
+#include <QMutexLocker>
+#include <QQuickWindow>
+#include <QScreen>
+#include <QThread>
+
+namespace {
+
+const int MaxLongFrames = 50;
+const int MaxEventsPerFrame = 8;
+
+// A note this old when the next frame starts is not reported with it; its
+// handler finished without changing anything on screen
+const qint64 MaxNoteAgeUs = 2000 * 1000;
+
+} // namespace
+
+FrameMonitor::FrameMonitor(QObject *parent)
+    : QObject(parent)
+    , m_window(nullptr)
+    , m_intervalMs(1000.0 / 60.0)
+    , m_stallStartUs(-1)
+    , m_animatingUs(-1)
+    , m_frameStartUs(-1)
+    , m_frames(0)
+    , m_dropped(0)
+    , m_lastMs(0.0)
+    , m_fps(0.0)
+    , m_lastFrameMs(0.0)
+    , m_p95FrameMs(0.0)
+    , m_totalFrames(0)
+    , m_droppedFrames(0)
+{
+    m_statsTimer.setInterval(500);
+    connect(&m_statsTimer, &QTimer::timeout, this, &FrameMonitor::publishStats);
+
+    if (qEnvironmentVariableIntValue("LUMIN_FRAME_OVERLAY") != 0) {
+        m_statsTimer.start();
+    }
+}
+
+FrameMonitor *FrameMonitor::instance()
+{
+    static FrameMonitor monitor;
+    return &monitor;
+}
+
+void FrameMonitor::attachWindow(QQuickWindow *window)
+{
+    m_window = window;
+
+    if (QScreen *screen = window->screen()) {
+        if (screen->refreshRate() > 1.0) {
+            m_intervalMs = 1000.0 / screen->refreshRate();
+        }
+    }
+
+    // afterAnimating is emitted on the GUI thread, beforeSynchronizing and
+    // frameSwapped on the render thread (the same thread with the basic
+    // render loop)
+    connect(window, &QQuickWindow::afterAnimating, this,
+            &FrameMonitor::onAfterAnimating, Qt::DirectConnection);
+    connect(window, &QQuickWindow::beforeSynchronizing, this,
+            &FrameMonitor::onBeforeSynchronizing, Qt::DirectConnection);
+    connect(window, &QQuickWindow::frameSwapped, this,
+            &FrameMonitor::onFrameSwapped, Qt::DirectConnection);
+}
+
+void FrameMonitor::note(const QString &what)
+{
+    instance()->addNote(what);
+}
+
+void FrameMonitor::addNote(const QString &what)
+{
+    // Only work on the GUI thread can delay a frame
+    if (!m_window || QThread::currentThread() != m_window->thread()) {
+        return;
+    }
+
+    qint64 now = StartupTrace::instance()->elapsedUs();
+
+    // The first note opens a stall; it closes when the event loop gets
+    // control back and runs the queued call
+    if (m_stallStartUs < 0) {
+        m_stallStartUs = now;
+        m_stallEvents.clear();
+        QMetaObject::invokeMethod(this, &FrameMonitor::onEventLoopReturned, Qt::QueuedConnection);
+    }
+    if (m_stallEvents.size() < MaxEventsPerFrame && !m_stallEvents.contains(what)) {
+        m_stallEvents.append(what);
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_pending.append({now, what});
+}
+
+void FrameMonitor::onEventLoopReturned()
+{
+    if (m_stallStartUs < 0) {
+        return;
+    }
+
+    qint64 now = StartupTrace::instance()->elapsedUs();
+    qint64 startUs = m_stallStartUs;
+    double ms = (now - startUs) / 1000.0;
+    QStringList events = m_stallEvents;
+    m_stallStartUs = -1;
+    m_stallEvents.clear();
+
+    if (ms <= 2 * m_intervalMs) {
+        return;
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_dropped += int(ms / m_intervalMs);
+        m_recentLong.append({startUs, ms, events, true});
+        if (m_recentLong.size() > MaxLongFrames) {
+            m_recentLong.removeFirst();
+        }
+    }
+
+    qCDebug(lcApp) << "GUI thread blocked" << ms << "ms by" << events;
+
+    QVariantMap args;
+    args["events"] = events;
+    StartupTrace::instance()->addCompleteEvent(QStringLiteral("gui stall"), QStringLiteral("frame"),
+                                               startUs, now - startUs, args);
+}
+
+void FrameMonitor::watchSignals(QObject *object)
+{
+    static const int slotIndex = staticMetaObject.indexOfSlot("onWatchedSignal()");
+
+    const QMetaObject *meta = object->metaObject();
+    for (int i = QObject::staticMetaObject.methodCount(); i < meta->methodCount(); ++i) {
+        QMetaMethod method = meta->method(i);
+        if (method.methodType() == QMetaMethod::Signal && method.name().endsWith("Changed")
+            && !method.name().startsWith("isLoading")) {
+            QMetaObject::connect(object, i, this, slotIndex);
+        }
+    }
+}
+
+void FrameMonitor::onWatchedSignal()
+{
+    QObject *object = sender();
+    if (!object || !m_window) {
+        return;
+    }
+
+    QMetaMethod signal = object->metaObject()->method(senderSignalIndex());
+    addNote(QString::fromLatin1(object->metaObject()->className()) + "::"
+            + QString::fromLatin1(signal.name()));
+}
+
+void FrameMonitor::onAfterAnimating()
+{
+    qint64 now = StartupTrace::instance()->elapsedUs();
+
+    QMutexLocker locker(&m_mutex);
+    m_animatingUs = now;
+}
+
+void FrameMonitor::onBeforeSynchronizing()
+{
+    // The GUI thread is blocked here, and this alternates strictly with
+    // frameSwapped, so the frame can be pinned down without racing the
+    // next afterAnimating
+    qint64 now = StartupTrace::instance()->elapsedUs();
+
+    QMutexLocker locker(&m_mutex);
+
+    // Notes since the previous frame are reported with this one. They do
+    // not move its start: time spent handling them is the stall measured in
+    // onEventLoopReturned(), and the wait until this frame began is idle
+    while (!m_pending.isEmpty() && m_pending.first().atUs < now - MaxNoteAgeUs) {
+        m_pending.removeFirst();
+    }
+
+    m_frameStartUs = m_animatingUs >= 0 ? m_animatingUs : now;
+    m_animatingUs = -1;
+    m_inFlight = m_pending;
+    m_pending.clear();
+}
+
+void FrameMonitor::onFrameSwapped()
+{
+    qint64 now = StartupTrace::instance()->elapsedUs();
+
+    QMutexLocker locker(&m_mutex);
+    if (m_frameStartUs < 0) {
+        return;
+    }
+
+    qint64 startUs = m_frameStartUs;
+    double ms = (now - startUs) / 1000.0;
+    m_frameStartUs = -1;
+
+    ++m_frames;
+    m_lastMs = ms;
+    m_histogram.add(ms);
+    m_dropped += qMax(0, int(ms / m_intervalMs + 0.5) - 1);
+
+    m_recentSwapsUs.append(now);
+    while (!m_recentSwapsUs.isEmpty() && m_recentSwapsUs.first() < now - 1000000) {
+        m_recentSwapsUs.removeFirst();
+    }
+
+    QStringList events;
+    for (const Noted &noted : std::as_const(m_inFlight)) {
+        if (!events.contains(noted.what)) {
+            events.append(noted.what);
+            if (events.size() == MaxEventsPerFrame) {
+                break;
+            }
+        }
+    }
+    m_inFlight.clear();
+
+    bool isLong = ms > 2 * m_intervalMs;
+    if (isLong) {
+        m_recentLong.append({startUs, ms, events, false});
+        if (m_recentLong.size() > MaxLongFrames) {
+            m_recentLong.removeFirst();
+        }
+    }
+    locker.unlock();
+
+    if (isLong) {
+        qCDebug(lcApp) << "Long frame:" << ms << "ms after" << events;
+    }
+
+    QVariantMap args;
+    if (!events.isEmpty()) {
+        args["events"] = events;
+    }
+    StartupTrace::instance()->addCompleteEvent(isLong ? QStringLiteral("long frame") : QStringLiteral("frame"),
+                                               QStringLiteral("frame"), startUs, now - startUs, args);
+}
+
+void FrameMonitor::setOverlayVisible(bool visible)
+{
+    if (visible == overlayVisible()) {
+        return;
+    }
+
+    if (visible) {
+        publishStats();
+        m_statsTimer.start();
+    } else {
+        m_statsTimer.stop();
+    }
+    emit overlayVisibleChanged();
+}
+
+void FrameMonitor::publishStats()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_fps = m_recentSwapsUs.size();
+    m_lastFrameMs = m_lastMs;
+    m_p95FrameMs = m_histogram.percentile(0.95);
+    m_totalFrames = int(m_frames);
+    m_droppedFrames = int(m_dropped);
+
+    // Newest first for the overlay
+    m_longFrames.clear();
+    for (auto it = m_recentLong.crbegin(); it != m_recentLong.crend(); ++it) {
+        QVariantMap frame;
+        frame["atMs"] = it->startUs / 1000;
+        frame["durationMs"] = qRound(it->durationMs);
+        frame["events"] = it->events.join(", ");
+        frame["stall"] = it->stall;
+        m_longFrames.append(frame);
+    }
+    locker.unlock();
+
+    emit statsChanged();
+}
+
+void FrameMonitor::reset()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_histogram = ApiMetrics::Histogram();
+        m_recentLong.clear();
+        m_recentSwapsUs.clear();
+        m_frames = 0;
+        m_dropped = 0;
+        m_lastMs = 0.0;
+    }
+    publishStats();
+}
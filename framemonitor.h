@@ -0,0 +1,125 @@
+#ifndef FRAMEMONITOR_H
+#define FRAMEMONITOR_H
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QVariantList>
+#include "apimetrics.h"
+
+class QQuickWindow;
+
+// Frame timing for the main window. A frame runs from afterAnimating on the
+// GUI thread to frameSwapped on the render thread; what was noted with
+// note() since the previous frame (a network reply, a model reset) is
+// reported with it.
+//
+// Work between frames is timed separately: a note starts a GUI-thread
+// stall that lasts until control is back in the event loop, so it covers
+// the handler that made the note and anything it runs, and notes made
+// during it are kept together: "the GUI thread was blocked 240 ms by
+// /api/transactions and transactionsChanged". Idle time between a note and
+// the next frame never counts.
+//
+// Frames and stalls longer than twice the refresh interval are kept as long
+// frames; both count the intervals they missed as dropped. When the startup
+// trace is enabled frames and long stalls are also added to it (category
+// "frame"), so stutters line up with the startup phases in chrome://tracing.
+// LUMIN_FRAME_OVERLAY=1 shows the overlay at startup.
+class FrameMonitor : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool overlayVisible READ overlayVisible WRITE setOverlayVisible NOTIFY overlayVisibleChanged)
+    Q_PROPERTY(double fps READ fps NOTIFY statsChanged)
+    Q_PROPERTY(double lastFrameMs READ lastFrameMs NOTIFY statsChanged)
+    Q_PROPERTY(double p95FrameMs READ p95FrameMs NOTIFY statsChanged)
+    Q_PROPERTY(int totalFrames READ totalFrames NOTIFY statsChanged)
+    Q_PROPERTY(int droppedFrames READ droppedFrames NOTIFY statsChanged)
+    Q_PROPERTY(QVariantList longFrames READ longFrames NOTIFY statsChanged)
+
+public:
+    static FrameMonitor *instance();
+
+    void attachWindow(QQuickWindow *window);
+
+    // Remembers that `what` happened now; it is reported with the frame it
+    // delays if that frame is long. Safe to call from any thread, but only
+    // GUI-thread notes are kept.
+    static void note(const QString &what);
+
+    // Notes every *Changed signal of a controller under its class name
+    void watchSignals(QObject *object);
+
+    bool overlayVisible() const { return m_statsTimer.isActive(); }
+    void setOverlayVisible(bool visible);
+
+    double fps() const { return m_fps; }
+    double lastFrameMs() const { return m_lastFrameMs; }
+    double p95FrameMs() const { return m_p95FrameMs; }
+    int totalFrames() const { return m_totalFrames; }
+    int droppedFrames() const { return m_droppedFrames; }
+    QVariantList longFrames() const { return m_longFrames; }
+
+    Q_INVOKABLE void reset();
+
+signals:
+    void overlayVisibleChanged();
+    void statsChanged();
+
+private slots:
+    void onWatchedSignal();
+    void publishStats();
+    void onEventLoopReturned();
+
+private:
+    explicit FrameMonitor(QObject *parent = nullptr);
+
+    struct Noted {
+        qint64 atUs;
+        QString what;
+    };
+
+    struct LongFrame {
+        qint64 startUs;
+        double durationMs;
+        QStringList events;
+        bool stall;                  // GUI thread blocked between frames
+    };
+
+    void onAfterAnimating();
+    void onBeforeSynchronizing();
+    void onFrameSwapped();
+    void addNote(const QString &what);
+
+    QQuickWindow *m_window;
+    double m_intervalMs;
+
+    mutable QMutex m_mutex;
+    QList<Noted> m_pending;          // since the last frame started
+    QList<Noted> m_inFlight;         // belong to the frame being rendered
+    qint64 m_stallStartUs;           // GUI thread only; -1 outside a stall
+    QStringList m_stallEvents;
+    qint64 m_animatingUs;
+    qint64 m_frameStartUs;
+    ApiMetrics::Histogram m_histogram;
+    QList<LongFrame> m_recentLong;   // newest last, at most 50
+    QList<qint64> m_recentSwapsUs;   // last second, for fps
+    qint64 m_frames;
+    qint64 m_dropped;
+    double m_lastMs;
+
+    // GUI-thread copies for QML
+    QTimer m_statsTimer;
+    double m_fps;
+    double m_lastFrameMs;
+    double m_p95FrameMs;
+    int m_totalFrames;
+    int m_droppedFrames;
+    QVariantList m_longFrames;
+};
+
+#endif // FRAMEMONITOR_H
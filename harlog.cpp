@@ -0,0 +1,228 @@
+#include "harlog.h"
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QMutexLocker>
+#include <QNetworkReply>
+#include <QUrlQuery>
+
+namespace {
+
+const int MaxAgeMinutes = 30;
+const int MaxEntries = 5000;
+
+QJsonArray headersToJson(const QList<QPair<QByteArray, QByteArray>> &headers)
+{
+    QJsonArray array;
+    for (const auto &header : headers) {
+        array.append(QJsonObject{
+            { "name", QString::fromLatin1(header.first) },
+            { "value", QString::fromUtf8(header.second) },
+        });
+    }
+    return array;
+}
+
+QJsonArray queryToJson(const QUrl &url)
+{
+    QJsonArray array;
+    const auto items = QUrlQuery(url).queryItems(QUrl::FullyDecoded);
+    for (const auto &item : items) {
+        array.append(QJsonObject{ { "name", item.first }, { "value", item.second } });
+    }
+    return array;
+}
+
+} // namespace
+
+HarLog::HarLog()
+{
+}
+
+HarLog *HarLog::instance()
+{
+    static HarLog log;
+    return &log;
+}
+
+HarLog::Headers HarLog::redacted(const Headers &headers)
+{
+    Headers result = headers;
+    for (auto &header : result) {
+        QByteArray name = header.first.toLower();
+        if (name == "authorization" || name == "cookie" || name == "set-cookie") {
+            header.second = "[redacted]";
+        }
+    }
+    return result;
+}
+
+void HarLog::record(QNetworkReply *reply, const QByteArray &method, const QDateTime &startedAt,
+                    qint64 bytesOut, qint64 wireBytes, double connectMs, double ttfbMs, double totalMs)
+{
+    Entry entry;
+    entry.startedAt = startedAt;
+    entry.method = method;
+    entry.url = reply->url().toString(QUrl::FullyEncoded);
+    entry.httpVersion = reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool()
+                            ? QStringLiteral("HTTP/2.0") : QStringLiteral("HTTP/1.1");
+
+    const QNetworkRequest request = reply->request();
+    const QList<QByteArray> names = request.rawHeaderList();
+    for (const QByteArray &name : names) {
+        entry.requestHeaders.append({ name, request.rawHeader(name) });
+    }
+    entry.requestHeaders = redacted(entry.requestHeaders);
+    entry.requestBodySize = bytesOut;
+
+    entry.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    entry.statusText = QString::fromUtf8(reply->attribute(QNetworkRequest::HttpReasonPhraseAttribute).toByteArray());
+    entry.responseHeaders = redacted(reply->rawHeaderPairs());
+    entry.contentSize = reply->bytesAvailable();
+    entry.wireBytes = wireBytes;
+    entry.mimeType = QString::fromLatin1(reply->rawHeader("Content-Type"));
+    if (reply->error() != QNetworkReply::NoError) {
+        entry.error = reply->errorString();
+    }
+
+    // HAR has separate dns/connect/ssl phases; Qt only tells us when the
+    // whole connection setup started and ended, so it all goes in connect.
+    // Without a response (ttfb < 0) the time after setup counts as wait.
+    entry.connectMs = connectMs;
+    double setupMs = qMax(0.0, connectMs);
+    if (ttfbMs >= 0) {
+        entry.waitMs = qMax(0.0, ttfbMs - setupMs);
+        entry.receiveMs = qMax(0.0, totalMs - ttfbMs);
+    } else {
+        entry.waitMs = qMax(0.0, totalMs - setupMs);
+    }
+    entry.totalMs = setupMs + entry.waitMs + entry.receiveMs;
+
+    QMutexLocker locker(&m_mutex);
+    m_entries.append(entry);
+    prune(QDateTime::currentDateTimeUtc());
+}
+
+void HarLog::prune(const QDateTime &now)
+{
+    QDateTime cutoff = now.addSecs(-MaxAgeMinutes * 60);
+    while (!m_entries.isEmpty()
+           && (m_entries.size() > MaxEntries || m_entries.first().startedAt < cutoff)) {
+        m_entries.removeFirst();
+    }
+}
+
+QJsonObject HarLog::entryToJson(const Entry &entry)
+{
+    QJsonObject request{
+        { "method", QString::fromLatin1(entry.method) },
+        { "url", entry.url },
+        { "httpVersion", entry.httpVersion },
+        { "cookies", QJsonArray() },
+        { "headers", headersToJson(entry.requestHeaders) },
+        { "queryString", queryToJson(QUrl(entry.url)) },
+        { "headersSize", -1 },
+        { "bodySize", entry.requestBodySize },
+    };
+
+    QJsonObject content{
+        { "size", entry.contentSize },
+        { "mimeType", entry.mimeType },
+    };
+    // Bytes saved by transparent decompression
+    if (entry.wireBytes >= 0 && entry.wireBytes < entry.contentSize) {
+        content["compression"] = entry.contentSize - entry.wireBytes;
+    }
+
+    QJsonObject response{
+        { "status", entry.status },
+        { "statusText", entry.statusText },
+        { "httpVersion", entry.httpVersion },
+        { "cookies", QJsonArray() },
+        { "headers", headersToJson(entry.responseHeaders) },
+        { "content", content },
+        { "redirectURL", QString() },
+        { "headersSize", -1 },
+        { "bodySize", entry.wireBytes },
+    };
+
+    QJsonObject timings{
+        { "blocked", -1 },
+        { "dns", -1 },
+        { "connect", entry.connectMs >= 0 ? entry.connectMs : -1 },
+        { "ssl", -1 },
+        { "send", 0 },
+        { "wait", entry.waitMs },
+        { "receive", entry.receiveMs },
+    };
+
+    QJsonObject json{
+        { "startedDateTime", entry.startedAt.toString(Qt::ISODateWithMs) },
+        { "time", entry.totalMs },
+        { "request", request },
+        { "response", response },
+        { "cache", QJsonObject() },
+        { "timings", timings },
+    };
+    if (!entry.error.isEmpty()) {
+        json["_error"] = entry.error;
+    }
+    return json;
+}
+
+QJsonObject HarLog::toHar(int minutes) const
+{
+    QDateTime cutoff = QDateTime::currentDateTimeUtc().addSecs(-qint64(minutes) * 60);
+
+    QJsonArray entries;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const Entry &entry : m_entries) {
+            if (entry.startedAt >= cutoff) {
+                entries.append(entryToJson(entry));
+            }
+        }
+    }
+
+    QJsonObject creator{
+        { "name", QCoreApplication::applicationName() },
+        { "version", QCoreApplication::applicationVersion() },
+    };
+
+    return QJsonObject{
+        { "log", QJsonObject{
+              { "version", "1.2" },
+              { "creator", creator },
+              { "pages", QJsonArray() },
+              { "entries", entries },
+          } },
+    };
+}
+
+int HarLog::entryCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return int(m_entries.size());
+}
+
+qint64 HarLog::approximateBytes() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    qint64 bytes = 0;
+    for (const Entry &entry : m_entries) {
+        bytes += sizeof(Entry) + (entry.url.size() + entry.statusText.size() + entry.mimeType.size()
+                                  + entry.error.size()) * 2;
+        for (const Headers *headers : { &entry.requestHeaders, &entry.responseHeaders }) {
+            for (const auto &header : *headers) {
+                bytes += 2 * 24 + header.first.size() + header.second.size();
+            }
+        }
+    }
+    return bytes;
+}
+
+void HarLog::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+}
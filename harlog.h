@@ -0,0 +1,68 @@
+#ifndef HARLOG_H
+#define HARLOG_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+
+class QNetworkReply;
+
+// Rolling log of the last half hour of API requests (at most 5000), kept
+// so a "the page is slow" report can come with a HAR 1.2 file of what the
+// client actually did. Entries hold URL, method, status, headers, sizes
+// and phase timings; no bodies. Authorization and cookie headers are
+// redacted when recorded, so nothing secret is held in memory either.
+// Fed by ApiNetworkManager for every finished reply. Thread-safe.
+class HarLog
+{
+public:
+    static HarLog *instance();
+
+    void record(QNetworkReply *reply, const QByteArray &method, const QDateTime &startedAt,
+                qint64 bytesOut, qint64 wireBytes, double connectMs, double ttfbMs, double totalMs);
+
+    // HAR document with the entries started in the last `minutes` minutes
+    QJsonObject toHar(int minutes) const;
+    int entryCount() const;
+    qint64 approximateBytes() const;
+    void clear();
+
+private:
+    HarLog();
+    Q_DISABLE_COPY(HarLog)
+
+    typedef QList<QPair<QByteArray, QByteArray>> Headers;
+
+    struct Entry {
+        QDateTime startedAt;
+        QByteArray method;
+        QString url;
+        QString httpVersion;
+        Headers requestHeaders;
+        qint64 requestBodySize = 0;
+        int status = 0;
+        QString statusText;
+        Headers responseHeaders;
+        qint64 contentSize = 0;
+        qint64 wireBytes = -1;
+        QString mimeType;
+        QString error;
+        double connectMs = -1;
+        double waitMs = 0;
+        double receiveMs = 0;
+        double totalMs = 0;
+    };
+
+    static Headers redacted(const Headers &headers);
+    static QJsonObject entryToJson(const Entry &entry);
+    void prune(const QDateTime &now);
+
+    mutable QMutex m_mutex;
+    QList<Entry> m_entries;   // oldest first
+};
+
+#endif // HARLOG_H
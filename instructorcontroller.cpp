@@ -1,7 +1,8 @@
 #include "instructorcontroller.h"
+#include "logging.h"
+#include "payloadfields.h"
 #include <QJsonArray>
 #include <QDateTime>
-#include <QDebug>
 
 InstructorController::InstructorController(QObject *parent)
     : QObject(parent)
@@ -96,7 +97,7 @@ void InstructorController::revokeInstructor(const QString &instructorId)
 void InstructorController::reloadTokens()
 {
     m_api->loadTokens();
-    qDebug() << "InstructorController: tokens reloaded, logged in:" << m_api->isLoggedIn();
+    qCDebug(lcControllers) << "InstructorController: tokens reloaded, logged in:" << m_api->isLoggedIn();
 }
 
 void InstructorController::clearError()
@@ -109,8 +110,19 @@ void InstructorController::refresh()
     loadInstructors();
 }
 
+void InstructorController::restoreSnapshot(const QJsonObject &data)
+{
+    onInstructorsLoaded(data);
+}
+
 void InstructorController::onInstructorsLoaded(const QJsonObject &data)
 {
+    // Unpaged responses carry no pagination and count as the first page
+    int page = data["pagination"].toObject()["page"].toInt(1);
+    if (page == 1 && m_currentStatus == "all" && m_searchQuery.isEmpty()) {
+        m_firstPage = data;
+    }
+
     if (data.contains("stats")) {
         updateStats(data["stats"].toObject());
     }
@@ -178,7 +190,10 @@ void InstructorController::updateInstructorsList(const QJsonArray &instructorsAr
         instructorMap["lastName"] = instructor["lastName"].toString();
         instructorMap["email"] = instructor["email"].toString();
         instructorMap["image"] = instructor["image"].toString();
-        instructorMap["instructorStatus"] = instructor["instructorStatus"].toString();
+
+        const PayloadFields::Value status =
+            PayloadFields::decode(PayloadFields::InstructorStatus, instructor["instructorStatus"]);
+        instructorMap["instructorStatus"] = status.name;
         instructorMap["createdAt"] = instructor["createdAt"].toString();
 
         // Format full name
@@ -45,6 +45,10 @@ public:
     Q_INVOKABLE void reloadTokens();
     Q_INVOKABLE void refresh();
 
+    // Last unfiltered list response, persisted by SessionSnapshot
+    QJsonObject snapshot() const { return m_firstPage; }
+    void restoreSnapshot(const QJsonObject &data);
+
 signals:
     void isLoadingChanged();
     void errorMessageChanged();
@@ -75,6 +79,7 @@ private:
     QVariantList m_instructors;
     QString m_currentStatus;
     QString m_searchQuery;
+    QJsonObject m_firstPage;
 
     void setLoading(bool loading);
     void setError(const QString &error);
@@ -0,0 +1,20 @@
+# Drives many simulated admin sessions through ApiManager against a
+# lumin-mockserver and reports throughput, step latency and client
+# CPU/memory. For a large-tenant run:
+#   ../mockserver/lumin-mockserver --students 50000 --transactions 200000 --latency 40
+#   ./lumin-loadgen --sessions 200 --threads 8 --duration 120 --json run.json
+
+include(../lumin.pri)
+
+CONFIG += console
+CONFIG -= app_bundle
+TARGET = lumin-loadgen
+
+SOURCES += \
+    loadsession.cpp \
+    loadstats.cpp \
+    main.cpp
+
+HEADERS += \
+    loadsession.h \
+    loadstats.h
@@ -0,0 +1,238 @@
+#include "loadsession.h"
+#include "apimanager.h"
+#include "loadstats.h"
+#include <QJsonArray>
+#include <QStringList>
+#include <QTimer>
+#include <iterator>
+
+namespace {
+
+const char *const CourseSearches[] = { "design", "photo", "video", "intro", "advanced", "color" };
+
+} // namespace
+
+LoadSession::LoadSession(int index, const Script &script, quint32 seed, LoadStats *stats,
+                         QObject *parent)
+    : QObject(parent)
+    , m_api(new ApiManager(this))
+    , m_script(script)
+    , m_stats(stats)
+    , m_random(seed + quint32(index))
+    , m_email(QString("loadgen%1@picsart.academy").arg(index))
+    , m_step(Login)
+    , m_page(1)
+    , m_finished(false)
+{
+    // Sessions sign in themselves; do not start from the stored tokens
+    m_api->setAccessToken(QString());
+    m_api->setRefreshToken(QString());
+
+    connect(m_api, &ApiManager::loginSuccess, this, [this](const QString &sessionToken, const QString &) {
+        m_sessionToken = sessionToken;
+        stepDone(true, QString());
+    });
+    connect(m_api, &ApiManager::loginFailed, this, [this](const QString &code, const QString &message) {
+        stepDone(false, code.isEmpty() ? message : code);
+    });
+    connect(m_api, &ApiManager::otpVerifySuccess, this, [this]() {
+        stepDone(true, QString());
+    });
+    connect(m_api, &ApiManager::otpVerifyFailed, this, [this](const QString &code, const QString &message) {
+        stepDone(false, code.isEmpty() ? message : code);
+    });
+
+    auto loaded = [this](const QJsonObject &data) { stepDone(true, QString(), data); };
+    auto failed = [this](const QString &error) { stepDone(false, error); };
+
+    connect(m_api, &ApiManager::dashboardStatsLoaded, this, loaded);
+    connect(m_api, &ApiManager::dashboardStatsLoadFailed, this, failed);
+    connect(m_api, &ApiManager::dashboardActivityLoaded, this, loaded);
+    connect(m_api, &ApiManager::dashboardActivityLoadFailed, this, failed);
+    connect(m_api, &ApiManager::studentsLoaded, this, loaded);
+    connect(m_api, &ApiManager::studentsLoadFailed, this, failed);
+    connect(m_api, &ApiManager::transactionsLoaded, this, loaded);
+    connect(m_api, &ApiManager::transactionsLoadFailed, this, failed);
+    connect(m_api, &ApiManager::coursesLoaded, this, loaded);
+    connect(m_api, &ApiManager::coursesLoadFailed, this, failed);
+    connect(m_api, &ApiManager::instructorsLoaded, this, loaded);
+    connect(m_api, &ApiManager::instructorsLoadFailed, this, failed);
+    connect(m_api, &ApiManager::instructorStatusUpdated, this, loaded);
+    connect(m_api, &ApiManager::instructorStatusUpdateFailed, this, failed);
+    connect(m_api, &ApiManager::courseStatusUpdated, this, loaded);
+    connect(m_api, &ApiManager::courseStatusUpdateFailed, this, failed);
+}
+
+LoadSession::~LoadSession()
+{
+}
+
+void LoadSession::start()
+{
+    if (m_stats->isStopping()) {
+        return;
+    }
+    m_stats->sessionStarted();
+    runStep();
+}
+
+QString LoadSession::stepName(Step step)
+{
+    switch (step) {
+    case Login: return QStringLiteral("login");
+    case VerifyOtp: return QStringLiteral("verifyOtp");
+    case DashboardStats: return QStringLiteral("dashboard.stats");
+    case DashboardActivity: return QStringLiteral("dashboard.activity");
+    case StudentsPage: return QStringLiteral("students.page");
+    case TransactionsPage: return QStringLiteral("transactions.page");
+    case TransactionsSearch: return QStringLiteral("transactions.search");
+    case CoursesSearch: return QStringLiteral("courses.search");
+    case PendingInstructors: return QStringLiteral("instructors.pending");
+    case ModerateInstructor: return QStringLiteral("instructors.moderate");
+    case PendingCourses: return QStringLiteral("courses.pending");
+    case ModerateCourse: return QStringLiteral("courses.moderate");
+    }
+    return QString();
+}
+
+bool LoadSession::finishIfStopping()
+{
+    if (!m_stats->isStopping()) {
+        return false;
+    }
+    if (!m_finished) {
+        m_finished = true;
+        m_stats->sessionFinished();
+    }
+    return true;
+}
+
+void LoadSession::scheduleNext()
+{
+    if (finishIfStopping()) {
+        return;
+    }
+
+    // Uniform in [0.5, 1.5) x the mean, so sessions drift apart instead of
+    // hitting the server in lockstep
+    int thinkMs = m_script.thinkMs / 2 + int(m_random.bounded(qMax(1, m_script.thinkMs)));
+    QTimer::singleShot(thinkMs, this, &LoadSession::runStep);
+}
+
+void LoadSession::runStep()
+{
+    if (finishIfStopping()) {
+        return;
+    }
+    m_stepTimer.start();
+
+    switch (m_step) {
+    case Login:
+        m_api->login(m_email, QStringLiteral("loadgen"));
+        break;
+    case VerifyOtp:
+        m_api->verifyOtp(m_sessionToken, QStringLiteral("000000"));
+        break;
+    case DashboardStats:
+        m_api->getDashboardStats();
+        break;
+    case DashboardActivity:
+        m_api->getDashboardActivity();
+        break;
+    case StudentsPage:
+        m_api->getStudents(QString(), QString(), m_page, m_script.pageSize);
+        break;
+    case TransactionsPage:
+        m_api->getTransactions(m_page, m_script.pageSize);
+        break;
+    case TransactionsSearch:
+        m_api->getTransactions(1, m_script.pageSize, QString(),
+                               QString::number(m_random.bounded(100, 1000)));
+        break;
+    case CoursesSearch:
+        m_api->getCourses(QString(), QString::fromLatin1(
+            CourseSearches[m_random.bounded(int(std::size(CourseSearches)))]));
+        break;
+    case PendingInstructors:
+        m_api->getInstructors(QStringLiteral("pending"));
+        break;
+    case ModerateInstructor:
+        m_api->updateInstructorStatus(m_moderationId, m_random.bounded(4) == 0 ? "rejected" : "verified");
+        break;
+    case PendingCourses:
+        m_api->getCourses(QStringLiteral("pending_review"));
+        break;
+    case ModerateCourse:
+        if (m_random.bounded(4) == 0) {
+            m_api->updateCourseStatus(m_moderationId, "rejected", "Load test rejection");
+        } else {
+            m_api->updateCourseStatus(m_moderationId, "published");
+        }
+        break;
+    }
+}
+
+void LoadSession::stepDone(bool ok, const QString &error, const QJsonObject &data)
+{
+    m_stats->record(stepName(m_step), m_stepTimer.nsecsElapsed() / 1e6, ok, error);
+    m_step = nextStep(ok, data);
+    scheduleNext();
+}
+
+LoadSession::Step LoadSession::nextStep(bool ok, const QJsonObject &data)
+{
+    switch (m_step) {
+    case Login:
+        return ok ? VerifyOtp : Login;
+    case VerifyOtp:
+        return ok ? DashboardStats : Login;
+    case DashboardStats:
+        return DashboardActivity;
+    case DashboardActivity:
+        m_page = 1;
+        return StudentsPage;
+    case StudentsPage:
+        if (ok && ++m_page <= m_script.pages) {
+            return StudentsPage;
+        }
+        m_page = 1;
+        return TransactionsPage;
+    case TransactionsPage:
+        if (ok && ++m_page <= m_script.pages) {
+            return TransactionsPage;
+        }
+        return TransactionsSearch;
+    case TransactionsSearch:
+        return CoursesSearch;
+    case CoursesSearch:
+        return PendingInstructors;
+    case PendingInstructors:
+        m_moderationId = ok ? pickPending(data, "instructors", "instructorStatus", "pending") : QString();
+        return m_moderationId.isEmpty() ? PendingCourses : ModerateInstructor;
+    case ModerateInstructor:
+        return PendingCourses;
+    case PendingCourses:
+        m_moderationId = ok ? pickPending(data, "courses", "status", "pending_review") : QString();
+        return m_moderationId.isEmpty() ? DashboardStats : ModerateCourse;
+    case ModerateCourse:
+        return DashboardStats;
+    }
+    return DashboardStats;
+}
+
+QString LoadSession::pickPending(const QJsonObject &data, const QString &listKey,
+                                 const QString &statusKey, const QString &pendingStatus)
+{
+    if (m_random.generateDouble() >= m_script.moderationRate) {
+        return QString();
+    }
+
+    const QJsonArray rows = data[listKey].toArray();
+    QStringList pending;
+    for (const QJsonValue &row : rows) {
+        if (row[statusKey].toString() == pendingStatus) {
+            pending.append(row["id"].toString());
+        }
+    }
+    return pending.isEmpty() ? QString() : pending.at(m_random.bounded(int(pending.size())));
+}
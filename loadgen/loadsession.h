@@ -0,0 +1,80 @@
+#ifndef LOADSESSION_H
+#define LOADSESSION_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QObject>
+#include <QRandomGenerator>
+#include <QString>
+
+class ApiManager;
+class LoadStats;
+
+// One simulated admin. Signs in (login + OTP), then loops through what an
+// admin does in a working session: dashboard, a few pages of students and
+// transactions, a transaction and a course search, and the moderation
+// queues, approving or rejecting a pending instructor or course now and
+// then. One request in flight at a time with a randomised think time
+// between steps, like a person clicking through the app.
+//
+// Lives on the thread it was created on and uses that thread's shared
+// network manager, so sessions on one thread share its connection pool.
+class LoadSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Script {
+        int pages = 3;                  // list pages read per visit
+        int pageSize = 20;
+        int thinkMs = 500;              // mean pause between steps
+        double moderationRate = 0.2;    // chance of acting on a pending row
+    };
+
+    LoadSession(int index, const Script &script, quint32 seed, LoadStats *stats,
+                QObject *parent = nullptr);
+    ~LoadSession();
+
+    void start();
+
+private:
+    enum Step {
+        Login,
+        VerifyOtp,
+        DashboardStats,
+        DashboardActivity,
+        StudentsPage,
+        TransactionsPage,
+        TransactionsSearch,
+        CoursesSearch,
+        PendingInstructors,
+        ModerateInstructor,
+        PendingCourses,
+        ModerateCourse
+    };
+
+    static QString stepName(Step step);
+
+    bool finishIfStopping();
+    void scheduleNext();
+    void runStep();
+    void stepDone(bool ok, const QString &error, const QJsonObject &data = QJsonObject());
+    Step nextStep(bool ok, const QJsonObject &data);
+    QString pickPending(const QJsonObject &data, const QString &listKey,
+                        const QString &statusKey, const QString &pendingStatus);
+
+    ApiManager *m_api;
+    Script m_script;
+    LoadStats *m_stats;
+    QRandomGenerator m_random;
+    QString m_email;
+
+    Step m_step;
+    int m_page;
+    QString m_sessionToken;
+    QString m_moderationId;
+    QElapsedTimer m_stepTimer;
+    bool m_finished;
+};
+
+#endif // LOADSESSION_H
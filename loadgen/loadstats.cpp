@@ -0,0 +1,75 @@
+#include "loadstats.h"
+#include <QMutexLocker>
+
+namespace {
+
+// Server messages can embed ids; keep the error table readable
+const int MaxErrorKinds = 20;
+
+} // namespace
+
+void LoadStats::record(const QString &step, double ms, bool ok, const QString &error)
+{
+    if (isStopping()) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    Step &stats = m_steps[step];
+    stats.latency.add(ms);
+    if (!ok) {
+        ++stats.failures;
+        QString key = error.isEmpty() ? QStringLiteral("unknown") : error;
+        if (stats.errors.contains(key) || stats.errors.size() < MaxErrorKinds) {
+            ++stats.errors[key];
+        } else {
+            ++stats.errors[QStringLiteral("other")];
+        }
+    }
+}
+
+QMap<QString, LoadStats::Step> LoadStats::steps() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_steps;
+}
+
+qint64 LoadStats::completedSteps() const
+{
+    QMutexLocker locker(&m_mutex);
+    qint64 count = 0;
+    for (const Step &step : m_steps) {
+        count += step.latency.count();
+    }
+    return count;
+}
+
+qint64 LoadStats::failedSteps() const
+{
+    QMutexLocker locker(&m_mutex);
+    qint64 count = 0;
+    for (const Step &step : m_steps) {
+        count += step.failures;
+    }
+    return count;
+}
+
+QJsonObject LoadStats::toJson() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QJsonObject json;
+    for (auto it = m_steps.cbegin(); it != m_steps.cend(); ++it) {
+        QJsonObject step = it.value().latency.toJson();
+        step["failures"] = it.value().failures;
+        if (!it.value().errors.isEmpty()) {
+            QJsonObject errors;
+            for (auto error = it.value().errors.cbegin(); error != it.value().errors.cend(); ++error) {
+                errors[error.key()] = error.value();
+            }
+            step["errors"] = errors;
+        }
+        json[it.key()] = step;
+    }
+    return json;
+}
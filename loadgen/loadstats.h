@@ -0,0 +1,49 @@
+#ifndef LOADSTATS_H
+#define LOADSTATS_H
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QJsonObject>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include "apimetrics.h"
+
+// Step results from every LoadSession, on any thread. A step is one user
+// action as the session sees it: from the ApiManager call to its
+// loaded/failed signal, so JSON parsing and signal delivery count too.
+class LoadStats
+{
+public:
+    struct Step {
+        ApiMetrics::Histogram latency;
+        qint64 failures = 0;
+        QHash<QString, qint64> errors;
+    };
+
+    void record(const QString &step, double ms, bool ok, const QString &error = QString());
+
+    // Once stopping, sessions finish after their current step and results
+    // are no longer recorded, so the totals cover the measured window only
+    void setStopping() { m_stopping.storeRelease(1); }
+    bool isStopping() const { return m_stopping.loadAcquire() != 0; }
+
+    void sessionStarted() { m_activeSessions.ref(); }
+    void sessionFinished() { m_activeSessions.deref(); }
+    int activeSessions() const { return m_activeSessions.loadAcquire(); }
+
+    QMap<QString, Step> steps() const;
+    qint64 completedSteps() const;
+    qint64 failedSteps() const;
+
+    // Per step: count, mean, p50, p95, p99, max, failures and errors
+    QJsonObject toJson() const;
+
+private:
+    mutable QMutex m_mutex;
+    QMap<QString, Step> m_steps;
+    QAtomicInt m_stopping;
+    QAtomicInt m_activeSessions;
+};
+
+#endif // LOADSTATS_H
@@ -0,0 +1,253 @@
+#include "apimanager.h"
+#include "apimetrics.h"
+#include "loadsession.h"
+#include "loadstats.h"
+#include "memoryreport.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+#include <QTimer>
+#include <memory>
+#include <vector>
+
+#if defined(Q_OS_WIN)
+#  include <windows.h>
+#else
+#  include <sys/resource.h>
+#endif
+
+namespace {
+
+const int RssSampleMs = 250;
+const int DrainTimeoutMs = 10000;
+
+// User + system CPU time of the whole process, in milliseconds
+double processCpuMs()
+{
+#if defined(Q_OS_WIN)
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        return -1;
+    }
+    auto ticks = [](const FILETIME &time) {
+        return (qint64(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    return (ticks(kernel) + ticks(user)) / 1e4;   // 100 ns units
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3
+           + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e3;
+#endif
+}
+
+QString mib(qint64 bytes)
+{
+    return bytes < 0 ? QStringLiteral("n/a") : QString::number(bytes / 1048576.0, 'f', 1) + " MiB";
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setOrganizationName("PicsartAcademy");
+    QCoreApplication::setApplicationName("lumin-loadgen");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Simulated admin sessions against a lumin-mockserver.\n"
+                                     "Reports throughput, step latency and client CPU/memory.");
+    parser.addHelpOption();
+
+    QCommandLineOption urlOption("url", "API base URL (default http://127.0.0.1:8787).", "url",
+                                 "http://127.0.0.1:8787");
+    QCommandLineOption sessionsOption("sessions", "Concurrent sessions (default 20).", "n", "20");
+    QCommandLineOption threadsOption("threads", "Client threads; each has its own connection pool (default 1).",
+                                     "n", "1");
+    QCommandLineOption durationOption("duration", "Measured run time in seconds (default 60).", "s", "60");
+    QCommandLineOption rampOption("ramp", "Seconds over which sessions start (default 5).", "s", "5");
+    QCommandLineOption thinkOption("think", "Mean think time between steps in ms (default 500).", "ms", "500");
+    QCommandLineOption pagesOption("pages", "List pages read per visit (default 3).", "n", "3");
+    QCommandLineOption moderationOption("moderation", "Chance of moderating a pending row (default 0.2).",
+                                        "rate", "0.2");
+    QCommandLineOption seedOption("seed", "Random seed for the navigation scripts.", "seed", "1");
+    QCommandLineOption jsonOption("json", "Also write the report as JSON to this file.", "file");
+
+    parser.addOptions({ urlOption, sessionsOption, threadsOption, durationOption, rampOption,
+                        thinkOption, pagesOption, moderationOption, seedOption, jsonOption });
+    parser.process(app);
+
+    int sessions = qMax(1, parser.value(sessionsOption).toInt());
+    int threads = qBound(1, parser.value(threadsOption).toInt(), sessions);
+    int durationMs = qMax(1, parser.value(durationOption).toInt()) * 1000;
+    int rampMs = qMax(0, parser.value(rampOption).toInt()) * 1000;
+    quint32 seed = parser.value(seedOption).toUInt();
+
+    LoadSession::Script script;
+    script.pages = qMax(1, parser.value(pagesOption).toInt());
+    script.thinkMs = qMax(0, parser.value(thinkOption).toInt());
+    script.moderationRate = qBound(0.0, parser.value(moderationOption).toDouble(), 1.0);
+
+    ApiManager::setDefaultBaseUrl(parser.value(urlOption));
+
+    // Every session signs in and ApiManager persists its tokens; keep them
+    // out of the real app's settings (and off the settings file lock)
+    QTemporaryDir settingsDir;
+    QSettings::setDefaultFormat(QSettings::IniFormat);
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, settingsDir.path());
+
+    LoadStats stats;
+
+    // One context object per thread owns that thread's sessions; sessions
+    // must be created on their thread to get its network manager
+    std::vector<std::unique_ptr<QThread>> workers;
+    QList<QObject *> contexts;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back(new QThread);
+        QObject *context = new QObject;
+        context->moveToThread(workers.back().get());
+        contexts.append(context);
+        workers.back()->start();
+    }
+
+    QTextStream out(stdout);
+    out << "Running " << sessions << " sessions on " << threads << " thread(s) against "
+        << ApiManager::defaultBaseUrl() << " for " << durationMs / 1000 << " s" << Qt::endl;
+
+    double cpuStartMs = processCpuMs();
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    for (int i = 0; i < sessions; ++i) {
+        QObject *context = contexts.at(i % threads);
+        int startDelayMs = int(qint64(rampMs) * i / sessions);
+        QMetaObject::invokeMethod(context, [context, i, script, seed, &stats, startDelayMs]() {
+            LoadSession *session = new LoadSession(i, script, seed, &stats, context);
+            QTimer::singleShot(startDelayMs, session, &LoadSession::start);
+        });
+    }
+
+    qint64 rssPeak = MemoryReport::residentBytes();
+    QTimer rssTimer;
+    QObject::connect(&rssTimer, &QTimer::timeout, [&rssPeak]() {
+        rssPeak = qMax(rssPeak, MemoryReport::residentBytes());
+    });
+    rssTimer.start(RssSampleMs);
+
+    double measuredMs = 0;
+    double cpuMs = 0;
+    qint64 rssEnd = -1;
+
+    // Stop: sessions finish their current step, then wait for them (in-flight
+    // requests are aborted after DrainTimeoutMs)
+    QTimer drainTimer;
+    QElapsedTimer draining;
+    QObject::connect(&drainTimer, &QTimer::timeout, &app, [&]() {
+        if (stats.activeSessions() > 0 && draining.elapsed() < DrainTimeoutMs) {
+            return;
+        }
+        drainTimer.stop();
+        app.quit();
+    });
+    QTimer::singleShot(durationMs, &app, [&]() {
+        stats.setStopping();
+        measuredMs = elapsed.nsecsElapsed() / 1e6;
+        cpuMs = processCpuMs() - cpuStartMs;
+        rssEnd = MemoryReport::residentBytes();
+        rssPeak = qMax(rssPeak, rssEnd);
+        rssTimer.stop();
+        draining.start();
+        drainTimer.start(50);
+    });
+
+    app.exec();
+
+    for (int t = 0; t < threads; ++t) {
+        QObject *context = contexts.at(t);
+        // Sessions go first: the thread's network manager is deleted when the
+        // thread finishes, and ApiManager aborts its replies through it
+        QMetaObject::invokeMethod(context, [context]() { delete context; }, Qt::BlockingQueuedConnection);
+        workers.at(t)->quit();
+        workers.at(t)->wait();
+    }
+
+    // Report
+    const QMap<QString, LoadStats::Step> steps = stats.steps();
+    qint64 completed = stats.completedSteps();
+    qint64 failed = stats.failedSteps();
+    double seconds = measuredMs / 1000.0;
+
+    out << Qt::endl << QString("%1 steps in %2 s: %3 steps/s, %4 failed (%5%)")
+                           .arg(completed).arg(seconds, 0, 'f', 1)
+                           .arg(completed / seconds, 0, 'f', 1).arg(failed)
+                           .arg(completed > 0 ? 100.0 * failed / completed : 0.0, 0, 'f', 2)
+        << Qt::endl << Qt::endl;
+
+    out << QString("%1 %2 %3 %4 %5 %6 %7")
+               .arg(QStringLiteral("step"), -22).arg(QStringLiteral("count"), 8)
+               .arg(QStringLiteral("fail"), 6).arg(QStringLiteral("p50"), 8)
+               .arg(QStringLiteral("p95"), 8).arg(QStringLiteral("p99"), 8)
+               .arg(QStringLiteral("max ms"), 8)
+        << Qt::endl;
+    for (auto it = steps.cbegin(); it != steps.cend(); ++it) {
+        const ApiMetrics::Histogram &latency = it.value().latency;
+        QJsonObject json = latency.toJson();
+        out << QString("%1 %2 %3 %4 %5 %6 %7")
+                   .arg(it.key(), -22).arg(latency.count(), 8).arg(it.value().failures, 6)
+                   .arg(latency.percentile(0.50), 8, 'f', 1)
+                   .arg(latency.percentile(0.95), 8, 'f', 1)
+                   .arg(latency.percentile(0.99), 8, 'f', 1)
+                   .arg(json["max"].toDouble(), 8, 'f', 1)
+            << Qt::endl;
+    }
+
+    double cpuPercent = measuredMs > 0 ? 100.0 * cpuMs / measuredMs : 0.0;
+    out << Qt::endl
+        << QString("Client CPU %1 s (%2% of one core), RSS peak %3, at stop %4")
+               .arg(cpuMs / 1000.0, 0, 'f', 1).arg(cpuPercent, 0, 'f', 1)
+               .arg(mib(rssPeak), mib(rssEnd))
+        << Qt::endl;
+
+    if (parser.isSet(jsonOption)) {
+        QJsonObject report{
+            { "config", QJsonObject{
+                  { "url", ApiManager::defaultBaseUrl() },
+                  { "sessions", sessions },
+                  { "threads", threads },
+                  { "durationSeconds", durationMs / 1000 },
+                  { "rampSeconds", rampMs / 1000 },
+                  { "thinkMs", script.thinkMs },
+                  { "pages", script.pages },
+                  { "moderationRate", script.moderationRate },
+                  { "seed", qint64(seed) },
+              } },
+            { "elapsedSeconds", seconds },
+            { "completedSteps", completed },
+            { "failedSteps", failed },
+            { "stepsPerSecond", completed / seconds },
+            { "cpuSeconds", cpuMs / 1000.0 },
+            { "cpuPercent", cpuPercent },
+            { "rssPeakBytes", rssPeak },
+            { "rssEndBytes", rssEnd },
+            { "steps", stats.toJson() },
+            { "network", ApiMetrics::instance()->snapshot() },
+        };
+
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            QTextStream(stderr) << "Cannot write " << file.fileName() << ": " << file.errorString() << Qt::endl;
+            return 1;
+        }
+        file.write(QJsonDocument(report).toJson());
+    }
+
+    return completed > 0 ? 0 : 1;
+}
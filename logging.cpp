@@ -0,0 +1,56 @@
+#include "logging.h"
+#include <QElapsedTimer>
+#include <QMutex>
+#include <atomic>
+
+Q_LOGGING_CATEGORY(lcNetwork, "lumin.network", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcNetworkBody, "lumin.network.body", QtWarningMsg)
+Q_LOGGING_CATEGORY(lcControllers, "lumin.controllers", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcApp, "lumin.app", QtInfoMsg)
+
+namespace Logging {
+
+namespace {
+
+const int MaxBodiesPerSecond = 20;
+
+int sampleEvery()
+{
+    static const int every = qMax(1, qEnvironmentVariableIntValue("LUMIN_LOG_SAMPLE"));
+    return every;
+}
+
+} // namespace
+
+bool shouldLogBody()
+{
+    if (!lcNetworkBody().isDebugEnabled()) {
+        return false;
+    }
+
+    static std::atomic<quint64> seen{0};
+    if (seen.fetch_add(1, std::memory_order_relaxed) % sampleEvery() != 0) {
+        return false;
+    }
+
+    static QMutex mutex;
+    static QElapsedTimer window;
+    static int inWindow = 0;
+
+    QMutexLocker locker(&mutex);
+    if (!window.isValid() || window.elapsed() >= 1000) {
+        window.start();
+        inWindow = 0;
+    }
+    return ++inWindow <= MaxBodiesPerSecond;
+}
+
+QByteArray truncated(const QByteArray &body, int maxBytes)
+{
+    if (body.size() <= maxBytes) {
+        return body;
+    }
+    return body.left(maxBytes) + "... (" + QByteArray::number(body.size()) + " bytes)";
+}
+
+} // namespace Logging
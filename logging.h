@@ -0,0 +1,33 @@
+#ifndef LOGGING_H
+#define LOGGING_H
+
+#include <QByteArray>
+#include <QLoggingCategory>
+
+// Logging categories. Enable with QT_LOGGING_RULES, e.g.
+//   QT_LOGGING_RULES="lumin.network.debug=true;lumin.network.body.debug=true"
+//
+//   lumin.network       requests, connections, uploads; info and up by default
+//   lumin.network.body  response bodies, truncated; off by default
+//   lumin.controllers   controller state changes; info and up by default
+//   lumin.app           startup and shutdown
+//
+// Release builds define QT_NO_DEBUG_OUTPUT, so qCDebug() compiles away there.
+Q_DECLARE_LOGGING_CATEGORY(lcNetwork)
+Q_DECLARE_LOGGING_CATEGORY(lcNetworkBody)
+Q_DECLARE_LOGGING_CATEGORY(lcControllers)
+Q_DECLARE_LOGGING_CATEGORY(lcApp)
+
+namespace Logging {
+
+// Whether this response body should be logged: lumin.network.body is
+// enabled, the body falls in the sample (LUMIN_LOG_SAMPLE=N keeps one in N)
+// and fewer than 20 bodies were logged in the last second.
+bool shouldLogBody();
+
+// The first maxBytes of body, with the total size appended when cut
+QByteArray truncated(const QByteArray &body, int maxBytes = 512);
+
+} // namespace Logging
+
+#endif // LOGGING_H
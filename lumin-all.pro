@@ -0,0 +1,19 @@
+# Everything in the tree: the application, the benchmark and test suites,
+# the mock API server and the load generator. lumin.pro on its own still
+# builds just the application.
+#   qmake ../lumin-all.pro && make && make check
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    app \
+    benchmarks \
+    loadgen \
+    mockserver \
+    tests
+
+app.file = lumin.pro
+benchmarks.file = benchmarks/benchmarks.pro
+loadgen.file = loadgen/loadgen.pro
+mockserver.file = mockserver/mockserver.pro
+tests.file = tests/tests.pro
@@ -0,0 +1,74 @@
+# Everything except main.cpp, shared by the app and the benchmarks
+# (benchmarks/benchmarks.pro)
+
+QT += qml quick quickcontrols2 network
+
+CONFIG += c++17
+
+INCLUDEPATH += $$PWD
+
+# Debug-level logging (qCDebug, see logging.h) is compiled out of release
+# builds; warnings and info still go through QLoggingCategory
+CONFIG(release, debug|release): DEFINES += QT_NO_DEBUG_OUTPUT
+
+# Process memory counters (memoryreport.cpp)
+win32: LIBS += -lpsapi
+
+SOURCES += \
+    $$PWD/admincli.cpp \
+    $$PWD/apimanager.cpp \
+    $$PWD/apimetrics.cpp \
+    $$PWD/apinetworkmanager.cpp \
+    $$PWD/apitraffic.cpp \
+    $$PWD/authcontroller.cpp \
+    $$PWD/chartitem.cpp \
+    $$PWD/chunkeduploader.cpp \
+    $$PWD/coursecontroller.cpp \
+    $$PWD/dashboardcontroller.cpp \
+    $$PWD/diagnosticscontroller.cpp \
+    $$PWD/exportjob.cpp \
+    $$PWD/fallbackreply.cpp \
+    $$PWD/framemonitor.cpp \
+    $$PWD/harlog.cpp \
+    $$PWD/instructorcontroller.cpp \
+    $$PWD/logging.cpp \
+    $$PWD/memoryreport.cpp \
+    $$PWD/notificationcontroller.cpp \
+    $$PWD/payloadfields.cpp \
+    $$PWD/remoteimageprovider.cpp \
+    $$PWD/replayreply.cpp \
+    $$PWD/revenuecontroller.cpp \
+    $$PWD/sessionsnapshot.cpp \
+    $$PWD/startuptrace.cpp \
+    $$PWD/transactioncontroller.cpp \
+    $$PWD/usercontroller.cpp
+
+HEADERS += \
+    $$PWD/admincli.h \
+    $$PWD/apimanager.h \
+    $$PWD/apimetrics.h \
+    $$PWD/apinetworkmanager.h \
+    $$PWD/apitraffic.h \
+    $$PWD/authcontroller.h \
+    $$PWD/chartitem.h \
+    $$PWD/chunkeduploader.h \
+    $$PWD/coursecontroller.h \
+    $$PWD/dashboardcontroller.h \
+    $$PWD/diagnosticscontroller.h \
+    $$PWD/exportjob.h \
+    $$PWD/fallbackreply.h \
+    $$PWD/framemonitor.h \
+    $$PWD/harlog.h \
+    $$PWD/instructorcontroller.h \
+    $$PWD/logging.h \
+    $$PWD/memoryreport.h \
+    $$PWD/notificationcontroller.h \
+    $$PWD/payloadfields.h \
+    $$PWD/qmlsingletons.h \
+    $$PWD/remoteimageprovider.h \
+    $$PWD/replayreply.h \
+    $$PWD/revenuecontroller.h \
+    $$PWD/sessionsnapshot.h \
+    $$PWD/startuptrace.h \
+    $$PWD/transactioncontroller.h \
+    $$PWD/usercontroller.h
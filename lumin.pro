@@ -1,30 +1,16 @@
-QT += quick quickcontrols2 network
+include(lumin.pri)
 
-CONFIG += c++17
+# Controllers are registered as typed singletons of the "Lumin" QML module
+# (see qmlsingletons.h) and the QML in qml.qrc is compiled ahead of time by
+# qmlcachegen, so bindings against them are resolved at build time.
+CONFIG += qmltypes qtquickcompiler
+QML_IMPORT_NAME = Lumin
+QML_IMPORT_MAJOR_VERSION = 1
 
 SOURCES += \
-    coursecontroller.cpp \
-    dashboardcontroller.cpp \
-    instructorcontroller.cpp \
-    main.cpp \
-    apimanager.cpp \
-    authcontroller.cpp \
-    notificationcontroller.cpp \
-    transactioncontroller.cpp \
-    usercontroller.cpp
-
-HEADERS += \
-    apimanager.h \
-    authcontroller.h \
-    coursecontroller.h \
-    dashboardcontroller.h \
-    instructorcontroller.h \
-    notificationcontroller.h \
-    transactioncontroller.h \
-    usercontroller.h
+    main.cpp
 
 RESOURCES += qml.qrc \
     մ.qrc
 
 TARGET = Lumin
-
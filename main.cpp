@@ -1,28 +1,58 @@
 #include <QGuiApplication>
 #include <QIcon>
 #include <QQmlApplicationEngine>
-#include <QQmlContext>
 #include <QQuickStyle>
-#include <QDebug>
+#include <QQuickWindow>
+#include "admincli.h"
+#include "apimetrics.h"
 #include "authcontroller.h"
 #include "dashboardcontroller.h"
+#include "diagnosticscontroller.h"
+#include "framemonitor.h"
 #include "instructorcontroller.h"
 #include "coursecontroller.h"
+#include "logging.h"
 #include "usercontroller.h"
 #include "transactioncontroller.h"
 #include "notificationcontroller.h"
+#include "qmlsingletons.h"
+#include "remoteimageprovider.h"
+#include "revenuecontroller.h"
+#include "sessionsnapshot.h"
+#include "startuptrace.h"
+
+// Shared by the GUI and the headless CLI so both read the same QSettings
+// (stored tokens, cache locations)
+static void setApplicationIdentity()
+{
+    QCoreApplication::setOrganizationName("PicsartAcademy");
+    QCoreApplication::setOrganizationDomain("picsart.academy");
+    QCoreApplication::setApplicationName("Lumin");
+    QCoreApplication::setApplicationVersion("1.0.0");
+}
 
 int main(int argc, char *argv[])
 {
-    qDebug() << "Application starting...";
+    if (AdminCli::handles(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        setApplicationIdentity();
+
+        AdminCli cli;
+        QObject::connect(&cli, &AdminCli::finished, &app, &QCoreApplication::exit, Qt::QueuedConnection);
+        cli.start(app.arguments());
+        return app.exec();
+    }
+
+    qCDebug(lcApp) << "Application starting...";
+    StartupTrace *startupTrace = StartupTrace::instance();
+    StartupTrace::mark("processStart");
 
     QGuiApplication app(argc, argv);
+    StartupTrace::mark("applicationConstructed");
+    startupTrace->start();
 
-    app.setOrganizationName("PicsartAcademy");
-    app.setOrganizationDomain("picsart.academy");
-    app.setApplicationName("Lumin");
+    setApplicationIdentity();
     app.setApplicationDisplayName("Picsart Academy - Lumin");
-    app.setApplicationVersion("1.0.0");
 
     QQuickStyle::setStyle("Material");
 
@@ -36,23 +66,69 @@ int main(int argc, char *argv[])
     UserController *userController = new UserController(&engine);
     TransactionController *transactionController = new TransactionController(&engine);
     NotificationController *notificationController = new NotificationController(&engine);
+    RevenueController *revenueController = new RevenueController(&engine);
+    DiagnosticsController *diagnosticsController = new DiagnosticsController(&engine);
+
+    // The dashboard bootstrap fetches the recent notifications along with
+    // everything else; the notification panel shows them from there
+    QObject::connect(dashboardController, &DashboardController::recentNotificationsBootstrapped,
+                     notificationController, &NotificationController::restoreSnapshot);
+
+    // Model updates are reported with the long frames they cause, and the
+    // models are sized on the diagnostics page
+    const QList<QObject *> watchedControllers = {
+        dashboardController, instructorController, courseController, userController,
+        transactionController, notificationController, revenueController
+    };
+    for (QObject *controller : watchedControllers) {
+        FrameMonitor::instance()->watchSignals(controller);
+    }
 
-    qDebug() << "Controllers created";
-
-    // Set context properties
-    engine.rootContext()->setContextProperty("authController", authController);
-    engine.rootContext()->setContextProperty("dashboardController", dashboardController);
-    engine.rootContext()->setContextProperty("instructorController", instructorController);
-    engine.rootContext()->setContextProperty("courseController", courseController);
-    engine.rootContext()->setContextProperty("userController", userController);
-    engine.rootContext()->setContextProperty("transactionController", transactionController);
-    engine.rootContext()->setContextProperty("notificationController", notificationController);
-
-    qDebug() << "Context properties set";
-
-    // Verify controllers
-    QObject *testAuth = engine.rootContext()->contextProperty("authController").value<QObject*>();
-    qDebug() << "authController verification:" << (testAuth != nullptr ? "OK" : "NULL");
+    qCDebug(lcApp) << "Controllers created";
+    StartupTrace::mark("controllersCreated");
+
+    // Warm start: render the last dashboard state while it revalidates
+    SessionSnapshot *sessionSnapshot = new SessionSnapshot(authController,
+                                                           dashboardController,
+                                                           courseController,
+                                                           instructorController,
+                                                           userController,
+                                                           transactionController,
+                                                           notificationController,
+                                                           &engine);
+    bool warmStart = sessionSnapshot->restore();
+    qCDebug(lcApp) << "Session snapshot restored:" << warmStart;
+
+    // DNS + TCP + TLS to the API host overlaps QML loading; it is repeated
+    // when the window becomes active again after an idle period
+    authController->preconnect();
+
+    QObject::connect(&app, &QCoreApplication::aboutToQuit,
+                     sessionSnapshot, &SessionSnapshot::save);
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [diagnosticsController]() {
+        qCInfo(lcApp).noquote() << "API metrics:\n" + ApiMetrics::instance()->summary();
+        diagnosticsController->dumpNow();
+    });
+
+    // Expose the instances as singletons of the Lumin QML module
+    AuthControllerForeign::s_instance = authController;
+    DashboardControllerForeign::s_instance = dashboardController;
+    InstructorControllerForeign::s_instance = instructorController;
+    CourseControllerForeign::s_instance = courseController;
+    UserControllerForeign::s_instance = userController;
+    TransactionControllerForeign::s_instance = transactionController;
+    NotificationControllerForeign::s_instance = notificationController;
+    RevenueControllerForeign::s_instance = revenueController;
+    DiagnosticsControllerForeign::s_instance = diagnosticsController;
+    SessionSnapshotForeign::s_instance = sessionSnapshot;
+
+    qCDebug(lcApp) << "QML singletons set";
+
+    // Avatars and course thumbnails: image://remote/<encoded url>
+    RemoteImageProvider *imageProvider = new RemoteImageProvider;
+    engine.addImageProvider("remote", imageProvider);
+
+    diagnosticsController->setMemorySources(&engine, imageProvider->loader(), watchedControllers);
 
     const QUrl url(QStringLiteral("qrc:/new/prefix1/Main.qml"));
 
@@ -70,7 +146,13 @@ int main(int argc, char *argv[])
         return -1;
     }
 
-    qDebug() << "QML loaded successfully";
+    qCDebug(lcApp) << "QML loaded successfully";
+    StartupTrace::mark("qmlEngineLoaded");
+
+    if (QQuickWindow *window = qobject_cast<QQuickWindow *>(engine.rootObjects().first())) {
+        startupTrace->attachWindow(window);
+        FrameMonitor::instance()->attachWindow(window);
+    }
 
     return app.exec();
 }
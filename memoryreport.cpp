@@ -0,0 +1,132 @@
+#include "memoryreport.h"
+#include <QFile>
+#include <QStringList>
+#include <QVariantHash>
+#include <QVariantMap>
+
+#if defined(Q_OS_WIN)
+#  include <windows.h>
+#  include <psapi.h>
+#elif defined(Q_OS_MACOS)
+#  include <mach/mach.h>
+#elif defined(Q_OS_LINUX)
+#  include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+#  include <malloc.h>
+#endif
+
+namespace {
+
+const qint64 VariantBytes = sizeof(QVariant);
+const qint64 ArrayHeaderBytes = 24;       // QArrayData + alignment
+const qint64 MapNodeBytes = 32;           // red-black tree node links
+const qint64 HashNodeBytes = 16;
+const int SampleThreshold = 1000;
+const int SampleSize = 256;
+
+qint64 stringBytes(const QString &string)
+{
+    return string.isNull() ? 0 : ArrayHeaderBytes + (string.size() + 1) * 2;
+}
+
+qint64 listBytes(const QVariantList &list)
+{
+    qint64 bytes = ArrayHeaderBytes + list.size() * VariantBytes;
+    if (list.size() <= SampleThreshold) {
+        for (const QVariant &item : list) {
+            bytes += MemoryReport::estimateBytes(item);
+        }
+        return bytes;
+    }
+
+    qint64 sampled = 0;
+    qsizetype step = list.size() / SampleSize;
+    for (int i = 0; i < SampleSize; ++i) {
+        sampled += MemoryReport::estimateBytes(list.at(i * step));
+    }
+    return bytes + sampled * list.size() / SampleSize;
+}
+
+} // namespace
+
+qint64 MemoryReport::estimateBytes(const QVariant &value)
+{
+    switch (value.typeId()) {
+    case QMetaType::QString:
+        return stringBytes(value.toString());
+    case QMetaType::QByteArray:
+        return ArrayHeaderBytes + value.toByteArray().size();
+    case QMetaType::QStringList: {
+        const QStringList strings = value.toStringList();
+        qint64 bytes = ArrayHeaderBytes + strings.size() * qint64(sizeof(QString));
+        for (const QString &string : strings) {
+            bytes += stringBytes(string);
+        }
+        return bytes;
+    }
+    case QMetaType::QVariantList:
+        return listBytes(value.toList());
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = value.toMap();
+        qint64 bytes = 48;
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            bytes += MapNodeBytes + qint64(sizeof(QString)) + VariantBytes
+                     + stringBytes(it.key()) + estimateBytes(it.value());
+        }
+        return bytes;
+    }
+    case QMetaType::QVariantHash: {
+        const QVariantHash hash = value.toHash();
+        qint64 bytes = 48;
+        for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+            bytes += HashNodeBytes + qint64(sizeof(QString)) + VariantBytes
+                     + stringBytes(it.key()) + estimateBytes(it.value());
+        }
+        return bytes;
+    }
+    default:
+        // Numbers, bools, dates: stored inside the QVariant itself
+        return 0;
+    }
+}
+
+qint64 MemoryReport::residentBytes()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return qint64(counters.WorkingSetSize);
+    }
+    return -1;
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+        return qint64(info.resident_size);
+    }
+    return -1;
+#elif defined(Q_OS_LINUX)
+    // statm: size resident shared ... in pages
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+    QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2) {
+        return -1;
+    }
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#else
+    return -1;
+#endif
+}
+
+void MemoryReport::releaseFreeHeap()
+{
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
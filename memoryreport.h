@@ -0,0 +1,28 @@
+#ifndef MEMORYREPORT_H
+#define MEMORYREPORT_H
+
+#include <QVariant>
+#include <QVariantList>
+
+// Approximate memory accounting for the diagnostics page. The estimates
+// count Qt's container and string layouts on a 64-bit build (QVariant is
+// 32 bytes, QString 24 + 2 per character, a QVariantMap node about 88
+// bytes plus its key and value) and treat implicitly shared data as owned
+// by every holder, so they err high. Good enough to tell a 2 MiB list from
+// a 200 MiB one, which is what sizing caches needs.
+namespace MemoryReport {
+
+// Resident set size of the process, or -1 where it cannot be read
+qint64 residentBytes();
+
+// Approximate heap bytes held by a value, including nested lists and maps.
+// Lists over 1000 rows are estimated from an evenly spaced sample.
+qint64 estimateBytes(const QVariant &value);
+
+// Hands freed heap pages back to the OS where the allocator supports it
+// (glibc); a no-op elsewhere
+void releaseFreeHeap();
+
+} // namespace MemoryReport
+
+#endif // MEMORYREPORT_H
@@ -0,0 +1,300 @@
+#include "dataset.h"
+#include <QDateTime>
+#include <algorithm>
+
+namespace {
+
+const char *const FirstNames[] = {
+    "Anna", "Aram", "Lilit", "Davit", "Mariam", "Narek", "Sona", "Tigran",
+    "Ani", "Hayk", "Gayane", "Armen", "Nare", "Vahe", "Elen", "Karen"
+};
+const char *const LastNames[] = {
+    "Hakobyan", "Petrosyan", "Sargsyan", "Grigoryan", "Avetisyan",
+    "Karapetyan", "Harutyunyan", "Mkrtchyan", "Vardanyan", "Ghazaryan"
+};
+const char *const Topics[] = {
+    "Photo Editing", "Motion Design", "Illustration", "Typography", "Brand Identity",
+    "UI Design", "Color Grading", "Video Editing", "3D Basics", "Portrait Retouching"
+};
+const char *const Levels[] = { "beginner", "intermediate", "advanced" };
+const char *const CourseStatuses[] = { "published", "published", "published", "pending_review", "draft", "rejected" };
+const char *const InstructorStatuses[] = { "verified", "verified", "verified", "pending", "rejected" };
+const char *const TransactionStatuses[] = { "completed", "completed", "completed", "completed", "pending", "failed", "refunded" };
+const char *const PaymentMethods[] = { "card", "card", "paypal", "bank_transfer" };
+const char *const NotificationTypes[] = { "instructor_registration", "course_submitted", "payment_received", "system" };
+
+template <size_t N>
+const char *pick(QRandomGenerator &random, const char *const (&values)[N])
+{
+    return values[random.bounded(int(N))];
+}
+
+bool newerFirst(const QJsonObject &a, const QJsonObject &b)
+{
+    return a["createdAt"].toString() > b["createdAt"].toString();
+}
+
+} // namespace
+
+Dataset::Dataset(const Sizes &sizes, quint32 seed)
+    : m_random(seed)
+    , m_nextId(1)
+{
+    user["id"] = id("usr");
+    user["firstName"] = "Mock";
+    user["lastName"] = "Admin";
+    user["email"] = "admin@lumin.test";
+    user["role"] = "admin";
+    user["image"] = QString();
+
+    for (int i = 0; i < sizes.students; ++i) {
+        QJsonObject s;
+        s["id"] = id("stu");
+        personName(&s);
+        s["isActive"] = m_random.bounded(100) < 80;
+        s["profileImage"] = QString();
+        s["createdAt"] = isoDaysAgo(m_random.bounded(365.0));
+        students.append(s);
+    }
+
+    for (int i = 0; i < sizes.instructors; ++i) {
+        QJsonObject s;
+        s["id"] = id("ins");
+        personName(&s);
+        s["instructorStatus"] = pick(m_random, InstructorStatuses);
+        s["image"] = QString();
+        s["createdAt"] = isoDaysAgo(m_random.bounded(365.0));
+        instructors.append(s);
+    }
+    std::sort(instructors.begin(), instructors.end(), newerFirst);
+
+    for (int i = 0; i < sizes.courses; ++i) {
+        QJsonObject instructor = instructors.isEmpty() ? QJsonObject()
+                                                       : instructors.at(m_random.bounded(instructors.size()));
+        bool isFree = m_random.bounded(100) < 15;
+
+        QJsonObject c;
+        c["id"] = id("crs");
+        c["title"] = QString("%1 %2").arg(pick(m_random, Topics)).arg(i + 1);
+        c["description"] = "Generated course for load testing.";
+        c["category"] = pick(m_random, Topics);
+        c["level"] = pick(m_random, Levels);
+        c["status"] = pick(m_random, CourseStatuses);
+        c["isFree"] = isFree;
+        c["price"] = isFree ? 0.0 : 9.99 + m_random.bounded(20) * 5;
+        c["thumbnail"] = QString();
+        c["rating"] = 3.0 + m_random.bounded(20) / 10.0;
+        c["reviewCount"] = m_random.bounded(400);
+        c["enrollmentCount"] = m_random.bounded(5000);
+        c["sectionsCount"] = 1 + m_random.bounded(12);
+        c["lessonsCount"] = 3 + m_random.bounded(80);
+        c["instructor"] = QJsonObject{
+            { "id", instructor["id"] },
+            { "name", instructor["firstName"].toString() + " " + instructor["lastName"].toString() },
+            { "email", instructor["email"] },
+        };
+        c["createdAt"] = isoDaysAgo(m_random.bounded(365.0));
+        courses.append(c);
+    }
+    std::sort(courses.begin(), courses.end(), newerFirst);
+
+    for (int i = 0; i < sizes.transactions; ++i) {
+        QJsonObject student = students.isEmpty() ? QJsonObject()
+                                                 : students.at(m_random.bounded(students.size()));
+
+        QJsonArray items;
+        double amount = 0.0;
+        int itemCount = courses.isEmpty() ? 0 : 1 + (m_random.bounded(100) < 20 ? m_random.bounded(3) : 0);
+        for (int c = 0; c < itemCount; ++c) {
+            QJsonObject course = courses.at(m_random.bounded(courses.size()));
+            amount += course["price"].toDouble();
+            items.append(QJsonObject{
+                { "courseId", course["id"] },
+                { "title", course["title"] },
+                { "price", course["price"] },
+            });
+        }
+
+        QJsonObject t;
+        t["orderId"] = id("ord");
+        t["orderNumber"] = QString("ORD-%1").arg(100000 + i);
+        t["amount"] = amount;
+        t["status"] = pick(m_random, TransactionStatuses);
+        t["paymentMethod"] = pick(m_random, PaymentMethods);
+        t["createdAt"] = isoDaysAgo(m_random.bounded(120.0));
+        t["student"] = QJsonObject{
+            { "id", student["id"] },
+            { "name", student["firstName"].toString() + " " + student["lastName"].toString() },
+            { "email", student["email"] },
+            { "profileImage", student["profileImage"] },
+        };
+        t["courses"] = items;
+        transactions.append(t);
+    }
+    std::sort(transactions.begin(), transactions.end(), newerFirst);
+
+    for (int i = 0; i < sizes.notifications; ++i) {
+        QJsonObject n;
+        n["id"] = id("ntf");
+        n["type"] = pick(m_random, NotificationTypes);
+        n["title"] = QString("Notification %1").arg(i + 1);
+        n["message"] = "Generated notification for load testing.";
+        n["isRead"] = m_random.bounded(100) < 60;
+        n["actionUrl"] = QString();
+        n["createdAt"] = isoDaysAgo(m_random.bounded(30.0));
+        notifications.append(n);
+    }
+    std::sort(notifications.begin(), notifications.end(), newerFirst);
+
+    // Recent activity: the newest enrollments
+    for (int i = 0; i < transactions.size() && i < 50; ++i) {
+        const QJsonObject &t = transactions.at(i);
+        QJsonObject student = t["student"].toObject();
+        QJsonArray items = t["courses"].toArray();
+        QString title = items.isEmpty() ? QString() : items.first().toObject()["title"].toString();
+
+        activities.append(QJsonObject{
+            { "id", id("act") },
+            { "type", "enrollment" },
+            { "message", student["name"].toString() + " enrolled in " + title },
+            { "student", student },
+            { "course", QJsonObject{ { "title", title } } },
+            { "createdAt", t["createdAt"] },
+        });
+    }
+}
+
+QString Dataset::id(const char *prefix)
+{
+    // Digits in every id, like the real ObjectIds (ApiMetrics folds on them)
+    return QString("%1_%2").arg(QLatin1String(prefix)).arg(m_nextId++, 8, 10, QChar('0'));
+}
+
+QString Dataset::isoDaysAgo(double days) const
+{
+    static const QDateTime now = QDateTime::currentDateTimeUtc();
+    return now.addMSecs(-qint64(days * 24 * 3600 * 1000)).toString(Qt::ISODateWithMs);
+}
+
+QString Dataset::personName(QJsonObject *person)
+{
+    QString first = pick(m_random, FirstNames);
+    QString last = pick(m_random, LastNames);
+    (*person)["firstName"] = first;
+    (*person)["lastName"] = last;
+    (*person)["email"] = QString("%1.%2.%3@example.com")
+                             .arg(first.toLower(), last.toLower())
+                             .arg(m_nextId);
+    return first + " " + last;
+}
+
+int Dataset::indexOf(const QVector<QJsonObject> &rows, const QString &key, const QString &id)
+{
+    for (int i = 0; i < rows.size(); ++i) {
+        if (rows.at(i)[key].toString() == id) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+QJsonObject Dataset::instructorStats() const
+{
+    int pending = 0, verified = 0, rejected = 0;
+    for (const QJsonObject &i : instructors) {
+        QString status = i["instructorStatus"].toString();
+        pending += status == "pending";
+        verified += status == "verified";
+        rejected += status == "rejected";
+    }
+    return QJsonObject{
+        { "total", int(instructors.size()) },
+        { "pending", pending },
+        { "verified", verified },
+        { "rejected", rejected },
+    };
+}
+
+QJsonObject Dataset::studentStats() const
+{
+    int active = 0;
+    for (const QJsonObject &s : students) {
+        active += s["isActive"].toBool();
+    }
+    return QJsonObject{
+        { "total", int(students.size()) },
+        { "active", active },
+        { "inactive", int(students.size()) - active },
+    };
+}
+
+QJsonObject Dataset::courseStats() const
+{
+    QJsonObject stats{ { "total", int(courses.size()) } };
+    for (const char *status : { "draft", "pending_review", "published", "rejected" }) {
+        int count = 0;
+        for (const QJsonObject &c : courses) {
+            count += c["status"].toString() == QLatin1String(status);
+        }
+        stats[QLatin1String(status)] = count;
+    }
+    return stats;
+}
+
+QJsonObject Dataset::transactionSummary() const
+{
+    QString monthStart = QDateTime::currentDateTimeUtc().toString("yyyy-MM-01");
+    double total = 0.0, thisMonth = 0.0;
+    for (const QJsonObject &t : transactions) {
+        if (t["status"].toString() != "completed") {
+            continue;
+        }
+        total += t["amount"].toDouble();
+        if (t["createdAt"].toString() >= monthStart) {
+            thisMonth += t["amount"].toDouble();
+        }
+    }
+    return QJsonObject{
+        { "totalRevenue", total },
+        { "thisMonthRevenue", thisMonth },
+        { "totalTransactions", int(transactions.size()) },
+    };
+}
+
+QJsonObject Dataset::dashboardStats() const
+{
+    QJsonObject instructorCounts = instructorStats();
+    QJsonObject studentCounts = studentStats();
+    QJsonObject courseCounts = courseStats();
+    QJsonObject revenue = transactionSummary();
+
+    return QJsonObject{
+        { "instructors", QJsonObject{
+              { "total", instructorCounts["total"] },
+              { "verified", instructorCounts["verified"] },
+              { "pending", instructorCounts["pending"] },
+          } },
+        { "students", QJsonObject{
+              { "total", studentCounts["total"] },
+              { "active", studentCounts["active"] },
+          } },
+        { "courses", QJsonObject{
+              { "total", courseCounts["total"] },
+              { "active", courseCounts["published"] },
+              { "draft", courseCounts["draft"] },
+          } },
+        { "revenue", QJsonObject{
+              { "total", revenue["totalRevenue"] },
+              { "thisMonth", revenue["thisMonthRevenue"] },
+          } },
+    };
+}
+
+int Dataset::unreadCount() const
+{
+    int unread = 0;
+    for (const QJsonObject &n : notifications) {
+        unread += !n["isRead"].toBool();
+    }
+    return unread;
+}
@@ -0,0 +1,53 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QString>
+#include <QVector>
+
+// Generated records served by MockServer. The same sizes and seed always
+// produce the same data, so runs can be compared. Rows are kept as the
+// JSON objects the real API returns; list endpoints filter and page them.
+class Dataset
+{
+public:
+    struct Sizes {
+        int students = 500;
+        int instructors = 60;
+        int courses = 120;
+        int transactions = 5000;
+        int notifications = 200;
+    };
+
+    Dataset(const Sizes &sizes, quint32 seed);
+
+    QJsonObject user;
+    QVector<QJsonObject> students;
+    QVector<QJsonObject> instructors;
+    QVector<QJsonObject> courses;
+    QVector<QJsonObject> transactions;     // newest first
+    QVector<QJsonObject> notifications;    // newest first
+    QVector<QJsonObject> activities;       // newest first
+
+    QJsonObject dashboardStats() const;
+    QJsonObject instructorStats() const;
+    QJsonObject studentStats() const;
+    QJsonObject courseStats() const;
+    QJsonObject transactionSummary() const;
+    int unreadCount() const;
+
+    // Index of the row with this id, or -1
+    static int indexOf(const QVector<QJsonObject> &rows, const QString &key, const QString &id);
+
+private:
+    QString id(const char *prefix);
+    QString isoDaysAgo(double days) const;
+    QString personName(QJsonObject *person);
+
+    QRandomGenerator m_random;
+    qint64 m_nextId;
+};
+
+#endif // DATASET_H
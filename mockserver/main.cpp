@@ -0,0 +1,60 @@
+#include "mockserver.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QHostAddress>
+#include <QTextStream>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("lumin-mockserver");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Local mock of the Lumin API for performance testing.\n"
+                                     "Run the app with LUMIN_API_BASE_URL=http://127.0.0.1:<port>.");
+    parser.addHelpOption();
+
+    QCommandLineOption portOption("port", "Port to listen on (default 8787).", "port", "8787");
+    QCommandLineOption studentsOption("students", "Number of students.", "n", "500");
+    QCommandLineOption instructorsOption("instructors", "Number of instructors.", "n", "60");
+    QCommandLineOption coursesOption("courses", "Number of courses.", "n", "120");
+    QCommandLineOption transactionsOption("transactions", "Number of transactions.", "n", "5000");
+    QCommandLineOption notificationsOption("notifications", "Number of notifications.", "n", "200");
+    QCommandLineOption seedOption("seed", "Dataset and fault injection seed.", "seed", "1");
+    QCommandLineOption latencyOption("latency", "Added latency per response, in ms.", "ms", "0");
+    QCommandLineOption jitterOption("jitter", "Random extra latency up to this many ms.", "ms", "0");
+    QCommandLineOption bandwidthOption("bandwidth", "Per-connection bandwidth in KiB/s (0 = unlimited).", "kib", "0");
+    QCommandLineOption errorRateOption("error-rate", "Fraction of responses replaced by a 500/503.", "rate", "0");
+    QCommandLineOption noAuthOption("no-auth", "Do not require an Authorization header.");
+    QCommandLineOption compressOption("compress", "Deflate responses of 1 KiB and up when the client accepts it.");
+
+    parser.addOptions({ portOption, studentsOption, instructorsOption, coursesOption,
+                        transactionsOption, notificationsOption, seedOption, latencyOption,
+                        jitterOption, bandwidthOption, errorRateOption, noAuthOption,
+                        compressOption });
+    parser.process(app);
+
+    Dataset::Sizes sizes;
+    sizes.students = parser.value(studentsOption).toInt();
+    sizes.instructors = parser.value(instructorsOption).toInt();
+    sizes.courses = parser.value(coursesOption).toInt();
+    sizes.transactions = parser.value(transactionsOption).toInt();
+    sizes.notifications = parser.value(notificationsOption).toInt();
+
+    MockServer::Options options;
+    options.latencyMs = parser.value(latencyOption).toInt();
+    options.jitterMs = parser.value(jitterOption).toInt();
+    options.bandwidthBytesPerSecond = parser.value(bandwidthOption).toInt() * 1024;
+    options.errorRate = qBound(0.0, parser.value(errorRateOption).toDouble(), 1.0);
+    options.requireAuth = !parser.isSet(noAuthOption);
+    options.compress = parser.isSet(compressOption);
+
+    MockServer server(sizes, parser.value(seedOption).toUInt(), options);
+    if (!server.listen(QHostAddress::LocalHost, quint16(parser.value(portOption).toUInt()))) {
+        QTextStream(stderr) << "Cannot listen: " << server.errorString() << Qt::endl;
+        return 1;
+    }
+
+    QTextStream(stdout) << "Mock API listening on http://127.0.0.1:" << server.serverPort() << Qt::endl;
+    return app.exec();
+}
@@ -0,0 +1,647 @@
+#include "mockserver.h"
+#include <QCryptographicHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTcpSocket>
+#include <QTextStream>
+#include <QTimer>
+
+namespace {
+
+const int MaxHeaderBytes = 64 * 1024;
+const int ThrottleTickMs = 50;
+
+QByteArray reasonPhrase(int status)
+{
+    switch (status) {
+    case 200: return "OK";
+    case 201: return "Created";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 404: return "Not Found";
+    case 410: return "Gone";
+    case 422: return "Unprocessable Entity";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default:  return "Unknown";
+    }
+}
+
+QString token(const char *kind, QRandomGenerator &random)
+{
+    return QString("mock-%1-%2").arg(QLatin1String(kind)).arg(random.generate64(), 16, 16, QChar('0'));
+}
+
+} // namespace
+
+QJsonObject MockServer::Request::json() const
+{
+    return QJsonDocument::fromJson(body).object();
+}
+
+MockServer::MockServer(const Dataset::Sizes &sizes, quint32 seed, const Options &options,
+                       QObject *parent)
+    : QObject(parent)
+    , m_data(sizes, seed)
+    , m_options(options)
+    , m_random(seed ^ 0x5eed)
+    , m_nextUpload(1)
+{
+    connect(&m_server, &QTcpServer::newConnection, this, &MockServer::onNewConnection);
+}
+
+MockServer::~MockServer()
+{
+}
+
+bool MockServer::listen(const QHostAddress &address, quint16 port)
+{
+    return m_server.listen(address, port);
+}
+
+// ---------------------------------------------------------------------------
+// Connections
+// ---------------------------------------------------------------------------
+
+void MockServer::onNewConnection()
+{
+    while (QTcpSocket *socket = m_server.nextPendingConnection()) {
+        m_connections.insert(socket, Connection());
+
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            onReadyRead(socket);
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_connections.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MockServer::onReadyRead(QTcpSocket *socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) {
+        return;
+    }
+
+    it->buffer += socket->readAll();
+    if (!it->busy) {
+        processNext(socket);
+    }
+}
+
+void MockServer::processNext(QTcpSocket *socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end() || it->busy) {
+        return;
+    }
+
+    Request request;
+    bool complete = false;
+    if (!parseRequest(&it->buffer, &request, &complete)) {
+        it->closeAfter = true;
+        it->busy = true;
+        respond(socket, request, error(400, "Malformed request"));
+        return;
+    }
+    if (!complete) {
+        return;
+    }
+
+    it->busy = true;
+    it->closeAfter = request.headers.value("connection").toLower() == "close";
+
+    int delay = m_options.latencyMs;
+    if (m_options.jitterMs > 0) {
+        delay += m_random.bounded(m_options.jitterMs + 1);
+    }
+
+    // The socket is the context: a client that hangs up cancels the reply
+    QTimer::singleShot(delay, socket, [this, socket, request]() {
+        Response response;
+        if (m_options.errorRate > 0.0 && m_random.generateDouble() < m_options.errorRate) {
+            response = m_random.bounded(2) == 0 ? error(500, "Injected server error", "MOCK_FAILURE")
+                                                : error(503, "Injected overload", "MOCK_UNAVAILABLE");
+        } else {
+            response = route(request);
+        }
+        respond(socket, request, response);
+    });
+}
+
+bool MockServer::parseRequest(QByteArray *buffer, Request *request, bool *complete)
+{
+    *complete = false;
+
+    int headerEnd = buffer->indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        return buffer->size() <= MaxHeaderBytes;
+    }
+
+    QList<QByteArray> lines = buffer->left(headerEnd).split('\n');
+    QList<QByteArray> requestLine = lines.takeFirst().trimmed().split(' ');
+    if (requestLine.size() != 3) {
+        return false;
+    }
+
+    for (const QByteArray &line : lines) {
+        int colon = line.indexOf(':');
+        if (colon > 0) {
+            request->headers.insert(line.left(colon).trimmed().toLower(), line.mid(colon + 1).trimmed());
+        }
+    }
+
+    qint64 length = request->headers.value("content-length").toLongLong();
+    qint64 total = headerEnd + 4 + length;
+    if (buffer->size() < total) {
+        return true;
+    }
+
+    QUrl url = QUrl::fromEncoded(requestLine.at(1));
+    request->method = requestLine.at(0).toUpper();
+    request->path = url.path();
+    request->query = QUrlQuery(url);
+    request->body = buffer->mid(headerEnd + 4, length);
+    buffer->remove(0, total);
+
+    *complete = true;
+    return true;
+}
+
+void MockServer::respond(QTcpSocket *socket, const Request &request, const Response &response)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) {
+        return;
+    }
+
+    QByteArray body = QJsonDocument(response.body).toJson(QJsonDocument::Compact);
+
+    // HTTP's "deflate" is a zlib stream, which is qCompress() without its
+    // four-byte length prefix
+    bool deflate = m_options.compress && body.size() >= 1024
+                   && request.headers.value("accept-encoding").contains("deflate");
+    if (deflate) {
+        body = qCompress(body).mid(4);
+    }
+
+    QByteArray head;
+    head += "HTTP/1.1 " + QByteArray::number(response.status) + " " + reasonPhrase(response.status) + "\r\n";
+    head += "Content-Type: application/json\r\n";
+    if (deflate) {
+        head += "Content-Encoding: deflate\r\n";
+    }
+    head += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    head += "Connection: " + QByteArray(it->closeAfter ? "close" : "keep-alive") + "\r\n";
+    head += "\r\n";
+
+    QTextStream(stdout) << request.method << ' ' << request.path << ' ' << response.status
+                        << ' ' << body.size() << Qt::endl;
+
+    if (m_options.bandwidthBytesPerSecond <= 0) {
+        socket->write(head + body);
+        finishResponse(socket);
+        return;
+    }
+
+    it->pending = head + body;
+    if (!it->throttle) {
+        it->throttle = new QTimer(socket);
+        it->throttle->setInterval(ThrottleTickMs);
+        connect(it->throttle, &QTimer::timeout, this, [this, socket]() {
+            writeThrottled(socket);
+        });
+    }
+    it->throttle->start();
+    writeThrottled(socket);
+}
+
+void MockServer::writeThrottled(QTcpSocket *socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) {
+        return;
+    }
+
+    int perTick = qMax(1, m_options.bandwidthBytesPerSecond * ThrottleTickMs / 1000);
+    socket->write(it->pending.left(perTick));
+    it->pending.remove(0, perTick);
+
+    if (it->pending.isEmpty()) {
+        it->throttle->stop();
+        finishResponse(socket);
+    }
+}
+
+void MockServer::finishResponse(QTcpSocket *socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) {
+        return;
+    }
+
+    it->busy = false;
+    if (it->closeAfter) {
+        socket->disconnectFromHost();
+        return;
+    }
+
+    // Pipelined requests already buffered
+    if (!it->buffer.isEmpty()) {
+        processNext(socket);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Routing
+// ---------------------------------------------------------------------------
+
+MockServer::Response MockServer::ok(const QJsonObject &data, const QString &message)
+{
+    Response response;
+    response.body["success"] = true;
+    response.body["data"] = data;
+    if (!message.isEmpty()) {
+        response.body["message"] = message;
+    }
+    return response;
+}
+
+MockServer::Response MockServer::error(int status, const QString &message, const QString &code)
+{
+    Response response;
+    response.status = status;
+    response.body["success"] = false;
+    response.body["message"] = message;
+    if (!code.isEmpty()) {
+        response.body["code"] = code;
+    }
+    return response;
+}
+
+QJsonObject MockServer::page(const QVector<QJsonObject> &rows, const QUrlQuery &query,
+                             const QString &key, int defaultLimit)
+{
+    int limit = query.hasQueryItem("limit") ? query.queryItemValue("limit").toInt() : defaultLimit;
+    if (limit <= 0) {
+        limit = qMax(1, int(rows.size()));
+    }
+    int pages = qMax(1, int((rows.size() + limit - 1) / limit));
+    int pageNumber = qBound(1, query.queryItemValue("page").toInt(), pages);
+    if (!query.hasQueryItem("page")) {
+        pageNumber = 1;
+    }
+
+    QStringList fields;
+    if (query.hasQueryItem("fields")) {
+        fields = query.queryItemValue("fields").split(',', Qt::SkipEmptyParts);
+    }
+
+    QJsonArray slice;
+    int start = (pageNumber - 1) * limit;
+    for (int i = start; i < rows.size() && i < start + limit; ++i) {
+        slice.append(fields.isEmpty() ? rows.at(i) : project(rows.at(i), fields));
+    }
+
+    return QJsonObject{
+        { key, slice },
+        { "pagination", QJsonObject{
+              { "page", pageNumber },
+              { "limit", limit },
+              { "total", int(rows.size()) },
+              { "pages", pages },
+          } },
+    };
+}
+
+QJsonObject MockServer::project(const QJsonObject &row, const QStringList &fields)
+{
+    QJsonObject projected;
+    for (const QString &field : fields) {
+        if (row.contains(field)) {
+            projected[field] = row[field];
+        }
+    }
+    return projected;
+}
+
+bool MockServer::matches(const QJsonObject &row, const QString &search, const QStringList &keys)
+{
+    if (search.isEmpty()) {
+        return true;
+    }
+    for (const QString &key : keys) {
+        if (row[key].toString().contains(search, Qt::CaseInsensitive)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+MockServer::Response MockServer::route(const Request &request)
+{
+    QStringList parts = request.path.split('/', Qt::SkipEmptyParts);
+    if (parts.size() < 2 || parts.first() != "api") {
+        return error(404, "Not found");
+    }
+    parts.removeFirst();
+    QString resource = parts.takeFirst();
+
+    if (resource == "auth" && !parts.isEmpty()) {
+        return handleAuth(request, parts.first());
+    }
+
+    if (m_options.requireAuth && !request.headers.value("authorization").startsWith("Bearer ")) {
+        return error(401, "Authentication required", "UNAUTHORIZED");
+    }
+
+    if (resource == "user" && !parts.isEmpty()) {
+        return handleUser(request, parts.first());
+    }
+    if (resource == "dashboard" && parts.value(0) == "stats") {
+        return ok(m_data.dashboardStats());
+    }
+    if (resource == "dashboard" && parts.value(0) == "activity") {
+        int limit = request.query.queryItemValue("limit").toInt();
+        QJsonArray activities;
+        for (int i = 0; i < m_data.activities.size() && (limit <= 0 || i < limit); ++i) {
+            activities.append(m_data.activities.at(i));
+        }
+        return ok(QJsonObject{ { "activities", activities }, { "total", int(m_data.activities.size()) } });
+    }
+    if (resource == "instructors") {
+        return handleInstructors(request, parts);
+    }
+    if (resource == "courses") {
+        return handleCourses(request, parts);
+    }
+    if (resource == "students") {
+        return handleStudents(request);
+    }
+    if (resource == "transactions") {
+        return handleTransactions(request);
+    }
+    if (resource == "notifications") {
+        return handleNotifications(request, parts);
+    }
+    if (resource == "uploads") {
+        return handleUploads(request, parts);
+    }
+
+    return error(404, "Not found");
+}
+
+MockServer::Response MockServer::handleAuth(const Request &request, const QString &action)
+{
+    QJsonObject json = request.json();
+
+    if (action == "login") {
+        QString email = json["email"].toString();
+        if (email.isEmpty() || json["password"].toString().isEmpty()) {
+            return error(400, "Invalid email or password", "INVALID_CREDENTIALS");
+        }
+        QString masked = email.left(1) + "***" + email.mid(email.indexOf('@'));
+        return ok(QJsonObject{ { "sessionToken", token("session", m_random) }, { "maskedEmail", masked } });
+    }
+    if (action == "verify-login") {
+        return ok(QJsonObject{
+            { "accessToken", token("access", m_random) },
+            { "refreshToken", token("refresh", m_random) },
+            { "user", m_data.user },
+        });
+    }
+    if (action == "refresh") {
+        return ok(QJsonObject{ { "accessToken", token("access", m_random) } });
+    }
+    if (action == "register") {
+        return ok(QJsonObject{ { "userId", token("user", m_random) }, { "email", json["email"] } });
+    }
+    if (action == "forgot-password") {
+        return ok(QJsonObject(), "If the account exists, a reset link has been sent");
+    }
+    if (action == "reset-password") {
+        return ok();
+    }
+
+    return error(404, "Not found");
+}
+
+MockServer::Response MockServer::handleUser(const Request &request, const QString &action)
+{
+    if (action == "profile" && request.method == "GET") {
+        return ok(m_data.user);
+    }
+    if (action == "profile" && request.method == "PUT") {
+        QJsonObject json = request.json();
+        for (const char *key : { "firstName", "lastName" }) {
+            if (json.contains(QLatin1String(key))) {
+                m_data.user[QLatin1String(key)] = json[QLatin1String(key)];
+            }
+        }
+        return ok(m_data.user);
+    }
+    if (action == "change-password") {
+        return ok();
+    }
+    if (action == "upload-image") {
+        m_data.user["image"] = QString("https://example.com/avatars/%1.jpg").arg(m_random.bounded(100000));
+        return ok(QJsonObject{ { "imageUrl", m_data.user["image"] } });
+    }
+    if (action == "remove-image") {
+        m_data.user["image"] = QString();
+        return ok(m_data.user);
+    }
+
+    return error(404, "Not found");
+}
+
+MockServer::Response MockServer::handleInstructors(const Request &request, const QStringList &parts)
+{
+    if (parts.size() == 2 && parts.at(1) == "status" && request.method == "PUT") {
+        int index = Dataset::indexOf(m_data.instructors, "id", parts.at(0));
+        if (index < 0) {
+            return error(404, "Instructor not found");
+        }
+        m_data.instructors[index]["instructorStatus"] = request.json()["status"];
+        return ok(m_data.instructors.at(index));
+    }
+
+    QString status = request.query.queryItemValue("status");
+    QString search = request.query.queryItemValue("search", QUrl::FullyDecoded);
+
+    QJsonArray rows;
+    for (const QJsonObject &row : m_data.instructors) {
+        if ((status.isEmpty() || status == "all" || row["instructorStatus"].toString() == status)
+            && matches(row, search, { "firstName", "lastName", "email" })) {
+            rows.append(row);
+        }
+    }
+
+    return ok(QJsonObject{ { "instructors", rows }, { "stats", m_data.instructorStats() } });
+}
+
+MockServer::Response MockServer::handleCourses(const Request &request, const QStringList &parts)
+{
+    if (!parts.isEmpty()) {
+        int index = Dataset::indexOf(m_data.courses, "id", parts.at(0));
+        if (index < 0) {
+            return error(404, "Course not found");
+        }
+
+        if (parts.size() == 2 && parts.at(1) == "status" && request.method == "PUT") {
+            QJsonObject json = request.json();
+            m_data.courses[index]["status"] = json["status"];
+            if (json.contains("rejectionReason")) {
+                m_data.courses[index]["rejectionReason"] = json["rejectionReason"];
+            }
+            return ok(m_data.courses.at(index));
+        }
+        if (parts.size() == 1 && request.method == "PUT") {
+            QJsonObject json = request.json();
+            for (auto it = json.constBegin(); it != json.constEnd(); ++it) {
+                m_data.courses[index][it.key()] = it.value();
+            }
+            return ok(m_data.courses.at(index));
+        }
+        if (parts.size() == 1 && request.method == "DELETE") {
+            QJsonObject removed = m_data.courses.takeAt(index);
+            return ok(QJsonObject{ { "id", removed["id"] } });
+        }
+        if (parts.size() == 1) {
+            return ok(m_data.courses.at(index));
+        }
+        return error(404, "Not found");
+    }
+
+    QString status = request.query.queryItemValue("status");
+    QString search = request.query.queryItemValue("search", QUrl::FullyDecoded);
+
+    QVector<QJsonObject> rows;
+    for (const QJsonObject &row : m_data.courses) {
+        if ((status.isEmpty() || status == "all" || row["status"].toString() == status)
+            && matches(row, search, { "title", "category" })) {
+            rows.append(row);
+        }
+    }
+
+    QJsonObject data = page(rows, request.query, "courses", 12);
+    data["stats"] = m_data.courseStats();
+    return ok(data);
+}
+
+MockServer::Response MockServer::handleStudents(const Request &request)
+{
+    QString isActive = request.query.queryItemValue("isActive");
+    QString search = request.query.queryItemValue("search", QUrl::FullyDecoded);
+
+    QVector<QJsonObject> rows;
+    for (const QJsonObject &row : m_data.students) {
+        bool statusMatches = isActive.isEmpty()
+                             || (isActive == "true") == row["isActive"].toBool();
+        if (statusMatches && matches(row, search, { "firstName", "lastName", "email" })) {
+            rows.append(row);
+        }
+    }
+
+    // Unpaged unless the client asks, like the real endpoint
+    QJsonObject data = page(rows, request.query, "students", 0);
+    data["stats"] = m_data.studentStats();
+    return ok(data);
+}
+
+MockServer::Response MockServer::handleTransactions(const Request &request)
+{
+    QString status = request.query.queryItemValue("status");
+    QString search = request.query.queryItemValue("search", QUrl::FullyDecoded);
+
+    QVector<QJsonObject> rows;
+    for (const QJsonObject &row : m_data.transactions) {
+        if (!status.isEmpty() && status != "all" && row["status"].toString() != status) {
+            continue;
+        }
+        if (!search.isEmpty() && !matches(row, search, { "orderNumber" })
+            && !matches(row["student"].toObject(), search, { "name", "email" })) {
+            continue;
+        }
+        rows.append(row);
+    }
+
+    QJsonObject data = page(rows, request.query, "transactions", 20);
+    data["summary"] = m_data.transactionSummary();
+    return ok(data);
+}
+
+MockServer::Response MockServer::handleNotifications(const Request &request, const QStringList &parts)
+{
+    if (parts.value(0) == "mark-read") {
+        int index = Dataset::indexOf(m_data.notifications, "id", request.json()["notificationId"].toString());
+        if (index < 0) {
+            return error(404, "Notification not found");
+        }
+        m_data.notifications[index]["isRead"] = true;
+        return ok(m_data.notifications.at(index));
+    }
+    if (parts.value(0) == "mark-all-read") {
+        for (QJsonObject &row : m_data.notifications) {
+            row["isRead"] = true;
+        }
+        return ok(QJsonObject{ { "unreadCount", 0 } });
+    }
+
+    QString status = request.query.queryItemValue("status");
+    QVector<QJsonObject> rows;
+    for (const QJsonObject &row : m_data.notifications) {
+        bool isRead = row["isRead"].toBool();
+        if (status.isEmpty() || status == "all" || (status == "unread") != isRead) {
+            rows.append(row);
+        }
+    }
+
+    QJsonObject data = page(rows, request.query, "notifications", 50);
+    data.remove("pagination");
+    data["unreadCount"] = m_data.unreadCount();
+    return ok(data);
+}
+
+MockServer::Response MockServer::handleUploads(const Request &request, const QStringList &parts)
+{
+    if (parts.isEmpty() && request.method == "POST") {
+        QString uploadId = QString("upl_%1").arg(m_nextUpload++, 6, 10, QChar('0'));
+        m_uploadChunks.insert(uploadId, QSet<int>());
+        qint64 chunkSize = request.json()["chunkSize"].toVariant().toLongLong();
+        return ok(QJsonObject{ { "uploadId", uploadId }, { "chunkSize", chunkSize } });
+    }
+
+    QString uploadId = parts.value(0);
+    if (!m_uploadChunks.contains(uploadId)) {
+        return error(404, "Upload not found");
+    }
+
+    if (parts.size() == 1) {
+        QJsonArray received;
+        for (int index : m_uploadChunks.value(uploadId)) {
+            received.append(index);
+        }
+        return ok(QJsonObject{ { "uploadId", uploadId }, { "receivedChunks", received } });
+    }
+
+    if (parts.size() == 3 && parts.at(1) == "chunks") {
+        QByteArray expected = request.headers.value("x-chunk-sha256").toLower();
+        QByteArray actual = QCryptographicHash::hash(request.body, QCryptographicHash::Sha256).toHex();
+        if (!expected.isEmpty() && expected != actual) {
+            return error(422, "Chunk checksum mismatch", "CHECKSUM_MISMATCH");
+        }
+        int index = parts.at(2).toInt();
+        m_uploadChunks[uploadId].insert(index);
+        return ok(QJsonObject{ { "index", index } });
+    }
+
+    if (parts.size() == 2 && parts.at(1) == "complete") {
+        m_uploadChunks.remove(uploadId);
+        return ok(QJsonObject{ { "url", QString("https://example.com/media/%1").arg(uploadId) } });
+    }
+
+    return error(404, "Not found");
+}
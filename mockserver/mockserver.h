@@ -0,0 +1,105 @@
+#ifndef MOCKSERVER_H
+#define MOCKSERVER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QJsonObject>
+#include <QObject>
+#include <QRandomGenerator>
+#include <QSet>
+#include <QStringList>
+#include <QTcpServer>
+#include <QUrlQuery>
+#include "dataset.h"
+
+class QTcpSocket;
+class QTimer;
+
+// Minimal HTTP/1.1 server implementing the endpoints ApiManager and the
+// QML pages call, over a generated Dataset. Keep-alive, one request in
+// flight per connection. Every response can be delayed (latency + jitter),
+// throttled (bytes per second per connection) and replaced by an injected
+// 500/503 at a given rate, so client behaviour under bad networks and a
+// flaky backend can be reproduced on a laptop.
+class MockServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        int latencyMs = 0;
+        int jitterMs = 0;
+        int bandwidthBytesPerSecond = 0;   // 0 = unlimited
+        double errorRate = 0.0;            // 0..1
+        bool requireAuth = true;
+        bool compress = false;             // deflate bodies of 1 KiB and up when accepted
+    };
+
+    MockServer(const Dataset::Sizes &sizes, quint32 seed, const Options &options,
+               QObject *parent = nullptr);
+    ~MockServer();
+
+    bool listen(const QHostAddress &address, quint16 port);
+    QString errorString() const { return m_server.errorString(); }
+    quint16 serverPort() const { return m_server.serverPort(); }
+
+private:
+    struct Request {
+        QByteArray method;
+        QString path;
+        QUrlQuery query;
+        QHash<QByteArray, QByteArray> headers;   // lower-case names
+        QByteArray body;
+        QJsonObject json() const;
+    };
+
+    struct Response {
+        int status = 200;
+        QJsonObject body;
+    };
+
+    struct Connection {
+        QByteArray buffer;
+        bool busy = false;
+        bool closeAfter = false;
+        QByteArray pending;      // throttled bytes not yet written
+        QTimer *throttle = nullptr;
+    };
+
+    void onNewConnection();
+    void onReadyRead(QTcpSocket *socket);
+    void processNext(QTcpSocket *socket);
+    bool parseRequest(QByteArray *buffer, Request *request, bool *complete);
+    void respond(QTcpSocket *socket, const Request &request, const Response &response);
+    void writeThrottled(QTcpSocket *socket);
+    void finishResponse(QTcpSocket *socket);
+
+    Response route(const Request &request);
+    Response handleAuth(const Request &request, const QString &action);
+    Response handleUser(const Request &request, const QString &action);
+    Response handleInstructors(const Request &request, const QStringList &parts);
+    Response handleCourses(const Request &request, const QStringList &parts);
+    Response handleStudents(const Request &request);
+    Response handleTransactions(const Request &request);
+    Response handleNotifications(const Request &request, const QStringList &parts);
+    Response handleUploads(const Request &request, const QStringList &parts);
+
+    static Response ok(const QJsonObject &data = QJsonObject(), const QString &message = QString());
+    static Response error(int status, const QString &message, const QString &code = QString());
+    // page/limit slicing plus the pagination object the clients read
+    static QJsonObject page(const QVector<QJsonObject> &rows, const QUrlQuery &query,
+                            const QString &key, int defaultLimit);
+    static QJsonObject project(const QJsonObject &row, const QStringList &fields);
+    static bool matches(const QJsonObject &row, const QString &search, const QStringList &keys);
+
+    QTcpServer m_server;
+    Dataset m_data;
+    Options m_options;
+    QRandomGenerator m_random;
+    QHash<QTcpSocket *, Connection> m_connections;
+    QHash<QString, QSet<int>> m_uploadChunks;
+    int m_nextUpload;
+};
+
+#endif // MOCKSERVER_H
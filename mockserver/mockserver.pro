@@ -0,0 +1,17 @@
+# Local stand-in for the Lumin API, for offline and performance testing.
+#   ./lumin-mockserver --port 8787 --transactions 100000 --latency 80 --error-rate 0.02
+#   LUMIN_API_BASE_URL=http://127.0.0.1:8787 ../Lumin
+
+QT = core network
+CONFIG += console c++17
+CONFIG -= app_bundle
+TARGET = lumin-mockserver
+
+SOURCES += \
+    dataset.cpp \
+    main.cpp \
+    mockserver.cpp
+
+HEADERS += \
+    dataset.h \
+    mockserver.h
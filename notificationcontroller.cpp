@@ -1,7 +1,8 @@
 #include "notificationcontroller.h"
+#include "logging.h"
+#include "payloadfields.h"
 #include <QJsonArray>
 #include <QDateTime>
-#include <QDebug>
 
 NotificationController::NotificationController(QObject *parent)
     : QObject(parent)
@@ -96,6 +97,17 @@ void NotificationController::refresh()
     loadNotifications();
 }
 
+void NotificationController::reloadTokens()
+{
+    m_api->loadTokens();
+    qCDebug(lcControllers) << "NotificationController: tokens reloaded, logged in:" << m_api->isLoggedIn();
+}
+
+void NotificationController::restoreSnapshot(const QJsonObject &data)
+{
+    onNotificationsLoaded(data);
+}
+
 void NotificationController::onNotificationsLoaded(const QJsonObject &data)
 {
     if (data.contains("unreadCount")) {
@@ -108,6 +120,9 @@ void NotificationController::onNotificationsLoaded(const QJsonObject &data)
 
     if (data.contains("notifications")) {
         bool isRecent = data.contains("isRecent") && data["isRecent"].toBool();
+        if (isRecent) {
+            m_lastRecent = data;
+        }
         updateNotificationsList(data["notifications"].toArray(), isRecent);
     }
 
@@ -183,7 +198,10 @@ void NotificationController::updateNotificationsList(const QJsonArray &notificat
 
         QVariantMap notificationMap;
         notificationMap["id"] = notification["id"].toString();
-        notificationMap["type"] = notification["type"].toString();
+
+        const PayloadFields::Value type =
+            PayloadFields::decode(PayloadFields::NotificationType, notification["type"]);
+        notificationMap["type"] = type.name;
         notificationMap["title"] = notification["title"].toString();
         notificationMap["message"] = notification["message"].toString();
         notificationMap["isRead"] = notification["isRead"].toBool();
@@ -194,7 +212,7 @@ void NotificationController::updateNotificationsList(const QJsonArray &notificat
         notificationMap["relativeTime"] = formatRelativeTime(notification["createdAt"].toString());
 
         // Get icon based on type
-        notificationMap["icon"] = getNotificationIcon(notification["type"].toString());
+        notificationMap["icon"] = getNotificationIcon(type.code);
 
         targetList->append(notificationMap);
     }
@@ -239,22 +257,23 @@ QString NotificationController::formatRelativeTime(const QString &dateString) co
     }
 }
 
-QString NotificationController::getNotificationIcon(const QString &type) const
+QString NotificationController::getNotificationIcon(int typeCode) const
 {
     // Return icon names based on notification type
-    if (type == "course_submitted") {
-        return "qrc:/icons/course.svg";
-    } else if (type == "course_approved") {
-        return "qrc:/icons/check-circle.svg";
-    } else if (type == "course_rejected") {
-        return "qrc:/icons/x-circle.svg";
-    } else if (type == "instructor_request") {
-        return "qrc:/icons/user.svg";
-    } else if (type == "new_student") {
-        return "qrc:/icons/user-plus.svg";
-    } else if (type == "transaction") {
-        return "qrc:/icons/dollar-sign.svg";
-    } else {
-        return "qrc:/icons/bell.svg";
+    switch (typeCode) {
+    case PayloadFields::NotificationCourseSubmitted:
+        return QStringLiteral("qrc:/icons/course.svg");
+    case PayloadFields::NotificationCourseApproved:
+        return QStringLiteral("qrc:/icons/check-circle.svg");
+    case PayloadFields::NotificationCourseRejected:
+        return QStringLiteral("qrc:/icons/x-circle.svg");
+    case PayloadFields::NotificationInstructorRequest:
+        return QStringLiteral("qrc:/icons/user.svg");
+    case PayloadFields::NotificationNewStudent:
+        return QStringLiteral("qrc:/icons/user-plus.svg");
+    case PayloadFields::NotificationTransaction:
+        return QStringLiteral("qrc:/icons/dollar-sign.svg");
+    default:
+        return QStringLiteral("qrc:/icons/bell.svg");
     }
 }
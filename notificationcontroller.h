@@ -34,6 +34,11 @@ public:
     Q_INVOKABLE void markAllAsRead();
     Q_INVOKABLE void clearError();
     Q_INVOKABLE void refresh();
+    Q_INVOKABLE void reloadTokens();
+
+    // Last recent-notifications response, persisted by SessionSnapshot
+    QJsonObject snapshot() const { return m_lastRecent; }
+    void restoreSnapshot(const QJsonObject &data);
 
 signals:
     void isLoadingChanged();
@@ -61,7 +66,7 @@ private:
     void setError(const QString &error);
     void updateNotificationsList(const QJsonArray &notificationsArray, bool isRecent = false);
     QString formatRelativeTime(const QString &dateString) const;
-    QString getNotificationIcon(const QString &type) const;
+    QString getNotificationIcon(int typeCode) const;
 
     ApiManager *m_api;
     bool m_isLoading;
@@ -70,6 +75,7 @@ private:
     QVariantList m_notifications;
     QVariantList m_recentNotifications;
     QString m_currentFilter;
+    QJsonObject m_lastRecent;
 };
 
 #endif // NOTIFICATIONCONTROLLER_H
@@ -0,0 +1,107 @@
+#include "payloadfields.h"
+
+namespace {
+
+// Unknown values are cached too, but only up to this many per field so a
+// misbehaving backend cannot grow the tables without bound.
+const int MaxValuesPerField = 256;
+
+}
+
+QMutex PayloadFields::s_mutex;
+
+PayloadFields::Table &PayloadFields::table(Field field)
+{
+    static Table tables[FieldCount];
+    static bool populated = false;
+
+    if (!populated) {
+        populate(tables);
+        populated = true;
+    }
+
+    return tables[field];
+}
+
+void PayloadFields::populate(Table tables[FieldCount])
+{
+    auto add = [tables](Field field, int code, const QString &name, const QString &display) {
+        Table &t = tables[field];
+        Value value;
+        value.code = code;
+        value.name = name;
+        value.display = display;
+        t.index.insert(name, t.values.size());
+        t.values.append(value);
+    };
+
+    add(TransactionStatus, TransactionUnknown,   QString(),                 QString());
+    add(TransactionStatus, TransactionCompleted, QStringLiteral("completed"), QStringLiteral("Completed"));
+    add(TransactionStatus, TransactionPending,   QStringLiteral("pending"),   QStringLiteral("Pending"));
+    add(TransactionStatus, TransactionFailed,    QStringLiteral("failed"),    QStringLiteral("Failed"));
+    add(TransactionStatus, TransactionRefunded,  QStringLiteral("refunded"),  QStringLiteral("Refunded"));
+
+    add(PaymentMethod, PaymentUnknown,    QString(),                   QString());
+    add(PaymentMethod, PaymentCreditCard, QStringLiteral("credit_card"), QStringLiteral("Credit Card"));
+    add(PaymentMethod, PaymentDebitCard,  QStringLiteral("debit_card"),  QStringLiteral("Debit Card"));
+    add(PaymentMethod, PaymentPayPal,     QStringLiteral("paypal"),      QStringLiteral("PayPal"));
+
+    add(InstructorStatus, InstructorUnknown,  QString(),                QString());
+    add(InstructorStatus, InstructorPending,  QStringLiteral("pending"),  QStringLiteral("Pending"));
+    add(InstructorStatus, InstructorVerified, QStringLiteral("verified"), QStringLiteral("Verified"));
+    add(InstructorStatus, InstructorRejected, QStringLiteral("rejected"), QStringLiteral("Rejected"));
+
+    add(NotificationType, NotificationUnknown,           QString(),                          QString());
+    add(NotificationType, NotificationCourseSubmitted,   QStringLiteral("course_submitted"),   QStringLiteral("Course submitted"));
+    add(NotificationType, NotificationCourseApproved,    QStringLiteral("course_approved"),    QStringLiteral("Course approved"));
+    add(NotificationType, NotificationCourseRejected,    QStringLiteral("course_rejected"),    QStringLiteral("Course rejected"));
+    add(NotificationType, NotificationInstructorRequest, QStringLiteral("instructor_request"), QStringLiteral("Instructor request"));
+    add(NotificationType, NotificationNewStudent,        QStringLiteral("new_student"),        QStringLiteral("New student"));
+    add(NotificationType, NotificationTransaction,       QStringLiteral("transaction"),        QStringLiteral("Transaction"));
+}
+
+QString PayloadFields::defaultDisplay(Field field, const QString &name)
+{
+    switch (field) {
+    case TransactionStatus:
+    case InstructorStatus:
+        return name.left(1).toUpper() + name.mid(1);
+    default:
+        return name;
+    }
+}
+
+PayloadFields::Value PayloadFields::decode(Field field, const QJsonValue &value)
+{
+    return decode(field, value.toString());
+}
+
+PayloadFields::Value PayloadFields::decode(Field field, const QString &value)
+{
+    QMutexLocker locker(&s_mutex);
+
+    Table &t = table(field);
+    auto it = t.index.constFind(value);
+    if (it != t.index.constEnd()) {
+        return t.values.at(it.value());
+    }
+
+    Value decoded;
+    decoded.name = value;
+    decoded.display = defaultDisplay(field, value);
+
+    if (t.values.size() >= MaxValuesPerField) {
+        decoded.code = UncachedCode;
+        return decoded;
+    }
+
+    decoded.code = t.nextDynamicCode++;
+    t.index.insert(value, t.values.size());
+    t.values.append(decoded);
+    return decoded;
+}
+
+int PayloadFields::code(Field field, const QString &value)
+{
+    return decode(field, value).code;
+}
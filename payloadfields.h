@@ -0,0 +1,89 @@
+#ifndef PAYLOADFIELDS_H
+#define PAYLOADFIELDS_H
+
+#include <QHash>
+#include <QJsonValue>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+// Decodes the enum-like fields of API payloads (transaction status,
+// payment method, instructor status, notification type) into interned
+// strings plus a small integer code. Every row carrying the same value
+// shares one QString and display string; C++ that branches on a value
+// (notification icons, revenue aggregation) compares the code instead of
+// strings. The codes are not stored in the row maps.
+class PayloadFields
+{
+public:
+    enum Field {
+        TransactionStatus,
+        PaymentMethod,
+        InstructorStatus,
+        NotificationType,
+        FieldCount
+    };
+
+    // Codes of the values the backend is known to send. Values that are not
+    // listed here still decode; they get a code >= FirstDynamicCode.
+    enum TransactionStatusCode {
+        TransactionUnknown = 0,
+        TransactionCompleted,
+        TransactionPending,
+        TransactionFailed,
+        TransactionRefunded
+    };
+
+    enum PaymentMethodCode {
+        PaymentUnknown = 0,
+        PaymentCreditCard,
+        PaymentDebitCard,
+        PaymentPayPal
+    };
+
+    enum InstructorStatusCode {
+        InstructorUnknown = 0,
+        InstructorPending,
+        InstructorVerified,
+        InstructorRejected
+    };
+
+    enum NotificationTypeCode {
+        NotificationUnknown = 0,
+        NotificationCourseSubmitted,
+        NotificationCourseApproved,
+        NotificationCourseRejected,
+        NotificationInstructorRequest,
+        NotificationNewStudent,
+        NotificationTransaction
+    };
+
+    // Values past the per-field cache limit are decoded but not cached, and
+    // get UncachedCode rather than colliding with a known or Unknown code
+    enum { FirstDynamicCode = 64, UncachedCode = -1 };
+
+    struct Value {
+        int code = 0;
+        QString name;       // wire value, e.g. "credit_card"
+        QString display;    // cached display string, e.g. "Credit Card"
+    };
+
+    static Value decode(Field field, const QJsonValue &value);
+    static Value decode(Field field, const QString &value);
+    static int code(Field field, const QString &value);
+
+private:
+    struct Table {
+        QHash<QString, int> index;
+        QVector<Value> values;
+        int nextDynamicCode = FirstDynamicCode;
+    };
+
+    static Table &table(Field field);
+    static void populate(Table tables[FieldCount]);
+    static QString defaultDisplay(Field field, const QString &name);
+
+    static QMutex s_mutex;
+};
+
+#endif // PAYLOADFIELDS_H
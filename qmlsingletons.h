@@ -0,0 +1,201 @@
+#ifndef QMLSINGLETONS_H
+#define QMLSINGLETONS_H
+
+#include <QJSEngine>
+#include <QQmlEngine>
+#include "authcontroller.h"
+#include "coursecontroller.h"
+#include "dashboardcontroller.h"
+#include "diagnosticscontroller.h"
+#include "framemonitor.h"
+#include "instructorcontroller.h"
+#include "notificationcontroller.h"
+#include "revenuecontroller.h"
+#include "sessionsnapshot.h"
+#include "startuptrace.h"
+#include "transactioncontroller.h"
+#include "usercontroller.h"
+
+// Exposes the controllers created in main() as typed singletons of the
+// "Lumin" QML module (import Lumin). Unlike context properties, the QML
+// compiler knows their types, so bindings such as
+// TransactionController.transactions are resolved at build time.
+//
+// main() assigns each s_instance before the engine loads Main.qml.
+
+template <typename T>
+T *qmlSingletonInstance(T *instance, QJSEngine *engine)
+{
+    Q_ASSERT(instance);
+    Q_ASSERT(engine->thread() == instance->thread());
+    QJSEngine::setObjectOwnership(instance, QJSEngine::CppOwnership);
+    return instance;
+}
+
+struct AuthControllerForeign
+{
+    Q_GADGET
+    QML_FOREIGN(AuthController)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(AuthController)
+public:
+    inline static AuthController *s_instance = nullptr;
+    static AuthController *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(s_instance, engine);
+    }
+};
+
+struct DashboardControllerForeign
+{
+    Q_GADGET
+    QML_FOREIGN(DashboardController)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(DashboardController)
+public:
+    inline static DashboardController *s_instance = nullptr;
+    static DashboardController *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(s_instance, engine);
+    }
+};
+
+struct InstructorControllerForeign
+{
+    Q_GADGET
+    QML_FOREIGN(InstructorController)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(InstructorController)
+public:
+    inline static InstructorController *s_instance = nullptr;
+    static InstructorController *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(s_instance, engine);
+    }
+};
+
+struct CourseControllerForeign
+{
+    Q_GADGET
+    QML_FOREIGN(CourseController)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(CourseController)
+public:
+    inline static CourseController *s_instance = nullptr;
+    static CourseController *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(s_instance, engine);
+    }
+};
+
+struct UserControllerForeign
+{
+    Q_GADGET
+    QML_FOREIGN(UserController)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(UserController)
+public:
+    inline static UserController *s_instance = nullptr;
+    static UserController *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(s_instance, engine);
+    }
+};
+
+struct TransactionControllerForeign
+{
+    Q_GADGET
+    QML_FOREIGN(TransactionController)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(TransactionController)
+public:
+    inline static TransactionController *s_instance = nullptr;
+    static TransactionController *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(s_instance, engine);
+    }
+};
+
+struct NotificationControllerForeign
+{
+    Q_GADGET
+    QML_FOREIGN(NotificationController)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(NotificationController)
+public:
+    inline static NotificationController *s_instance = nullptr;
+    static NotificationController *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(s_instance, engine);
+    }
+};
+
+struct RevenueControllerForeign
+{
+    Q_GADGET
+    QML_FOREIGN(RevenueController)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(RevenueController)
+public:
+    inline static RevenueController *s_instance = nullptr;
+    static RevenueController *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(s_instance, engine);
+    }
+};
+
+struct DiagnosticsControllerForeign
+{
+    Q_GADGET
+    QML_FOREIGN(DiagnosticsController)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(DiagnosticsController)
+public:
+    inline static DiagnosticsController *s_instance = nullptr;
+    static DiagnosticsController *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(s_instance, engine);
+    }
+};
+
+struct SessionSnapshotForeign
+{
+    Q_GADGET
+    QML_FOREIGN(SessionSnapshot)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(SessionSnapshot)
+public:
+    inline static SessionSnapshot *s_instance = nullptr;
+    static SessionSnapshot *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(s_instance, engine);
+    }
+};
+
+struct StartupTraceForeign
+{
+    Q_GADGET
+    QML_FOREIGN(StartupTrace)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(StartupTrace)
+public:
+    static StartupTrace *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(StartupTrace::instance(), engine);
+    }
+};
+
+struct FrameMonitorForeign
+{
+    Q_GADGET
+    QML_FOREIGN(FrameMonitor)
+    QML_SINGLETON
+    QML_NAMED_ELEMENT(FrameMonitor)
+public:
+    static FrameMonitor *create(QQmlEngine *, QJSEngine *engine)
+    {
+        return qmlSingletonInstance(FrameMonitor::instance(), engine);
+    }
+};
+
+#endif // QMLSINGLETONS_H
@@ -0,0 +1,208 @@
+#include "remoteimageprovider.h"
+#include "apinetworkmanager.h"
+#include <QBuffer>
+#include <QDebug>
+#include <QDir>
+#include <QImageReader>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QStandardPaths>
+#include <QThread>
+#include <QUrl>
+
+RemoteImageLoader::RemoteImageLoader(QObject *parent)
+    : QObject(parent)
+    , m_networkManager(ApiNetworkManager::shared())
+    , m_diskCache(qobject_cast<QNetworkDiskCache *>(m_networkManager->cache()))
+{
+    // The manager takes ownership of the cache and outlives the loader
+    if (!m_diskCache) {
+        m_diskCache = new QNetworkDiskCache;
+        m_diskCache->setCacheDirectory(QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation))
+                                           .filePath("images"));
+        m_diskCache->setMaximumCacheSize(64 * 1024 * 1024);
+        m_networkManager->setCache(m_diskCache);
+    }
+
+    m_decodePool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 4));
+
+    // Decoded ARGB32 images: 48 MiB holds a few thousand avatars
+    int cacheMiB = qEnvironmentVariableIntValue("LUMIN_IMAGE_CACHE_MB");
+    m_memoryCache.setMaxCost((cacheMiB > 0 ? cacheMiB : 48) * 1024);
+}
+
+RemoteImageLoader::~RemoteImageLoader()
+{
+    // Decode tasks post back to this object
+    m_decodePool.clear();
+    m_decodePool.waitForDone();
+}
+
+QString RemoteImageLoader::cacheKey(const QString &url, const QSize &size)
+{
+    return QString("%1x%2:%3").arg(size.width()).arg(size.height()).arg(url);
+}
+
+bool RemoteImageLoader::cachedImage(const QString &key, QImage *image)
+{
+    QMutexLocker locker(&m_cacheMutex);
+    QImage *cached = m_memoryCache.object(key);
+    if (!cached) {
+        return false;
+    }
+
+    *image = *cached;
+    return true;
+}
+
+RemoteImageLoader::CacheStats RemoteImageLoader::cacheStats()
+{
+    CacheStats stats;
+    stats.diskBytes = m_diskCache->cacheSize();
+
+    QMutexLocker locker(&m_cacheMutex);
+    stats.entries = int(m_memoryCache.count());
+    stats.bytes = qint64(m_memoryCache.totalCost()) * 1024;
+    stats.maxBytes = qint64(m_memoryCache.maxCost()) * 1024;
+    return stats;
+}
+
+void RemoteImageLoader::trimMemoryCache()
+{
+    QMutexLocker locker(&m_cacheMutex);
+    m_memoryCache.clear();
+}
+
+void RemoteImageLoader::insertImage(const QString &key, const QImage &image)
+{
+    QMutexLocker locker(&m_cacheMutex);
+    m_memoryCache.insert(key, new QImage(image), qMax<qsizetype>(1, image.sizeInBytes() / 1024));
+}
+
+void RemoteImageLoader::load(const QString &key, const QString &url, const QSize &requestedSize)
+{
+    // Several delegates showing the same avatar share one download
+    if (m_pending.contains(key)) {
+        return;
+    }
+
+    QImage image;
+    if (cachedImage(key, &image)) {
+        emit imageReady(key, image, QString());
+        return;
+    }
+
+    m_pending.insert(key);
+
+    QNetworkRequest request{QUrl(url)};
+    request.setAttribute(ApiNetworkManager::DiskCacheAttribute, true);
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
+    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute, QNetworkRequest::NoLessSafeRedirectPolicy);
+
+    QNetworkReply *reply = m_networkManager->get(request);
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, key, requestedSize]() {
+        reply->deleteLater();
+
+        if (reply->error() != QNetworkReply::NoError) {
+            m_pending.remove(key);
+            emit imageReady(key, QImage(), reply->errorString());
+            return;
+        }
+
+        QByteArray data = reply->readAll();
+        m_decodePool.start([this, key, data, requestedSize]() {
+            decode(key, data, requestedSize);
+        });
+    });
+}
+
+void RemoteImageLoader::decode(const QString &key, const QByteArray &data, const QSize &requestedSize)
+{
+    // Runs on m_decodePool
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+
+    QImageReader reader(&buffer);
+    reader.setAutoTransform(true);
+
+    // Scale so the image still covers the requested box (PreserveAspectCrop);
+    // never upscale
+    QSize size = reader.size();
+    if (size.isValid() && requestedSize.isValid() && !requestedSize.isEmpty()) {
+        qreal factor = qMax(qreal(requestedSize.width()) / size.width(),
+                            qreal(requestedSize.height()) / size.height());
+        if (factor < 1.0) {
+            reader.setScaledSize(QSize(qMax(1, qRound(size.width() * factor)),
+                                       qMax(1, qRound(size.height() * factor))));
+        }
+    }
+
+    QImage image = reader.read();
+    QString errorString;
+    if (image.isNull()) {
+        errorString = reader.errorString();
+    } else {
+        insertImage(key, image);
+    }
+
+    QMetaObject::invokeMethod(this, [this, key, image, errorString]() {
+        m_pending.remove(key);
+        emit imageReady(key, image, errorString);
+    }, Qt::QueuedConnection);
+}
+
+RemoteImageResponse::RemoteImageResponse(RemoteImageLoader *loader, const QString &url,
+                                         const QSize &requestedSize)
+    : m_key(RemoteImageLoader::cacheKey(url, requestedSize))
+    , m_done(false)
+{
+    if (loader->cachedImage(m_key, &m_image)) {
+        m_done = true;
+        QMetaObject::invokeMethod(this, &QQuickImageResponse::finished, Qt::QueuedConnection);
+        return;
+    }
+
+    // Queued: the response lives on the image reader thread, the loader on
+    // the GUI thread
+    connect(loader, &RemoteImageLoader::imageReady, this, &RemoteImageResponse::onImageReady);
+    QMetaObject::invokeMethod(loader, "load", Qt::QueuedConnection,
+                              Q_ARG(QString, m_key), Q_ARG(QString, url),
+                              Q_ARG(QSize, requestedSize));
+}
+
+QQuickTextureFactory *RemoteImageResponse::textureFactory() const
+{
+    return QQuickTextureFactory::textureFactoryForImage(m_image);
+}
+
+void RemoteImageResponse::onImageReady(const QString &key, const QImage &image, const QString &errorString)
+{
+    if (m_done || key != m_key) {
+        return;
+    }
+
+    m_done = true;
+    m_image = image;
+    m_errorString = errorString;
+    emit finished();
+}
+
+RemoteImageProvider::RemoteImageProvider()
+    : m_loader(new RemoteImageLoader)
+{
+}
+
+RemoteImageProvider::~RemoteImageProvider()
+{
+    delete m_loader;
+}
+
+QQuickImageResponse *RemoteImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
+{
+    // QML passes the URL percent-encoded: image://remote/<encodeURIComponent(url)>
+    QString url = QUrl::fromPercentEncoding(id.toUtf8());
+    return new RemoteImageResponse(m_loader, url, requestedSize);
+}
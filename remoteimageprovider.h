@@ -0,0 +1,103 @@
+#ifndef REMOTEIMAGEPROVIDER_H
+#define REMOTEIMAGEPROVIDER_H
+
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QQuickAsyncImageProvider>
+#include <QSet>
+#include <QSize>
+#include <QThreadPool>
+
+class ApiNetworkManager;
+class QNetworkDiskCache;
+
+// Downloads and decodes images for the "image://remote/<url>" provider.
+// Lives on the GUI thread and downloads through that thread's shared
+// ApiNetworkManager, so images reuse the API connection pool and show up in
+// ApiMetrics, HAR export and record/replay like any other request. Decoding runs
+// on its own thread pool at the size the Image asked for, so a 48 px avatar
+// never decodes the full upload. Decoded images are kept in a memory LRU
+// shared by every response, and downloads go through a disk cache so a
+// restart does not refetch them. The memory LRU defaults to 48 MiB;
+// LUMIN_IMAGE_CACHE_MB overrides it for low-memory machines.
+class RemoteImageLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RemoteImageLoader(QObject *parent = nullptr);
+    ~RemoteImageLoader();
+
+    // Thread-safe memory cache lookup
+    bool cachedImage(const QString &key, QImage *image);
+
+    static QString cacheKey(const QString &url, const QSize &size);
+
+    struct CacheStats {
+        int entries = 0;
+        qint64 bytes = 0;
+        qint64 maxBytes = 0;
+        qint64 diskBytes = 0;
+    };
+    CacheStats cacheStats();
+
+    // Drops every decoded image; Images on screen keep their textures
+    void trimMemoryCache();
+
+public slots:
+    void load(const QString &key, const QString &url, const QSize &requestedSize);
+
+signals:
+    // Broadcast to every waiting response; they match on key
+    void imageReady(const QString &key, const QImage &image, const QString &errorString);
+
+private:
+    void decode(const QString &key, const QByteArray &data, const QSize &requestedSize);
+    void insertImage(const QString &key, const QImage &image);
+
+    ApiNetworkManager *m_networkManager;
+    QNetworkDiskCache *m_diskCache;
+    QThreadPool m_decodePool;
+    QSet<QString> m_pending;            // keys being downloaded or decoded
+
+    QMutex m_cacheMutex;
+    QCache<QString, QImage> m_memoryCache;  // cost in KiB
+};
+
+class RemoteImageResponse : public QQuickImageResponse
+{
+    Q_OBJECT
+
+public:
+    RemoteImageResponse(RemoteImageLoader *loader, const QString &url, const QSize &requestedSize);
+
+    QQuickTextureFactory *textureFactory() const override;
+    QString errorString() const override { return m_errorString; }
+
+private slots:
+    void onImageReady(const QString &key, const QImage &image, const QString &errorString);
+
+private:
+    QString m_key;
+    QImage m_image;
+    QString m_errorString;
+    bool m_done;
+};
+
+class RemoteImageProvider : public QQuickAsyncImageProvider
+{
+public:
+    RemoteImageProvider();
+    ~RemoteImageProvider();
+
+    QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
+
+    RemoteImageLoader *loader() const { return m_loader; }
+
+private:
+    RemoteImageLoader *m_loader;
+};
+
+#endif // REMOTEIMAGEPROVIDER_H
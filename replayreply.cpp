@@ -0,0 +1,116 @@
+#include "replayreply.h"
+#include <QTimer>
+#include <cstring>
+
+ReplayReply::ReplayReply(QNetworkAccessManager::Operation op, const QNetworkRequest &request,
+                         const QByteArray &method, QObject *parent)
+    : QNetworkReply(parent)
+    , m_found(false)
+    , m_offset(0)
+{
+    setOperation(op);
+    setRequest(request);
+    setUrl(request.url());
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+    ApiTraffic *traffic = ApiTraffic::instance();
+    m_found = traffic->take(method, ApiTraffic::pathAndQuery(request.url()), &m_exchange);
+
+    // Always asynchronous, even at zero latency: callers connect to
+    // finished() after the reply is returned
+    double scale = traffic->latencyScale();
+    int ttfbMs = m_found ? int(qMax(0.0f, m_exchange.ttfbMs) * scale) : 0;
+    int totalMs = m_found ? int(m_exchange.totalMs * scale) : 0;
+
+    QTimer::singleShot(ttfbMs, this, &ReplayReply::deliverHeaders);
+    QTimer::singleShot(qMax(ttfbMs, totalMs), this, &ReplayReply::deliverBody);
+}
+
+ReplayReply::~ReplayReply()
+{
+}
+
+void ReplayReply::deliverHeaders()
+{
+    if (isFinished()) {
+        return;
+    }
+
+    if (!m_found) {
+        setAttribute(QNetworkRequest::HttpStatusCodeAttribute, 404);
+        setAttribute(QNetworkRequest::HttpReasonPhraseAttribute, QByteArray("Not Recorded"));
+        emit metaDataChanged();
+        return;
+    }
+
+    if (m_exchange.httpStatus > 0) {
+        setAttribute(QNetworkRequest::HttpStatusCodeAttribute, m_exchange.httpStatus);
+    }
+    setAttribute(QNetworkRequest::Http2WasUsedAttribute, m_exchange.http2);
+    if (!m_exchange.contentType.isEmpty()) {
+        setRawHeader("Content-Type", m_exchange.contentType);
+    }
+    setRawHeader("Content-Length", QByteArray::number(m_exchange.responseBody.size()));
+    emit metaDataChanged();
+}
+
+void ReplayReply::deliverBody()
+{
+    if (isFinished()) {
+        return;
+    }
+
+    if (!m_found) {
+        setError(ContentNotFoundError, QStringLiteral("No recorded response for %1")
+                                           .arg(ApiTraffic::pathAndQuery(url())));
+        setFinished(true);
+        emit errorOccurred(ContentNotFoundError);
+        emit finished();
+        return;
+    }
+
+    m_body = m_exchange.responseBody;
+    if (!m_body.isEmpty()) {
+        emit readyRead();
+        emit downloadProgress(m_body.size(), m_body.size());
+    }
+
+    NetworkError recordedError = NetworkError(m_exchange.networkError);
+    if (recordedError != NoError) {
+        setError(recordedError, QStringLiteral("Recorded error %1").arg(m_exchange.networkError));
+        setFinished(true);
+        emit errorOccurred(recordedError);
+    } else {
+        setFinished(true);
+    }
+    emit finished();
+}
+
+void ReplayReply::abort()
+{
+    if (isFinished()) {
+        return;
+    }
+
+    setError(OperationCanceledError, QStringLiteral("Operation canceled"));
+    setFinished(true);
+    emit errorOccurred(OperationCanceledError);
+    emit finished();
+}
+
+qint64 ReplayReply::bytesAvailable() const
+{
+    return m_body.size() - m_offset + QNetworkReply::bytesAvailable();
+}
+
+qint64 ReplayReply::readData(char *data, qint64 maxSize)
+{
+    qint64 count = qMin(maxSize, m_body.size() - m_offset);
+    if (count <= 0) {
+        return isFinished() ? -1 : 0;
+    }
+
+    std::memcpy(data, m_body.constData() + m_offset, size_t(count));
+    m_offset += count;
+    return count;
+}
@@ -0,0 +1,38 @@
+#ifndef REPLAYREPLY_H
+#define REPLAYREPLY_H
+
+#include <QByteArray>
+#include <QNetworkReply>
+#include "apitraffic.h"
+
+// QNetworkReply answering from an ApiTraffic recording instead of the
+// network. Headers arrive after the recorded time to first byte and the
+// body after the recorded total, both multiplied by the replay latency
+// scale. Without a recording for the request it finishes with a 404.
+class ReplayReply : public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    ReplayReply(QNetworkAccessManager::Operation op, const QNetworkRequest &request,
+                const QByteArray &method, QObject *parent = nullptr);
+    ~ReplayReply();
+
+    void abort() override;
+    qint64 bytesAvailable() const override;
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+
+private:
+    void deliverHeaders();
+    void deliverBody();
+
+    ApiTraffic::Exchange m_exchange;
+    bool m_found;
+    QByteArray m_body;
+    qint64 m_offset;
+};
+
+#endif // REPLAYREPLY_H
@@ -0,0 +1,315 @@
+#include "revenuecontroller.h"
+#include "logging.h"
+#include "payloadfields.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QLocale>
+#include <algorithm>
+#include <numeric>
+
+RevenueController::RevenueController(QObject *parent)
+    : QObject(parent)
+    , m_api(new ApiManager(this))
+    , m_isLoading(false)
+    , m_rangeDays(30)
+    , m_bucketDays(1)
+    , m_dayAmounts(MaxRangeDays, 0.0)
+    , m_dayCounts(MaxRangeDays, 0)
+    , m_reachedEnd(false)
+    , m_nextOlderPage(1)
+    , m_mode(Idle)
+    , m_pageSize(100)
+    , m_total(0.0)
+    , m_maxValue(0.0)
+{
+    m_lastDay = QDate::currentDate();
+
+    connect(m_api, &ApiManager::transactionsLoaded,
+            this, &RevenueController::onTransactionsLoaded);
+    connect(m_api, &ApiManager::transactionsLoadFailed,
+            this, &RevenueController::onTransactionsLoadFailed);
+
+    rebuildSeries();
+}
+
+RevenueController::~RevenueController()
+{
+}
+
+void RevenueController::setLoading(bool loading)
+{
+    if (m_isLoading != loading) {
+        m_isLoading = loading;
+        emit isLoadingChanged();
+    }
+}
+
+void RevenueController::setError(const QString &error)
+{
+    if (m_errorMessage != error) {
+        m_errorMessage = error;
+        emit errorMessageChanged();
+    }
+}
+
+QString RevenueController::formatCurrency(double amount) const
+{
+    QLocale locale(QLocale::English, QLocale::UnitedStates);
+    return locale.toCurrencyString(amount, "$");
+}
+
+QString RevenueController::formattedTotal() const
+{
+    return formatCurrency(m_total);
+}
+
+void RevenueController::setRangeDays(int days)
+{
+    days = qBound(1, days, int(MaxRangeDays));
+    if (m_rangeDays == days) {
+        return;
+    }
+
+    m_rangeDays = days;
+    emit rangeDaysChanged();
+
+    // Already covered ranges are answered from the buckets
+    rebuildSeries();
+    if (m_mode == Idle) {
+        ensureCoverage();
+    }
+}
+
+void RevenueController::load()
+{
+    clearError();
+
+    // Keep the buckets aligned with today when the app runs past midnight
+    QDate today = QDate::currentDate();
+    qint64 shift = m_lastDay.daysTo(today);
+    if (shift >= MaxRangeDays) {
+        resetBuckets();
+    } else if (shift > 0) {
+        std::rotate(m_dayAmounts.rbegin(), m_dayAmounts.rbegin() + shift, m_dayAmounts.rend());
+        std::rotate(m_dayCounts.rbegin(), m_dayCounts.rbegin() + shift, m_dayCounts.rend());
+        std::fill(m_dayAmounts.begin(), m_dayAmounts.begin() + shift, 0.0);
+        std::fill(m_dayCounts.begin(), m_dayCounts.begin() + shift, 0);
+        m_lastDay = today;
+    }
+
+    rebuildSeries();
+
+    if (m_mode != Idle) {
+        return;
+    }
+
+    // Once buckets exist only what is new gets pulled
+    refresh();
+}
+
+void RevenueController::refresh()
+{
+    if (m_mode != Idle) {
+        return;
+    }
+
+    if (!m_coveredFrom.isValid()) {
+        ensureCoverage();
+        return;
+    }
+
+    clearError();
+    m_mode = FetchNewer;
+    setLoading(true);
+    fetchPage(1);
+}
+
+void RevenueController::clearError()
+{
+    setError("");
+}
+
+void RevenueController::reloadTokens()
+{
+    m_api->loadTokens();
+    qCDebug(lcControllers) << "RevenueController: tokens reloaded, logged in:" << m_api->isLoggedIn();
+}
+
+void RevenueController::resetBuckets()
+{
+    m_lastDay = QDate::currentDate();
+    std::fill(m_dayAmounts.begin(), m_dayAmounts.end(), 0.0);
+    std::fill(m_dayCounts.begin(), m_dayCounts.end(), 0);
+    m_seenOrderIds.clear();
+    m_coveredFrom = QDate();
+    m_reachedEnd = false;
+    m_nextOlderPage = 1;
+}
+
+void RevenueController::fetchPage(int page)
+{
+    m_api->getTransactions(page, m_pageSize, "completed");
+}
+
+void RevenueController::ensureCoverage()
+{
+    QDate needed = m_lastDay.addDays(-(m_rangeDays - 1));
+
+    // The oldest fetched day may be partial; every later day is complete
+    bool covered = m_reachedEnd || (m_coveredFrom.isValid() && m_coveredFrom < needed);
+    if (covered) {
+        m_mode = Idle;
+        setLoading(false);
+        return;
+    }
+
+    m_mode = FetchOlder;
+    setLoading(true);
+    fetchPage(m_nextOlderPage);
+}
+
+void RevenueController::addToBucket(const QDate &date, double amount)
+{
+    qint64 index = qMax<qint64>(0, date.daysTo(m_lastDay));
+    if (index >= MaxRangeDays) {
+        return;
+    }
+
+    m_dayAmounts[index] += amount;
+    m_dayCounts[index] += 1;
+}
+
+QString RevenueController::transactionKey(const QJsonObject &transaction)
+{
+    QString orderId = transaction["orderId"].toString();
+    if (!orderId.isEmpty()) {
+        return orderId;
+    }
+
+    QString orderNumber = transaction["orderNumber"].toString();
+    QString createdAt = transaction["createdAt"].toString();
+    if (orderNumber.isEmpty() && createdAt.isEmpty()) {
+        return QString();
+    }
+    return orderNumber + QLatin1Char('|') + createdAt;
+}
+
+void RevenueController::onTransactionsLoaded(const QJsonObject &data)
+{
+    if (m_mode == Idle) {
+        return;
+    }
+
+    QJsonArray rows = data["transactions"].toArray();
+    QJsonObject pagination = data["pagination"].toObject();
+    int page = pagination["page"].toInt(1);
+    int pages = pagination["pages"].toInt(1);
+
+    bool hitKnown = false;
+    QDate oldest;
+
+    for (const QJsonValue &value : rows) {
+        QJsonObject transaction = value.toObject();
+
+        QDate date = QDateTime::fromString(transaction["createdAt"].toString(), Qt::ISODate)
+                         .toLocalTime().date();
+        if (date.isValid() && (!oldest.isValid() || date < oldest)) {
+            oldest = date;
+        }
+
+        // Rows without any identity cannot be deduplicated; count them
+        // rather than treating every one after the first as already seen
+        QString key = transactionKey(transaction);
+        if (!key.isEmpty()) {
+            if (m_seenOrderIds.contains(key)) {
+                hitKnown = true;
+                continue;
+            }
+            m_seenOrderIds.insert(key);
+        }
+
+        int status = PayloadFields::code(PayloadFields::TransactionStatus,
+                                         transaction["status"].toString());
+        if (status != PayloadFields::TransactionCompleted || !date.isValid()) {
+            continue;
+        }
+
+        addToBucket(date, transaction["amount"].toDouble());
+    }
+
+    bool lastPage = rows.isEmpty() || page >= pages;
+
+    if (m_mode == FetchOlder) {
+        if (oldest.isValid() && (!m_coveredFrom.isValid() || oldest < m_coveredFrom)) {
+            m_coveredFrom = oldest;
+        }
+        m_nextOlderPage = page + 1;
+        m_reachedEnd = lastPage;
+
+        rebuildSeries();
+        ensureCoverage();
+        return;
+    }
+
+    // FetchNewer: rows shifted onto older pages by new ones are caught by
+    // the order id check, so the older walk can simply continue later.
+    rebuildSeries();
+    bool pastWindow = oldest.isValid() && oldest.daysTo(m_lastDay) >= MaxRangeDays;
+    if (hitKnown || lastPage || pastWindow) {
+        m_mode = Idle;
+        ensureCoverage();
+    } else {
+        fetchPage(page + 1);
+    }
+}
+
+void RevenueController::onTransactionsLoadFailed(const QString &errorMessage)
+{
+    m_mode = Idle;
+    setLoading(false);
+    setError(errorMessage.isEmpty() ?
+                 "Failed to load revenue data. Please try again." :
+                 errorMessage);
+}
+
+void RevenueController::rebuildSeries()
+{
+    m_bucketDays = m_rangeDays > 31 ? 7 : 1;
+    int buckets = (m_rangeDays + m_bucketDays - 1) / m_bucketDays;
+
+    m_points.clear();
+    m_values.clear();
+    m_labels.clear();
+    m_total = 0.0;
+    m_maxValue = 0.0;
+
+    const double *amounts = m_dayAmounts.data();
+    const int *counts = m_dayCounts.data();
+
+    // Oldest bucket first so the chart reads left to right
+    for (int bucket = buckets - 1; bucket >= 0; --bucket) {
+        int first = bucket * m_bucketDays;
+        int last = qMin(first + m_bucketDays, m_rangeDays);
+
+        double amount = std::accumulate(amounts + first, amounts + last, 0.0);
+        int count = std::accumulate(counts + first, counts + last, 0);
+        QDate start = m_lastDay.addDays(-(last - 1));
+
+        QString label = start.toString("MMM d");
+
+        QVariantMap point;
+        point["label"] = label;
+        point["date"] = start;
+        point["amount"] = amount;
+        point["formattedAmount"] = formatCurrency(amount);
+        point["count"] = count;
+        m_points.append(point);
+
+        m_values.append(amount);
+        m_labels.append(label);
+        m_total += amount;
+        m_maxValue = qMax(m_maxValue, amount);
+    }
+
+    emit seriesChanged();
+}
@@ -0,0 +1,114 @@
+#ifndef REVENUECONTROLLER_H
+#define REVENUECONTROLLER_H
+
+#include <QDate>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QVariantList>
+#include <vector>
+#include "apimanager.h"
+
+// Aggregates completed transactions into daily revenue buckets for the
+// "Revenue Overview" panel. Pages of /api/transactions are streamed through
+// the buckets as they arrive (rows are not kept), and the buckets are kept
+// across range changes: switching to a shorter or already covered range does
+// not refetch, and refresh() only pulls transactions newer than the ones
+// already counted.
+class RevenueController : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool isLoading READ isLoading NOTIFY isLoadingChanged)
+    Q_PROPERTY(QString errorMessage READ errorMessage NOTIFY errorMessageChanged)
+    Q_PROPERTY(int rangeDays READ rangeDays WRITE setRangeDays NOTIFY rangeDaysChanged)
+    Q_PROPERTY(QString bucketSize READ bucketSize NOTIFY seriesChanged)
+    Q_PROPERTY(QVariantList points READ points NOTIFY seriesChanged)
+    Q_PROPERTY(QList<qreal> values READ values NOTIFY seriesChanged)
+    Q_PROPERTY(QStringList labels READ labels NOTIFY seriesChanged)
+    Q_PROPERTY(double total READ total NOTIFY seriesChanged)
+    Q_PROPERTY(double maxValue READ maxValue NOTIFY seriesChanged)
+    Q_PROPERTY(QString formattedTotal READ formattedTotal NOTIFY seriesChanged)
+    Q_PROPERTY(bool hasData READ hasData NOTIFY seriesChanged)
+
+public:
+    explicit RevenueController(QObject *parent = nullptr);
+    ~RevenueController();
+
+    bool isLoading() const { return m_isLoading; }
+    QString errorMessage() const { return m_errorMessage; }
+    int rangeDays() const { return m_rangeDays; }
+    QString bucketSize() const { return m_bucketDays == 7 ? "week" : "day"; }
+    QVariantList points() const { return m_points; }
+    QList<qreal> values() const { return m_values; }
+    QStringList labels() const { return m_labels; }
+    double total() const { return m_total; }
+    double maxValue() const { return m_maxValue; }
+    QString formattedTotal() const;
+    bool hasData() const { return m_total > 0.0; }
+
+    void setRangeDays(int days);
+
+    Q_INVOKABLE void load();
+    Q_INVOKABLE void refresh();
+    Q_INVOKABLE void clearError();
+    Q_INVOKABLE void reloadTokens();
+
+    static constexpr int MaxRangeDays = 90;
+
+signals:
+    void isLoadingChanged();
+    void errorMessageChanged();
+    void rangeDaysChanged();
+    void seriesChanged();
+
+private slots:
+    void onTransactionsLoaded(const QJsonObject &data);
+    void onTransactionsLoadFailed(const QString &errorMessage);
+
+private:
+    enum FetchMode {
+        Idle,
+        FetchOlder,     // walking back until the range is covered
+        FetchNewer      // walking forward from page 1 until known rows
+    };
+
+    void setLoading(bool loading);
+    void setError(const QString &error);
+    void fetchPage(int page);
+    void ensureCoverage();
+    void resetBuckets();
+    void addToBucket(const QDate &date, double amount);
+    void rebuildSeries();
+    // orderId, else orderNumber + createdAt; empty when the row has neither
+    static QString transactionKey(const QJsonObject &transaction);
+    QString formatCurrency(double amount) const;
+
+    ApiManager *m_api;
+    bool m_isLoading;
+    QString m_errorMessage;
+    int m_rangeDays;
+    int m_bucketDays;
+
+    // Column storage, one slot per day: index 0 is m_lastDay, index i is
+    // i days earlier. Kept as flat arrays so range sums vectorize.
+    QDate m_lastDay;
+    std::vector<double> m_dayAmounts;
+    std::vector<int> m_dayCounts;
+
+    QSet<QString> m_seenOrderIds;  // transactionKey() of counted rows
+    QDate m_coveredFrom;        // oldest day fully covered by fetched pages
+    bool m_reachedEnd;          // no older pages on the server
+    int m_nextOlderPage;
+
+    FetchMode m_mode;
+    int m_pageSize;
+
+    QVariantList m_points;
+    QList<qreal> m_values;
+    QStringList m_labels;
+    double m_total;
+    double m_maxValue;
+};
+
+#endif // REVENUECONTROLLER_H
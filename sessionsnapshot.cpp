@@ -0,0 +1,227 @@
+#include "sessionsnapshot.h"
+#include "authcontroller.h"
+#include "coursecontroller.h"
+#include "dashboardcontroller.h"
+#include "instructorcontroller.h"
+#include "logging.h"
+#include "notificationcontroller.h"
+#include "transactioncontroller.h"
+#include "usercontroller.h"
+#include <QCborMap>
+#include <QCborValue>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+
+SessionSnapshot::SessionSnapshot(AuthController *auth,
+                                 DashboardController *dashboard,
+                                 CourseController *courses,
+                                 InstructorController *instructors,
+                                 UserController *users,
+                                 TransactionController *transactions,
+                                 NotificationController *notifications,
+                                 QObject *parent)
+    : QObject(parent)
+    , m_auth(auth)
+    , m_dashboard(dashboard)
+    , m_courses(courses)
+    , m_instructors(instructors)
+    , m_users(users)
+    , m_transactions(transactions)
+    , m_notifications(notifications)
+    , m_api(new ApiManager(this))
+    , m_restored(false)
+    , m_revalidating(false)
+{
+    connect(m_api, &ApiManager::tokenRefreshed,
+            this, &SessionSnapshot::onTokenRefreshed);
+    connect(m_api, &ApiManager::tokenRefreshFailed,
+            this, &SessionSnapshot::onTokenRefreshFailed);
+
+    // A snapshot must never outlive the session it belongs to
+    connect(m_auth, &AuthController::loggedOut, this, &SessionSnapshot::clear);
+}
+
+SessionSnapshot::~SessionSnapshot()
+{
+}
+
+QString SessionSnapshot::filePath() const
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation);
+    return dir + "/session.snapshot";
+}
+
+void SessionSnapshot::setRevalidating(bool revalidating)
+{
+    if (m_revalidating != revalidating) {
+        m_revalidating = revalidating;
+        emit revalidatingChanged();
+    }
+}
+
+bool SessionSnapshot::hasValidSession()
+{
+    QSettings settings;
+    settings.beginGroup("auth");
+    QString refreshToken = settings.value("refreshToken").toString();
+    settings.endGroup();
+
+    if (refreshToken.isEmpty()) {
+        return false;
+    }
+
+    // Refresh tokens are JWTs; check the exp claim locally so an expired
+    // session goes straight to the login page. Opaque tokens are accepted
+    // and left to the server to validate.
+    QStringList parts = refreshToken.split('.');
+    if (parts.size() != 3) {
+        return true;
+    }
+
+    QByteArray payload = QByteArray::fromBase64(parts[1].toLatin1(),
+                                                QByteArray::Base64UrlEncoding);
+    QJsonObject claims = QJsonDocument::fromJson(payload).object();
+    if (!claims.contains("exp")) {
+        return true;
+    }
+
+    qint64 expiresAt = static_cast<qint64>(claims["exp"].toDouble());
+    return expiresAt > QDateTime::currentSecsSinceEpoch();
+}
+
+void SessionSnapshot::save() const
+{
+    if (!m_auth->isLoggedIn()) {
+        return;
+    }
+
+    QCborMap map;
+    map.insert(QStringLiteral("savedAt"), QDateTime::currentSecsSinceEpoch());
+
+    auto put = [&map](const QString &key, const QJsonObject &data) {
+        if (!data.isEmpty()) {
+            map.insert(key, QCborMap::fromJsonObject(data));
+        }
+    };
+
+    put(QStringLiteral("user"), m_auth->snapshot());
+    put(QStringLiteral("dashboard"), m_dashboard->snapshot());
+    put(QStringLiteral("courses"), m_courses->snapshot());
+    put(QStringLiteral("instructors"), m_instructors->snapshot());
+    put(QStringLiteral("students"), m_users->snapshot());
+    put(QStringLiteral("transactions"), m_transactions->snapshot());
+    put(QStringLiteral("notifications"), m_notifications->snapshot());
+
+    QString path = filePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(lcControllers) << "SessionSnapshot: cannot write" << path;
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << Magic << Version << qCompress(map.toCborValue().toCbor());
+
+    if (!file.commit()) {
+        qCWarning(lcControllers) << "SessionSnapshot: failed to save" << path;
+    }
+}
+
+bool SessionSnapshot::restore()
+{
+    if (!hasValidSession()) {
+        clear();
+        return false;
+    }
+
+    QFile file(filePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    QByteArray compressed;
+    in >> magic >> version >> compressed;
+
+    if (in.status() != QDataStream::Ok || magic != Magic || version != Version) {
+        qCWarning(lcControllers) << "SessionSnapshot: ignoring unreadable snapshot";
+        return false;
+    }
+
+    QCborMap map = QCborValue::fromCbor(qUncompress(compressed)).toMap();
+    qint64 savedAt = map.value(QStringLiteral("savedAt")).toInteger();
+    if (QDateTime::fromSecsSinceEpoch(savedAt).daysTo(QDateTime::currentDateTime()) > MaxAgeDays) {
+        return false;
+    }
+
+    auto get = [&map](const QString &key) {
+        return map.value(key).toMap().toJsonObject();
+    };
+
+    QJsonObject user = get(QStringLiteral("user"));
+    if (!user.isEmpty())          m_auth->restoreSnapshot(user);
+
+    QJsonObject dashboard = get(QStringLiteral("dashboard"));
+    if (!dashboard.isEmpty())     m_dashboard->restoreSnapshot(dashboard);
+
+    QJsonObject courses = get(QStringLiteral("courses"));
+    if (!courses.isEmpty())       m_courses->restoreSnapshot(courses);
+
+    QJsonObject instructors = get(QStringLiteral("instructors"));
+    if (!instructors.isEmpty())   m_instructors->restoreSnapshot(instructors);
+
+    QJsonObject students = get(QStringLiteral("students"));
+    if (!students.isEmpty())      m_users->restoreSnapshot(students);
+
+    QJsonObject transactions = get(QStringLiteral("transactions"));
+    if (!transactions.isEmpty())  m_transactions->restoreSnapshot(transactions);
+
+    QJsonObject notifications = get(QStringLiteral("notifications"));
+    if (!notifications.isEmpty()) m_notifications->restoreSnapshot(notifications);
+
+    m_restored = true;
+
+    // The stored access token has most likely expired; refresh it before the
+    // dashboard revalidates its data.
+    setRevalidating(true);
+    m_api->refreshAccessToken();
+
+    return true;
+}
+
+void SessionSnapshot::clear()
+{
+    QFile::remove(filePath());
+}
+
+void SessionSnapshot::onTokenRefreshed(const QString &newAccessToken)
+{
+    Q_UNUSED(newAccessToken)
+
+    // Propagates to every controller through accessTokenChanged
+    m_auth->reloadTokens();
+    setRevalidating(false);
+    emit revalidated();
+}
+
+void SessionSnapshot::onTokenRefreshFailed()
+{
+    // Offline or refresh rejected: keep showing the snapshot and let the
+    // regular loads report the error.
+    qCInfo(lcControllers) << "SessionSnapshot: token refresh failed, revalidating with stored token";
+    setRevalidating(false);
+    emit revalidated();
+}
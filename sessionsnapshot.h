@@ -0,0 +1,80 @@
+#ifndef SESSIONSNAPSHOT_H
+#define SESSIONSNAPSHOT_H
+
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include "apimanager.h"
+
+class AuthController;
+class DashboardController;
+class CourseController;
+class InstructorController;
+class UserController;
+class TransactionController;
+class NotificationController;
+
+// Persists the last dashboard state (stats, course stats, recent
+// notifications, first list pages, profile) as a compressed binary file on
+// exit. On the next start, if the refresh token is still valid, the data is
+// fed back into the controllers so the dashboard renders immediately while
+// a token refresh and the normal loads revalidate it in the background.
+class SessionSnapshot : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool restored READ restored CONSTANT)
+    Q_PROPERTY(bool revalidating READ revalidating NOTIFY revalidatingChanged)
+
+public:
+    SessionSnapshot(AuthController *auth,
+                    DashboardController *dashboard,
+                    CourseController *courses,
+                    InstructorController *instructors,
+                    UserController *users,
+                    TransactionController *transactions,
+                    NotificationController *notifications,
+                    QObject *parent = nullptr);
+    ~SessionSnapshot();
+
+    bool restored() const { return m_restored; }
+    bool revalidating() const { return m_revalidating; }
+
+    // Applies the stored snapshot if there is a still-valid session.
+    // Returns true when the UI can start on the dashboard.
+    bool restore();
+    void save() const;
+    Q_INVOKABLE void clear();
+
+    static bool hasValidSession();
+
+signals:
+    void revalidatingChanged();
+    void revalidated();
+
+private slots:
+    void onTokenRefreshed(const QString &newAccessToken);
+    void onTokenRefreshFailed();
+
+private:
+    QString filePath() const;
+    void setRevalidating(bool revalidating);
+
+    static constexpr quint32 Magic = 0x4c534e50; // "LSNP"
+    static constexpr quint16 Version = 1;
+    static constexpr int MaxAgeDays = 7;
+
+    AuthController *m_auth;
+    DashboardController *m_dashboard;
+    CourseController *m_courses;
+    InstructorController *m_instructors;
+    UserController *m_users;
+    TransactionController *m_transactions;
+    NotificationController *m_notifications;
+
+    ApiManager *m_api;
+    bool m_restored;
+    bool m_revalidating;
+};
+
+#endif // SESSIONSNAPSHOT_H
@@ -0,0 +1,280 @@
+#include "startuptrace.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQuickWindow>
+#include <QTimer>
+#include <algorithm>
+#include <memory>
+
+StartupTrace::StartupTrace(QObject *parent)
+    : QObject(parent)
+    , m_droppedEvents(0)
+    , m_window(nullptr)
+    , m_finalMilestone("dashboardMeaningfulPaint")
+    , m_budgetMs(0)
+    , m_exitWhenDone(false)
+    , m_finished(false)
+{
+    m_clock.start();
+
+    m_tracePath = qEnvironmentVariable("LUMIN_STARTUP_TRACE");
+    m_budgetMs = qEnvironmentVariableIntValue("LUMIN_STARTUP_BUDGET_MS");
+    m_exitWhenDone = qEnvironmentVariableIntValue("LUMIN_STARTUP_EXIT") != 0;
+
+    QString finalMilestone = qEnvironmentVariable("LUMIN_STARTUP_FINAL");
+    if (!finalMilestone.isEmpty()) {
+        m_finalMilestone = finalMilestone;
+    }
+}
+
+StartupTrace *StartupTrace::instance()
+{
+    static StartupTrace trace;
+    return &trace;
+}
+
+void StartupTrace::mark(const QString &name)
+{
+    instance()->record(name);
+}
+
+void StartupTrace::markOnce(const QString &name)
+{
+    record(name);
+}
+
+qint64 StartupTrace::elapsedUs() const
+{
+    return m_clock.nsecsElapsed() / 1000;
+}
+
+void StartupTrace::record(const QString &name)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_marks.contains(name)) {
+            return;
+        }
+
+        qint64 now = elapsedUs();
+        m_marks.insert(name, now);
+        m_events.append({name, QStringLiteral("startup"), now, -1, QVariantMap()});
+    }
+
+    if (name == m_finalMilestone) {
+        // May be called from the render thread; report from the GUI thread
+        QMetaObject::invokeMethod(this, &StartupTrace::finish, Qt::QueuedConnection);
+    }
+}
+
+void StartupTrace::markNextFrame(const QString &name)
+{
+    if (!m_window) {
+        record(name);
+        return;
+    }
+
+    // frameSwapped is emitted on the render thread; take the timestamp there
+    auto connection = std::make_shared<QMetaObject::Connection>();
+    *connection = connect(m_window, &QQuickWindow::frameSwapped, this,
+                          [this, name, connection]() {
+                              record(name);
+                              QObject::disconnect(*connection);
+                          }, Qt::DirectConnection);
+    m_window->update();
+}
+
+QVariantMap StartupTrace::milestones() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QVariantMap result;
+    for (auto it = m_marks.constBegin(); it != m_marks.constEnd(); ++it) {
+        result.insert(it.key(), it.value() / 1000.0);
+    }
+    return result;
+}
+
+void StartupTrace::addCompleteEvent(const QString &name, const QString &category,
+                                    qint64 startUs, qint64 durationUs,
+                                    const QVariantMap &args)
+{
+    if (m_tracePath.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (m_events.size() >= MaxEvents) {
+        if (m_droppedEvents++ == 0) {
+            qWarning() << "Startup trace: event buffer full, dropping further" << category << "events";
+        }
+        return;
+    }
+    m_events.append({name, category, startUs, durationUs, args});
+}
+
+void StartupTrace::attachWindow(QQuickWindow *window)
+{
+    m_window = window;
+    markNextFrame(QStringLiteral("firstFrame"));
+}
+
+void StartupTrace::start()
+{
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &StartupTrace::finish);
+
+    if (!m_exitWhenDone) {
+        return;
+    }
+
+    int timeoutMs = qEnvironmentVariableIntValue("LUMIN_STARTUP_TIMEOUT_MS");
+    if (timeoutMs <= 0) {
+        timeoutMs = 60000;
+    }
+
+    QTimer::singleShot(timeoutMs, this, [this]() {
+        if (m_finished) {
+            return;
+        }
+        qWarning() << "Startup trace: timed out waiting for" << m_finalMilestone;
+        printSummary();
+        if (!m_tracePath.isEmpty()) {
+            writeTrace(m_tracePath);
+        }
+        m_finished = true;
+        QCoreApplication::exit(2);
+    });
+}
+
+void StartupTrace::finish()
+{
+    if (!m_tracePath.isEmpty()) {
+        writeTrace(m_tracePath);
+    }
+
+    if (m_finished) {
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    bool reachedFinal = m_marks.contains(m_finalMilestone);
+    qint64 finalMs = m_marks.value(m_finalMilestone) / 1000;
+    locker.unlock();
+
+    if (!reachedFinal && !m_exitWhenDone) {
+        // Quitting before the dashboard was painted (e.g. at the login page)
+        printSummary();
+        m_finished = true;
+        return;
+    }
+
+    if (!reachedFinal) {
+        return;
+    }
+
+    printSummary();
+    m_finished = true;
+
+    if (m_exitWhenDone) {
+        bool overBudget = m_budgetMs > 0 && finalMs > m_budgetMs;
+        QCoreApplication::exit(overBudget ? 1 : 0);
+    }
+}
+
+void StartupTrace::printSummary() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    QList<QPair<qint64, QString>> ordered;
+    for (auto it = m_marks.constBegin(); it != m_marks.constEnd(); ++it) {
+        ordered.append(qMakePair(it.value(), it.key()));
+    }
+    std::sort(ordered.begin(), ordered.end());
+
+    qint64 previous = 0;
+    for (const auto &mark : ordered) {
+        qInfo().noquote() << QString("startup: %1 %2 ms (+%3 ms)")
+                                 .arg(mark.second, -28)
+                                 .arg(mark.first / 1000.0, 0, 'f', 1)
+                                 .arg((mark.first - previous) / 1000.0, 0, 'f', 1);
+        previous = mark.first;
+    }
+
+    if (m_budgetMs > 0) {
+        if (m_marks.contains(m_finalMilestone)) {
+            qint64 finalMs = m_marks.value(m_finalMilestone) / 1000;
+            qInfo().noquote() << QString("startup: budget %1 ms, %2 at %3 ms: %4")
+                                     .arg(m_budgetMs)
+                                     .arg(m_finalMilestone)
+                                     .arg(finalMs)
+                                     .arg(finalMs > m_budgetMs ? "EXCEEDED" : "OK");
+        } else {
+            qInfo().noquote() << "startup: budget" << m_budgetMs << "ms," << m_finalMilestone
+                              << "not reached";
+        }
+    }
+}
+
+void StartupTrace::writeTrace(const QString &path) const
+{
+    QMutexLocker locker(&m_mutex);
+
+    qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+
+    // Instant events for the milestones, plus one span per startup phase
+    QList<Event> milestones;
+    for (const Event &event : m_events) {
+        QJsonObject json;
+        json["name"] = event.name;
+        json["cat"] = event.category;
+        json["ts"] = event.startUs;
+        json["pid"] = pid;
+        json["tid"] = 0;
+        if (event.durationUs < 0) {
+            json["ph"] = "i";
+            json["s"] = "g";
+            milestones.append(event);
+        } else {
+            json["ph"] = "X";
+            json["dur"] = event.durationUs;
+        }
+        if (!event.args.isEmpty()) {
+            json["args"] = QJsonObject::fromVariantMap(event.args);
+        }
+        traceEvents.append(json);
+    }
+
+    std::sort(milestones.begin(), milestones.end(), [](const Event &a, const Event &b) {
+        return a.startUs < b.startUs;
+    });
+
+    qint64 previous = 0;
+    for (const Event &milestone : milestones) {
+        QJsonObject phase;
+        phase["name"] = milestone.name;
+        phase["cat"] = "startup.phase";
+        phase["ph"] = "X";
+        phase["ts"] = previous;
+        phase["dur"] = milestone.startUs - previous;
+        phase["pid"] = pid;
+        phase["tid"] = 1;
+        traceEvents.append(phase);
+        previous = milestone.startUs;
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Startup trace: cannot write" << path;
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+}
@@ -0,0 +1,83 @@
+#ifndef STARTUPTRACE_H
+#define STARTUPTRACE_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QVariantMap>
+
+class QQuickWindow;
+
+// Records monotonic startup milestones (application constructed, controllers
+// created, QML loaded, first frame, first network response, first meaningful
+// paint of the dashboard) and writes them as a Chrome trace plus a summary.
+//
+// Configured through the environment so CI can run it headless:
+//   LUMIN_STARTUP_TRACE=<file.json>   write a Chrome trace (chrome://tracing)
+//   LUMIN_STARTUP_BUDGET_MS=<ms>      budget for the final milestone
+//   LUMIN_STARTUP_EXIT=1              quit once the final milestone is reached;
+//                                     exit code 1 when over budget, 2 on timeout
+//   LUMIN_STARTUP_FINAL=<name>        final milestone (default dashboardMeaningfulPaint)
+//   LUMIN_STARTUP_TIMEOUT_MS=<ms>     give up waiting for it (default 60000)
+class StartupTrace : public QObject
+{
+    Q_OBJECT
+
+public:
+    static StartupTrace *instance();
+
+    // Records a milestone the first time it is reached; later calls with the
+    // same name are ignored. Safe to call from any thread.
+    static void mark(const QString &name);
+
+    Q_INVOKABLE void markOnce(const QString &name);
+    Q_INVOKABLE void markNextFrame(const QString &name);
+    Q_INVOKABLE QVariantMap milestones() const;
+
+    // Duration events kept, about five minutes of frames at 60 Hz; later
+    // ones are dropped with a warning, so a long session with the trace
+    // enabled does not grow without bound
+    static const int MaxEvents = 20000;
+
+    // Adds a duration event to the trace (timestamps in µs since process start)
+    void addCompleteEvent(const QString &name, const QString &category,
+                          qint64 startUs, qint64 durationUs,
+                          const QVariantMap &args = QVariantMap());
+    qint64 elapsedUs() const;
+
+    void attachWindow(QQuickWindow *window);
+    void start();
+    void finish();
+
+private:
+    explicit StartupTrace(QObject *parent = nullptr);
+
+    struct Event {
+        QString name;
+        QString category;
+        qint64 startUs;
+        qint64 durationUs;   // < 0 for instant events
+        QVariantMap args;
+    };
+
+    void record(const QString &name);
+    void writeTrace(const QString &path) const;
+    void printSummary() const;
+
+    QElapsedTimer m_clock;
+    mutable QMutex m_mutex;
+    QHash<QString, qint64> m_marks;
+    QList<Event> m_events;
+    int m_droppedEvents;
+    QQuickWindow *m_window;
+    QString m_tracePath;
+    QString m_finalMilestone;
+    qint64 m_budgetMs;
+    bool m_exitWhenDone;
+    bool m_finished;
+};
+
+#endif // STARTUPTRACE_H
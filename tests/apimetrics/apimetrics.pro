@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = lumin-test-apimetrics
+
+SOURCES += \
+    apimetricstest.cpp
@@ -0,0 +1,79 @@
+#include "apimanager.h"
+#include "apimetrics.h"
+#include "harlog.h"
+#include "mockserver.h"
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSettings>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest>
+
+// Wire and decoded sizes against a mock server that deflates its
+// responses, which Qt then decodes transparently.
+class ApiMetricsTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void compressedResponseSizes();
+
+private:
+    QTemporaryDir m_dir;
+    MockServer *m_server = nullptr;
+};
+
+void ApiMetricsTest::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+
+    // Keep away from the real application's tokens
+    QCoreApplication::setOrganizationName("PicsartAcademy-Tests");
+    QCoreApplication::setApplicationName("lumin-tests");
+    QSettings::setDefaultFormat(QSettings::IniFormat);
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, m_dir.filePath("settings"));
+
+    MockServer::Options options;
+    options.requireAuth = false;
+    options.compress = true;
+    m_server = new MockServer(Dataset::Sizes(), 1, options, this);
+    QVERIFY(m_server->listen(QHostAddress::LocalHost, 0));
+}
+
+void ApiMetricsTest::compressedResponseSizes()
+{
+    ApiMetrics::instance()->reset();
+    HarLog::instance()->clear();
+
+    ApiManager api;
+    api.setBaseUrl(QString("http://127.0.0.1:%1").arg(m_server->serverPort()));
+    QSignalSpy loadedSpy(&api, &ApiManager::transactionsLoaded);
+
+    api.getTransactions(1, 100);
+    QTRY_COMPARE_WITH_TIMEOUT(loadedSpy.count(), 1, 5000);
+
+    QJsonObject stats = ApiMetrics::instance()->snapshot()["/api/transactions"].toObject();
+    QCOMPARE(stats["responses"].toInt(), 1);
+    QCOMPARE(stats["compressedResponses"].toInt(), 1);
+    QVERIFY(stats["wireBytes"].toInteger() > 0);
+    QVERIFY2(stats["wireBytes"].toInteger() < stats["bodyBytes"].toInteger(),
+             qPrintable(QString("wire %1, body %2").arg(stats["wireBytes"].toInteger())
+                            .arg(stats["bodyBytes"].toInteger())));
+    QVERIFY(stats["compressionRatio"].toDouble() > 1.0);
+
+    QJsonArray entries = HarLog::instance()->toHar(5)["log"].toObject()["entries"].toArray();
+    QCOMPARE(entries.size(), 1);
+    QJsonObject response = entries.at(0).toObject()["response"].toObject();
+    qint64 bodySize = response["bodySize"].toInteger();
+    qint64 contentSize = response["content"].toObject()["size"].toInteger();
+    QVERIFY(bodySize > 0);
+    QVERIFY(bodySize < contentSize);
+    QCOMPARE(response["content"].toObject()["compression"].toInteger(), contentSize - bodySize);
+}
+
+QTEST_GUILESS_MAIN(ApiMetricsTest)
+
+#include "apimetricstest.moc"
@@ -0,0 +1,223 @@
+#include "apimanager.h"
+#include "apinetworkmanager.h"
+#include "apitraffic.h"
+#include "mockserver.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkReply>
+#include <QSettings>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest>
+
+namespace {
+
+const char *const Password = "correct horse battery staple";
+const char *const NewPassword = "Tr0ub4dor&3";
+const int LatencyMs = 100;
+
+struct Fetched {
+    int status = -1;             // -1: no reply within the timeout
+    int error = 0;               // QNetworkReply::NetworkError
+    QByteArray body;
+};
+
+} // namespace
+
+// Records sessions against the mock server and reads the file back, to
+// check what a recording shared for profiling would give away, and that
+// replaying it answers like the server did.
+class ApiTrafficTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void loginIsRedacted();
+    void changePasswordIsRedacted();
+    void replayMatchesRecording();
+
+private:
+    // One request through the shared ApiNetworkManager, waited for
+    Fetched fetch(const QByteArray &method, const QString &pathAndQuery,
+                  const QByteArray &body = QByteArray());
+    // The recorded request body of the last exchange for this path
+    QJsonObject recordedRequest(const QString &path);
+    ApiManager *createApi();
+
+    QTemporaryDir m_dir;
+    MockServer *m_server = nullptr;
+    QString m_baseUrl;
+};
+
+void ApiTrafficTest::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+
+    // Tokens go to QSettings; keep them away from the real app's
+    QCoreApplication::setOrganizationName("PicsartAcademy-Tests");
+    QCoreApplication::setApplicationName("lumin-tests");
+    QSettings::setDefaultFormat(QSettings::IniFormat);
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, m_dir.filePath("settings"));
+
+    MockServer::Options options;
+    options.latencyMs = LatencyMs;
+    options.requireAuth = false;
+    m_server = new MockServer(Dataset::Sizes(), 1, options, this);
+    QVERIFY(m_server->listen(QHostAddress::LocalHost, 0));
+    m_baseUrl = QString("http://127.0.0.1:%1").arg(m_server->serverPort());
+
+    ApiTraffic::instance()->startRecording(m_dir.filePath("session.lrec"));
+    QVERIFY(ApiTraffic::instance()->isRecording());
+}
+
+void ApiTrafficTest::cleanupTestCase()
+{
+    ApiTraffic::instance()->stopRecording();
+    ApiTraffic::instance()->stopReplay();
+}
+
+ApiManager *ApiTrafficTest::createApi()
+{
+    ApiManager *api = new ApiManager(this);
+    api->setBaseUrl(m_baseUrl);
+    return api;
+}
+
+Fetched ApiTrafficTest::fetch(const QByteArray &method, const QString &pathAndQuery,
+                              const QByteArray &body)
+{
+    QNetworkRequest request(QUrl(m_baseUrl + pathAndQuery));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+
+    ApiNetworkManager *manager = ApiNetworkManager::shared();
+    QNetworkReply *reply = method == "PUT" ? manager->put(request, body) : manager->get(request);
+
+    // Network and replayed replies both finish asynchronously
+    QSignalSpy finishedSpy(reply, &QNetworkReply::finished);
+    Fetched fetched;
+    if (finishedSpy.wait(5000)) {
+        fetched.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        fetched.error = int(reply->error());
+        fetched.body = reply->readAll();
+    }
+    reply->deleteLater();
+    return fetched;
+}
+
+QJsonObject ApiTrafficTest::recordedRequest(const QString &path)
+{
+    QList<ApiTraffic::Exchange> exchanges;
+    if (!ApiTraffic::readRecording(m_dir.filePath("session.lrec"), &exchanges)) {
+        return QJsonObject();
+    }
+
+    for (int i = exchanges.size() - 1; i >= 0; --i) {
+        if (exchanges.at(i).pathAndQuery == path) {
+            return QJsonDocument::fromJson(exchanges.at(i).requestBody).object();
+        }
+    }
+    return QJsonObject();
+}
+
+void ApiTrafficTest::loginIsRedacted()
+{
+    ApiManager *api = createApi();
+    QSignalSpy successSpy(api, &ApiManager::loginSuccess);
+
+    api->login("admin@example.com", Password);
+    QTRY_COMPARE_WITH_TIMEOUT(successSpy.count(), 1, 5000);
+
+    QJsonObject request = recordedRequest("/api/auth/login");
+    QCOMPARE(request["email"].toString(), QString("admin@example.com"));
+    QVERIFY(request.contains("password"));
+    QVERIFY(request["password"].toString() != QLatin1String(Password));
+    QVERIFY(!QJsonDocument(request).toJson().contains(Password));
+}
+
+void ApiTrafficTest::changePasswordIsRedacted()
+{
+    ApiManager *api = createApi();
+    QSignalSpy changedSpy(api, &ApiManager::passwordChanged);
+
+    api->changePassword(Password, NewPassword);
+    QTRY_COMPARE_WITH_TIMEOUT(changedSpy.count(), 1, 5000);
+
+    QJsonObject request = recordedRequest("/api/user/change-password");
+    QVERIFY(!request.isEmpty());
+    QByteArray body = QJsonDocument(request).toJson();
+    QVERIFY(!body.contains(Password));
+    QVERIFY(!body.contains(NewPassword));
+}
+
+void ApiTrafficTest::replayMatchesRecording()
+{
+    const QString path = m_dir.filePath("replay.lrec");
+    ApiTraffic *traffic = ApiTraffic::instance();
+
+    traffic->startRecording(path);
+    const Fetched page1 = fetch("GET", "/api/transactions?page=1&limit=10");
+    const Fetched page2 = fetch("GET", "/api/transactions?page=2&limit=10");
+    const Fetched profileBefore = fetch("GET", "/api/user/profile");
+    const Fetched update = fetch("PUT", "/api/user/profile", R"({"firstName":"Replayed"})");
+    const Fetched profileAfter = fetch("GET", "/api/user/profile");
+    traffic->stopRecording();
+
+    for (const Fetched &fetched : { page1, page2, profileBefore, update, profileAfter }) {
+        QCOMPARE(fetched.status, 200);
+        QVERIFY(!fetched.body.isEmpty());
+    }
+    QVERIFY(page1.body != page2.body);
+    QVERIFY(profileBefore.body != profileAfter.body);
+
+    // Nothing below may reach the network
+    delete m_server;
+    m_server = nullptr;
+
+    QVERIFY(traffic->startReplay(path, 0.0));
+    QElapsedTimer clock;
+    clock.start();
+
+    // Same statuses and bodies, in recorded order per request
+    Fetched replayed = fetch("GET", "/api/transactions?page=1&limit=10");
+    QCOMPARE(replayed.status, 200);
+    QCOMPARE(replayed.body, page1.body);
+    replayed = fetch("GET", "/api/transactions?page=2&limit=10");
+    QCOMPARE(replayed.status, 200);
+    QCOMPARE(replayed.body, page2.body);
+    replayed = fetch("GET", "/api/user/profile");
+    QCOMPARE(replayed.body, profileBefore.body);
+    replayed = fetch("PUT", "/api/user/profile", R"({"firstName":"Replayed"})");
+    QCOMPARE(replayed.status, 200);
+    QCOMPARE(replayed.body, update.body);
+    replayed = fetch("GET", "/api/user/profile");
+    QCOMPARE(replayed.body, profileAfter.body);
+
+    // Asked for more often than recorded: the last response again
+    replayed = fetch("GET", "/api/user/profile");
+    QCOMPARE(replayed.status, 200);
+    QCOMPARE(replayed.body, profileAfter.body);
+
+    // A query never recorded falls back to the first recording of the path
+    replayed = fetch("GET", "/api/transactions?page=3&limit=10");
+    QCOMPARE(replayed.status, 200);
+    QCOMPARE(replayed.body, page1.body);
+
+    // A path never recorded is a 404
+    replayed = fetch("GET", "/api/courses");
+    QCOMPARE(replayed.status, 404);
+    QCOMPARE(replayed.error, int(QNetworkReply::ContentNotFoundError));
+
+    // At latency scale 0 nothing waits for the recorded LatencyMs per reply
+    QVERIFY2(clock.elapsed() < 3 * LatencyMs, qPrintable(QString("%1 ms").arg(clock.elapsed())));
+
+    traffic->stopReplay();
+}
+
+QTEST_GUILESS_MAIN(ApiTrafficTest)
+
+#include "apitraffictest.moc"
@@ -0,0 +1,6 @@
+include(../tests.pri)
+
+TARGET = lumin-test-chunkeduploader
+
+SOURCES += \
+    chunkeduploadertest.cpp
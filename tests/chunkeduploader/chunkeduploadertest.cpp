@@ -0,0 +1,156 @@
+#include "chunkeduploader.h"
+#include "mockserver.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QSettings>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest>
+
+namespace {
+
+const qint64 ChunkSize = 64 * 1024;
+const int ChunkCount = 6;
+const int LatencyMs = 100;
+
+} // namespace
+
+// Resume and cancel against the mock server's /api/uploads. The added
+// latency keeps chunks in flight long enough to cancel under them.
+class ChunkedUploaderTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void cancelThenResume();
+    void restartRightAfterCancel();
+
+private:
+    QString createFile(const QString &name);
+    void configure(ChunkedUploader *uploader);
+
+    QTemporaryDir m_dir;
+    MockServer *m_server = nullptr;
+};
+
+void ChunkedUploaderTest::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+
+    // Resume state goes to QSettings; keep it away from the real app's
+    QCoreApplication::setOrganizationName("PicsartAcademy-Tests");
+    QCoreApplication::setApplicationName("lumin-tests");
+    QSettings::setDefaultFormat(QSettings::IniFormat);
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, m_dir.filePath("settings"));
+
+    MockServer::Options options;
+    options.latencyMs = LatencyMs;
+    options.requireAuth = false;
+    m_server = new MockServer(Dataset::Sizes(), 1, options, this);
+    QVERIFY(m_server->listen(QHostAddress::LocalHost, 0));
+}
+
+QString ChunkedUploaderTest::createFile(const QString &name)
+{
+    QString path = m_dir.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return QString();
+    }
+    for (int i = 0; i < ChunkCount; ++i) {
+        file.write(QByteArray(ChunkSize, char('a' + i)));
+    }
+    return path;
+}
+
+void ChunkedUploaderTest::configure(ChunkedUploader *uploader)
+{
+    uploader->setChunkSize(ChunkSize);
+    uploader->setMaxParallel(2);
+    uploader->api()->setBaseUrl(QString("http://127.0.0.1:%1").arg(m_server->serverPort()));
+}
+
+void ChunkedUploaderTest::cancelThenResume()
+{
+    QString path = createFile("resume.bin");
+    QVERIFY(!path.isEmpty());
+
+    ChunkedUploader uploader;
+    configure(&uploader);
+    QSignalSpy finishedSpy(&uploader, &ChunkedUploader::finished);
+    QSignalSpy createdSpy(uploader.api(), &ApiManager::uploadCreated);
+    QSignalSpy statusSpy(uploader.api(), &ApiManager::uploadStatusLoaded);
+
+    // Cancel as soon as the first chunk is acknowledged; the others are
+    // still in flight and must not be acknowledged afterwards
+    bool cancelled = false;
+    int acksAfterCancel = 0;
+    auto cancelOnAck = connect(uploader.api(), &ApiManager::uploadChunkAcknowledged, this, [&]() {
+        if (cancelled) {
+            ++acksAfterCancel;
+            return;
+        }
+        cancelled = true;
+        uploader.cancel();
+    });
+
+    uploader.start(path);
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(finishedSpy.at(0).at(0).toBool(), false);
+    QVERIFY(!uploader.isRunning());
+    QCOMPARE(createdSpy.count(), 1);
+    QString uploadId = createdSpy.at(0).at(0).toJsonObject()["uploadId"].toString();
+    QVERIFY(!uploadId.isEmpty());
+
+    QTest::qWait(3 * LatencyMs);
+    QCOMPARE(acksAfterCancel, 0);
+    disconnect(cancelOnAck);
+
+    // Same file again: asks the server what it has instead of creating a
+    // new upload, and only sends the rest
+    QSignalSpy ackSpy(uploader.api(), &ApiManager::uploadChunkAcknowledged);
+    uploader.start(path);
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), 2, 10000);
+    QCOMPARE(finishedSpy.at(1).at(0).toBool(), true);
+    QVERIFY(finishedSpy.at(1).at(1).toString().endsWith(uploadId));
+    QCOMPARE(createdSpy.count(), 1);
+    QCOMPARE(statusSpy.count(), 1);
+    QVERIFY(ackSpy.count() < ChunkCount);
+    QCOMPARE(uploader.progress(), 1.0);
+}
+
+void ChunkedUploaderTest::restartRightAfterCancel()
+{
+    QString path = createFile("restart.bin");
+    QVERIFY(!path.isEmpty());
+
+    ChunkedUploader uploader;
+    configure(&uploader);
+    QSignalSpy finishedSpy(&uploader, &ChunkedUploader::finished);
+
+    // Restarting with the same upload id while the cancelled run's chunks
+    // were in flight used to take their late acks as its own
+    bool restarted = false;
+    connect(uploader.api(), &ApiManager::uploadChunkAcknowledged, this, [&]() {
+        if (!restarted) {
+            restarted = true;
+            uploader.cancel();
+            uploader.start(path);
+        }
+    });
+
+    uploader.start(path);
+    QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), 2, 10000);
+    QCOMPARE(finishedSpy.at(0).at(0).toBool(), false);
+    QCOMPARE(finishedSpy.at(1).at(0).toBool(), true);
+    QCOMPARE(uploader.progress(), 1.0);
+
+    QTest::qWait(3 * LatencyMs);
+    QCOMPARE(finishedSpy.count(), 2);
+}
+
+QTEST_GUILESS_MAIN(ChunkedUploaderTest)
+
+#include "chunkeduploadertest.moc"
@@ -0,0 +1,17 @@
+# Shared by the functional checks: the client sources plus an in-process
+# lumin-mockserver to run them against.
+
+include(../lumin.pri)
+
+QT += testlib
+CONFIG += testcase
+
+INCLUDEPATH += $$PWD/../mockserver
+
+SOURCES += \
+    $$PWD/../mockserver/dataset.cpp \
+    $$PWD/../mockserver/mockserver.cpp
+
+HEADERS += \
+    $$PWD/../mockserver/dataset.h \
+    $$PWD/../mockserver/mockserver.h
@@ -0,0 +1,11 @@
+# Functional checks that run the client against an in-process
+# lumin-mockserver, one test binary each. Run with make check (here or
+# from lumin-all.pro) or on their own:
+#   chunkeduploader/lumin-test-chunkeduploader
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    apimetrics \
+    apitraffic \
+    chunkeduploader
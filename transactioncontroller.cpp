@@ -1,8 +1,10 @@
 #include "transactioncontroller.h"
+#include "exportjob.h"
+#include "logging.h"
+#include "payloadfields.h"
 #include <QJsonArray>
 #include <QLocale>
 #include <QDateTime>
-#include <QDebug>
 
 TransactionController::TransactionController(QObject *parent)
     : QObject(parent)
@@ -16,6 +18,7 @@ TransactionController::TransactionController(QObject *parent)
     , m_totalPages(1)
     , m_limit(20)
     , m_total(0)
+    , m_exportJob(nullptr)
 {
     connect(m_api, &ApiManager::transactionsLoaded,
             this, &TransactionController::onTransactionsLoaded);
@@ -131,8 +134,69 @@ void TransactionController::refresh()
     loadTransactions();
 }
 
+void TransactionController::reloadTokens()
+{
+    m_api->loadTokens();
+    qCDebug(lcControllers) << "TransactionController: tokens reloaded, logged in:" << m_api->isLoggedIn();
+}
+
+double TransactionController::exportProgress() const
+{
+    return m_exportJob ? m_exportJob->progress() : 0.0;
+}
+
+int TransactionController::exportedRows() const
+{
+    return m_exportJob ? m_exportJob->rowsWritten() : 0;
+}
+
+void TransactionController::exportTransactions(const QUrl &fileUrl)
+{
+    if (m_exportJob) {
+        return;
+    }
+
+    QString filePath = fileUrl.isLocalFile() ? fileUrl.toLocalFile() : fileUrl.toString();
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QString status = m_currentStatus == "all" ? "" : m_currentStatus;
+
+    m_exportJob = new ExportJob(ExportJob::Transactions, filePath, this);
+    m_exportJob->setFilters(status, m_searchQuery);
+
+    connect(m_exportJob, &ExportJob::progressChanged, this, &TransactionController::exportChanged);
+    connect(m_exportJob, &ExportJob::finished, this, [this](bool success, const QString &message) {
+        m_exportJob->deleteLater();
+        m_exportJob = nullptr;
+        emit exportChanged();
+        emit exportFinished(success, message);
+    });
+
+    emit exportChanged();
+    m_exportJob->start();
+}
+
+void TransactionController::cancelExport()
+{
+    if (m_exportJob) {
+        m_exportJob->cancel();
+    }
+}
+
+void TransactionController::restoreSnapshot(const QJsonObject &data)
+{
+    onTransactionsLoaded(data);
+}
+
 void TransactionController::onTransactionsLoaded(const QJsonObject &data)
 {
+    int page = data["pagination"].toObject()["page"].toInt(1);
+    if (page == 1 && m_currentStatus == "all" && m_searchQuery.isEmpty()) {
+        m_firstPage = data;
+    }
+
     if (data.contains("summary")) {
         updateSummary(data["summary"].toObject());
     }
@@ -186,21 +250,18 @@ void TransactionController::updateTransactionsList(const QJsonArray &transaction
         transactionMap["orderNumber"] = transaction["orderNumber"].toString();
         transactionMap["amount"] = transaction["amount"].toDouble();
         transactionMap["formattedAmount"] = formatCurrency(transaction["amount"].toDouble());
-        transactionMap["status"] = transaction["status"].toString();
-        transactionMap["paymentMethod"] = transaction["paymentMethod"].toString();
         transactionMap["createdAt"] = transaction["createdAt"].toString();
 
-        // Format payment method display
-        QString paymentMethod = transaction["paymentMethod"].toString();
-        if (paymentMethod == "credit_card") {
-            transactionMap["paymentMethodDisplay"] = "Credit Card";
-        } else if (paymentMethod == "debit_card") {
-            transactionMap["paymentMethodDisplay"] = "Debit Card";
-        } else if (paymentMethod == "paypal") {
-            transactionMap["paymentMethodDisplay"] = "PayPal";
-        } else {
-            transactionMap["paymentMethodDisplay"] = paymentMethod;
-        }
+        // Status and payment method take a handful of values; share them
+        const PayloadFields::Value status =
+            PayloadFields::decode(PayloadFields::TransactionStatus, transaction["status"]);
+        transactionMap["status"] = status.name;
+        transactionMap["statusText"] = status.display;
+
+        const PayloadFields::Value paymentMethod =
+            PayloadFields::decode(PayloadFields::PaymentMethod, transaction["paymentMethod"]);
+        transactionMap["paymentMethod"] = paymentMethod.name;
+        transactionMap["paymentMethodDisplay"] = paymentMethod.display;
 
         // Student info
         QJsonObject student = transaction["student"].toObject();
@@ -226,10 +287,6 @@ void TransactionController::updateTransactionsList(const QJsonArray &transaction
         transactionMap["formattedDate"] = formatDateTime(transaction["createdAt"].toString());
         transactionMap["relativeTime"] = formatRelativeTime(transaction["createdAt"].toString());
 
-        // Status display
-        QString status = transaction["status"].toString();
-        transactionMap["statusText"] = status.left(1).toUpper() + status.mid(1);
-
         m_transactions.append(transactionMap);
     }
 
@@ -2,9 +2,12 @@
 #define TRANSACTIONCONTROLLER_H
 
 #include <QObject>
+#include <QUrl>
 #include <QVariantList>
 #include "apimanager.h"
 
+class ExportJob;
+
 class TransactionController : public QObject
 {
     Q_OBJECT
@@ -19,6 +22,9 @@ class TransactionController : public QObject
     Q_PROPERTY(QVariantList transactions READ transactions NOTIFY transactionsChanged)
     Q_PROPERTY(QString currentStatus READ currentStatus NOTIFY currentStatusChanged)
     Q_PROPERTY(QString searchQuery READ searchQuery NOTIFY searchQueryChanged)
+    Q_PROPERTY(bool isExporting READ isExporting NOTIFY exportChanged)
+    Q_PROPERTY(double exportProgress READ exportProgress NOTIFY exportChanged)
+    Q_PROPERTY(int exportedRows READ exportedRows NOTIFY exportChanged)
     Q_PROPERTY(int currentPage READ currentPage NOTIFY currentPageChanged)
     Q_PROPERTY(int totalPages READ totalPages NOTIFY paginationChanged)
     Q_PROPERTY(int limit READ limit NOTIFY limitChanged)
@@ -37,6 +43,9 @@ public:
     QVariantList transactions() const { return m_transactions; }
     QString currentStatus() const { return m_currentStatus; }
     QString searchQuery() const { return m_searchQuery; }
+    bool isExporting() const { return m_exportJob != nullptr; }
+    double exportProgress() const;
+    int exportedRows() const;
     int currentPage() const { return m_currentPage; }
     int totalPages() const { return m_totalPages; }
     int limit() const { return m_limit; }
@@ -49,6 +58,15 @@ public:
     Q_INVOKABLE void goToPage(int page);
     Q_INVOKABLE void clearError();
     Q_INVOKABLE void refresh();
+    Q_INVOKABLE void reloadTokens();
+
+    // Streams every page matching the current filters to a .csv or .jsonl file
+    Q_INVOKABLE void exportTransactions(const QUrl &fileUrl);
+    Q_INVOKABLE void cancelExport();
+
+    // Last unfiltered first page, persisted by SessionSnapshot
+    QJsonObject snapshot() const { return m_firstPage; }
+    void restoreSnapshot(const QJsonObject &data);
 
 signals:
     void isLoadingChanged();
@@ -57,6 +75,8 @@ signals:
     void transactionsChanged();
     void currentStatusChanged();
     void searchQueryChanged();
+    void exportChanged();
+    void exportFinished(bool success, const QString &message);
     void currentPageChanged();
     void paginationChanged();
     void limitChanged();
@@ -91,6 +111,8 @@ private:
     int m_totalPages;
     int m_limit;
     int m_total;
+    QJsonObject m_firstPage;
+    ExportJob *m_exportJob;
 };
 
 #endif // TRANSACTIONCONTROLLER_H
@@ -1,7 +1,8 @@
 #include "usercontroller.h"
+#include "exportjob.h"
+#include "logging.h"
 #include <QJsonArray>
 #include <QDateTime>
-#include <QDebug>
 
 UserController::UserController(QObject *parent)
     : QObject(parent)
@@ -11,6 +12,7 @@ UserController::UserController(QObject *parent)
     , m_activeStudents(0)
     , m_inactiveStudents(0)
     , m_currentStatus("all")
+    , m_exportJob(nullptr)
 {
     connect(m_api, &ApiManager::studentsLoaded,
             this, &UserController::onStudentsLoaded);
@@ -85,8 +87,75 @@ void UserController::refresh()
     loadStudents();
 }
 
+void UserController::reloadTokens()
+{
+    m_api->loadTokens();
+    qCDebug(lcControllers) << "UserController: tokens reloaded, logged in:" << m_api->isLoggedIn();
+}
+
+double UserController::exportProgress() const
+{
+    return m_exportJob ? m_exportJob->progress() : 0.0;
+}
+
+int UserController::exportedRows() const
+{
+    return m_exportJob ? m_exportJob->rowsWritten() : 0;
+}
+
+void UserController::exportStudents(const QUrl &fileUrl)
+{
+    if (m_exportJob) {
+        return;
+    }
+
+    QString filePath = fileUrl.isLocalFile() ? fileUrl.toLocalFile() : fileUrl.toString();
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    QString isActiveParam;
+    if (m_currentStatus == "active") {
+        isActiveParam = "true";
+    } else if (m_currentStatus == "inactive") {
+        isActiveParam = "false";
+    }
+
+    m_exportJob = new ExportJob(ExportJob::Students, filePath, this);
+    m_exportJob->setFilters(isActiveParam, m_searchQuery);
+
+    connect(m_exportJob, &ExportJob::progressChanged, this, &UserController::exportChanged);
+    connect(m_exportJob, &ExportJob::finished, this, [this](bool success, const QString &message) {
+        m_exportJob->deleteLater();
+        m_exportJob = nullptr;
+        emit exportChanged();
+        emit exportFinished(success, message);
+    });
+
+    emit exportChanged();
+    m_exportJob->start();
+}
+
+void UserController::cancelExport()
+{
+    if (m_exportJob) {
+        m_exportJob->cancel();
+    }
+}
+
+void UserController::restoreSnapshot(const QJsonObject &data)
+{
+    onStudentsLoaded(data);
+}
+
 void UserController::onStudentsLoaded(const QJsonObject &data)
 {
+    // Unpaged responses carry no pagination and count as the first page
+    int page = data["pagination"].toObject()["page"].toInt(1);
+    if (page == 1 && m_currentStatus == "all" && m_searchQuery.isEmpty()) {
+        m_firstPage = data;
+    }
+
     if (data.contains("stats")) {
         updateStats(data["stats"].toObject());
     }
@@ -150,7 +219,8 @@ void UserController::updateStudentsList(const QJsonArray &studentsArray)
         studentMap["relativeDate"] = relativeDate;
 
         // Status display
-        studentMap["statusText"] = student["isActive"].toBool() ? "Active" : "Inactive";
+        studentMap["statusText"] = student["isActive"].toBool() ? QStringLiteral("Active")
+                                                                : QStringLiteral("Inactive");
 
         m_students.append(studentMap);
     }
@@ -2,9 +2,12 @@
 #define USERCONTROLLER_H
 
 #include <QObject>
+#include <QUrl>
 #include <QVariantList>
 #include "apimanager.h"
 
+class ExportJob;
+
 class UserController : public QObject
 {
     Q_OBJECT
@@ -17,6 +20,9 @@ class UserController : public QObject
     Q_PROPERTY(QVariantList students READ students NOTIFY studentsChanged)
     Q_PROPERTY(QString currentStatus READ currentStatus NOTIFY currentStatusChanged)
     Q_PROPERTY(QString searchQuery READ searchQuery NOTIFY searchQueryChanged)
+    Q_PROPERTY(bool isExporting READ isExporting NOTIFY exportChanged)
+    Q_PROPERTY(double exportProgress READ exportProgress NOTIFY exportChanged)
+    Q_PROPERTY(int exportedRows READ exportedRows NOTIFY exportChanged)
 
 public:
     explicit UserController(QObject *parent = nullptr);
@@ -30,12 +36,24 @@ public:
     QVariantList students() const { return m_students; }
     QString currentStatus() const { return m_currentStatus; }
     QString searchQuery() const { return m_searchQuery; }
+    bool isExporting() const { return m_exportJob != nullptr; }
+    double exportProgress() const;
+    int exportedRows() const;
 
     Q_INVOKABLE void loadStudents();
     Q_INVOKABLE void setStatusFilter(const QString &status);
     Q_INVOKABLE void setSearchQuery(const QString &query);
     Q_INVOKABLE void clearError();
     Q_INVOKABLE void refresh();
+    Q_INVOKABLE void reloadTokens();
+
+    // Streams every page matching the current filters to a .csv or .jsonl file
+    Q_INVOKABLE void exportStudents(const QUrl &fileUrl);
+    Q_INVOKABLE void cancelExport();
+
+    // Last unfiltered list response, persisted by SessionSnapshot
+    QJsonObject snapshot() const { return m_firstPage; }
+    void restoreSnapshot(const QJsonObject &data);
 
 signals:
     void isLoadingChanged();
@@ -44,6 +62,8 @@ signals:
     void studentsChanged();
     void currentStatusChanged();
     void searchQueryChanged();
+    void exportChanged();
+    void exportFinished(bool success, const QString &message);
     void studentsLoaded();
 
 private slots:
@@ -68,6 +88,8 @@ private:
     QVariantList m_students;
     QString m_currentStatus;
     QString m_searchQuery;
+    QJsonObject m_firstPage;
+    ExportJob *m_exportJob;
 };
 
 #endif // USERCONTROLLER_H